@@ -34,7 +34,11 @@ int main(int argc, char* argv[])
        "Maximum parallelism requested for the program")
     ("version", ("Print meld version ("s + meld::version() + ")").c_str())
     ("dot-file,g",
-       bpo::value<std::string>(), "Produce DOT file representing graph of framework nodes");
+       bpo::value<std::string>(), "Produce DOT file representing graph of framework nodes")
+    ("resume", "Resume the job from the checkpoint specified in the configuration")
+    ("trace",
+       bpo::value<std::string>(),
+       "Write a trace of the node invocations (Chrome trace-event format, viewable in Perfetto)");
   // clang-format on
 
   // Parse the command line.
@@ -79,6 +83,16 @@ int main(int argc, char* argv[])
     dot_file = make_optional(std::move(filename));
   }
 
+  std::optional<std::string> trace_file{};
+  if (vm.count("trace")) {
+    auto filename = vm["trace"].as<std::string>();
+    if (std::empty(filename)) {
+      std::cerr << "Error: The 'trace' option cannot use an empty filename.\n";
+      return 3;
+    }
+    trace_file = make_optional(std::move(filename));
+  }
+
   jsonnet::Jsonnet j;
   if (not j.init()) {
     std::cerr << "Error: Could not initialize Jsonnet parser.\n";
@@ -105,5 +119,9 @@ int main(int argc, char* argv[])
   if (not vm["parallel"].defaulted()) {
     max_concurrency = vm["parallel"].as<int>();
   }
-  meld::run(configurations, std::move(dot_file), max_concurrency);
+  meld::run(configurations,
+            std::move(dot_file),
+            max_concurrency,
+            vm.count("resume") > 0,
+            std::move(trace_file));
 }
@@ -3,14 +3,87 @@
 #include "meld/concurrency.hpp"
 #include "meld/core/framework_graph.hpp"
 
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
 using namespace std::string_literals;
 
 namespace meld {
   void run(boost::json::object const& configurations,
            std::optional<std::string> dot_file,
-           int const max_parallelism)
+           int const max_parallelism,
+           bool const resume,
+           std::optional<std::string> trace_file)
   {
     framework_graph g{load_source(configurations.at("source").as_object()), max_parallelism};
+    if (auto const* mode = configurations.if_contains("execution_mode")) {
+      auto const mode_name = value_to<std::string>(*mode);
+      if (mode_name == "demand_driven") {
+        g.set_execution_mode(execution_mode::demand_driven);
+      }
+      else if (mode_name != "eager") {
+        throw std::runtime_error("Unsupported execution mode '" + mode_name +
+                                 "' (must be 'eager' or 'demand_driven').");
+      }
+    }
+    if (auto const* resources = configurations.if_contains("resources")) {
+      for (auto const& [name, capacity] : resources->as_object()) {
+        g.declare_resource(std::string(name), value_to<std::size_t>(capacity));
+      }
+    }
+    if (auto const* checkpoint = configurations.if_contains("checkpoint")) {
+      configuration const options{checkpoint->as_object()};
+      g.enable_checkpoints({.file = options.get<std::string>("file"),
+                            .interval = options.get<std::size_t>("interval", 1),
+                            .resume = resume});
+    }
+    else if (resume) {
+      throw std::runtime_error("Cannot resume a job whose configuration specifies no checkpoint.");
+    }
+    if (auto const* depth = configurations.if_contains("readahead")) {
+      g.set_readahead_depth(value_to<std::size_t>(*depth));
+    }
+    if (auto const* directory = configurations.if_contains("transform_cache")) {
+      g.set_transform_cache(value_to<std::string>(*directory));
+    }
+    if (auto const* report = configurations.if_contains("timing_report")) {
+      g.set_timing_report(value_to<std::string>(*report));
+    }
+    if (auto const* counters = configurations.if_contains("perf_counters")) {
+      if (value_to<bool>(*counters)) {
+        g.enable_perf_counters();
+      }
+    }
+    if (auto const* profiling = configurations.if_contains("allocation_profiling")) {
+      if (value_to<bool>(*profiling)) {
+        g.enable_allocation_profiling();
+      }
+    }
+    if (auto const* accounting = configurations.if_contains("memory_accounting")) {
+      if (value_to<bool>(*accounting)) {
+        g.enable_memory_accounting();
+      }
+    }
+    if (auto const* bottlenecks = configurations.if_contains("bottleneck_report")) {
+      if (value_to<bool>(*bottlenecks)) {
+        g.enable_bottleneck_report();
+      }
+    }
+    if (auto const* progress = configurations.if_contains("progress")) {
+      configuration const options{progress->as_object()};
+      std::chrono::duration<double> const interval{options.get<double>("interval", 10.)};
+      g.enable_progress_reports(
+        {.file = options.get<std::string>("file"),
+         .interval = std::chrono::duration_cast<std::chrono::milliseconds>(interval)});
+    }
+    if (auto const* backlog = configurations.if_contains("backlog_sampling")) {
+      std::chrono::duration<double> const interval{value_to<double>(*backlog)};
+      g.enable_backlog_sampling(std::chrono::duration_cast<std::chrono::milliseconds>(interval));
+    }
+    if (trace_file) {
+      g.enable_tracing(std::move(*trace_file));
+    }
     auto const module_configs = configurations.at("modules").as_object();
     for (auto const& [key, value] : module_configs) {
       load_module(g, key, value.as_object());
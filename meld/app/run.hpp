@@ -4,11 +4,14 @@
 #include "boost/json.hpp"
 
 #include <optional>
+#include <string>
 
 namespace meld {
   void run(boost::json::object const& configurations,
            std::optional<std::string> dot_file,
-           int max_parallelism);
+           int max_parallelism,
+           bool resume = false,
+           std::optional<std::string> trace_file = std::nullopt);
 }
 
 #endif // meld_app_run_hpp
@@ -0,0 +1,50 @@
+#include "meld/core/backlog_monitor.hpp"
+
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace meld {
+  backlog_monitor::backlog_monitor(milliseconds const interval, sample_t sample) :
+    sample_{std::move(sample)}
+  {
+    if (interval.count() <= 0) {
+      throw std::runtime_error("The backlog-sampling interval must be positive.");
+    }
+    sampler_.emplace(interval, [this] {
+      std::lock_guard lock{mutex_};
+      this->sample();
+    });
+  }
+
+  backlog_monitor::~backlog_monitor() { stop(); }
+
+  void backlog_monitor::stop()
+  {
+    if (not sampler_) {
+      return;
+    }
+    sampler_.reset();
+
+    std::lock_guard lock{mutex_};
+    sample();
+  }
+
+  std::map<std::string, backlog_mark> backlog_monitor::marks() const
+  {
+    std::lock_guard lock{mutex_};
+    return marks_;
+  }
+
+  void backlog_monitor::sample()
+  {
+    auto const depths = sample_();
+    auto const now = duration<double>(clock::now() - begin_).count();
+    for (auto const& [name, depth] : depths) {
+      auto& mark = marks_[name];
+      if (depth > mark.high_water) {
+        mark = {depth, now};
+      }
+    }
+  }
+}
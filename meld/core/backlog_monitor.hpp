@@ -0,0 +1,66 @@
+#ifndef meld_core_backlog_monitor_hpp
+#define meld_core_backlog_monitor_hpp
+
+// =======================================================================================
+// The backlog_monitor periodically samples the number of entries held in each buffer of
+// the graph that is owned by meld:
+//
+//   - the maps in which nodes hold the stores, results, and flush flags of the levels
+//     they have not finished processing (e.g. "double/stores"),
+//   - the maps in which filters hold messages awaiting predicate decisions, and
+//     decisions awaiting messages (e.g. "filter:double/data"), and
+//   - the buffers of buffered outputs (e.g. "output:writer").
+//
+// The high-water mark of each buffer, and the time at which it was reached, identify the
+// stage at which messages pile up.  (The buffers internal to TBB flow-graph nodes, such as
+// those of join nodes, cannot be inspected.)
+//
+// Backlog sampling is enabled with framework_graph::enable_backlog_sampling (or the
+// 'backlog_sampling' configuration option).  The high-water marks are logged at the end of
+// the job.
+// =======================================================================================
+
+#include "meld/utilities/periodic_sampler.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace meld {
+  struct backlog_mark {
+    std::size_t high_water{};
+    double reached_at{}; // s since the monitor was started
+  };
+
+  class backlog_monitor {
+  public:
+    using sample_t = std::function<std::map<std::string, std::size_t>()>;
+
+    backlog_monitor(std::chrono::milliseconds interval, sample_t sample);
+    ~backlog_monitor();
+
+    backlog_monitor(backlog_monitor const&) = delete;
+    backlog_monitor& operator=(backlog_monitor const&) = delete;
+
+    // Stops the periodic sampling after taking a final sample
+    void stop();
+    std::map<std::string, backlog_mark> marks() const;
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    void sample();
+
+    sample_t sample_;
+    clock::time_point const begin_{clock::now()};
+    std::map<std::string, backlog_mark> marks_;
+    mutable std::mutex mutex_;
+    std::optional<periodic_sampler> sampler_;
+  };
+}
+
+#endif // meld_core_backlog_monitor_hpp
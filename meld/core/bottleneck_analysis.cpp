@@ -0,0 +1,149 @@
+#include "meld/core/bottleneck_analysis.hpp"
+#include "meld/concurrency.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+namespace {
+  double seconds(std::uint64_t const ns) { return ns / 1e9; }
+
+  double mean_execution_time(meld::node_profile const& node)
+  {
+    return node.calls == 0ull ? 0. : seconds(node.execution_time) / node.calls;
+  }
+
+  // The longest path (weighted by the mean execution time of each node) through the
+  // dependency graph
+  std::vector<std::string> critical_path(std::vector<meld::node_profile> const& nodes)
+  {
+    std::map<std::string, meld::node_profile const*> by_name;
+    for (auto const& node : nodes) {
+      by_name.emplace(node.name, &node);
+    }
+
+    struct path_end {
+      double length{};
+      std::string const* predecessor{nullptr};
+      bool in_progress{true};
+    };
+    std::map<std::string, path_end> ends;
+
+    std::function<double(meld::node_profile const&)> longest_to =
+      [&](meld::node_profile const& node) -> double {
+      if (auto it = ends.find(node.name); it != ends.end()) {
+        // A node still in progress indicates a cycle, which cannot be part of the path.
+        return it->second.in_progress ? 0. : it->second.length;
+      }
+      ends.emplace(node.name, path_end{});
+
+      double longest_upstream{};
+      std::string const* predecessor{nullptr};
+      for (auto const& upstream_name : node.upstream) {
+        auto it = by_name.find(upstream_name);
+        if (it == by_name.end()) {
+          continue;
+        }
+        if (auto const length = longest_to(*it->second); length > longest_upstream) {
+          longest_upstream = length;
+          predecessor = &it->second->name;
+        }
+      }
+
+      auto& end = ends.at(node.name);
+      end = {longest_upstream + mean_execution_time(node), predecessor, false};
+      return end.length;
+    };
+
+    double longest{};
+    std::string const* last{nullptr};
+    for (auto const& node : nodes) {
+      if (auto const length = longest_to(node); length > longest) {
+        longest = length;
+        last = &node.name;
+      }
+    }
+
+    std::vector<std::string> result;
+    for (auto const* name = last; name != nullptr; name = ends.at(*name).predecessor) {
+      result.push_back(*name);
+    }
+    std::ranges::reverse(result);
+    return result;
+  }
+}
+
+namespace meld {
+  bottleneck_report analyze_bottlenecks(std::vector<node_profile> const& nodes,
+                                        std::size_t const max_parallelism,
+                                        double const elapsed_time,
+                                        std::size_t const n_waiting)
+  {
+    bottleneck_report result{};
+    result.max_parallelism = max_parallelism;
+
+    result.critical_path = critical_path(nodes);
+    for (auto const& name : result.critical_path) {
+      auto it = std::ranges::find(nodes, name, &node_profile::name);
+      result.critical_path_time += mean_execution_time(*it);
+    }
+
+    std::uint64_t total{}, serial{};
+    for (auto const& node : nodes) {
+      total += node.execution_time;
+      if (node.concurrency == concurrency::serial.value) {
+        serial += node.execution_time;
+      }
+    }
+    result.total_execution_time = seconds(total);
+    result.serial_execution_time = seconds(serial);
+    result.serial_fraction = total == 0ull ? 0. : static_cast<double>(serial) / total;
+    if (max_parallelism > 0ull) {
+      result.speedup_ceiling =
+        1. / (result.serial_fraction + (1. - result.serial_fraction) / max_parallelism);
+    }
+    if (elapsed_time > 0.) {
+      result.effective_parallelism = result.total_execution_time / elapsed_time;
+    }
+
+    std::vector<node_profile const*> waiting;
+    for (auto const& node : nodes) {
+      if (node.queue_wait > 0ull) {
+        waiting.push_back(&node);
+      }
+    }
+    std::ranges::sort(waiting, std::ranges::greater{}, &node_profile::queue_wait);
+    waiting.resize(std::min(waiting.size(), n_waiting));
+    for (auto const* node : waiting) {
+      auto const total_wait = seconds(node->queue_wait);
+      result.top_waiting.push_back(
+        {node->name, total_wait, node->calls == 0ull ? 0. : total_wait / node->calls});
+    }
+    return result;
+  }
+
+  void log_bottleneck_report(bottleneck_report const& report)
+  {
+    if (report.critical_path.empty()) {
+      return;
+    }
+    spdlog::info("Critical path: {} ({:.3f} ms per invocation)",
+                 fmt::join(report.critical_path, " -> "),
+                 report.critical_path_time * 1e3);
+    spdlog::info("Serial fraction: {:.2f}% of {:.5f}s execution time  Speedup ceiling: {:.2f} "
+                 "({} threads)  Effective parallelism: {:.2f}",
+                 report.serial_fraction * 100,
+                 report.total_execution_time,
+                 report.speedup_ceiling,
+                 report.max_parallelism,
+                 report.effective_parallelism);
+    for (auto const& [name, total_wait, mean_wait] : report.top_waiting) {
+      spdlog::info("Waiting time of {}: {:.5f}s total, {:.3f} ms mean",
+                   name,
+                   total_wait,
+                   mean_wait * 1e3);
+    }
+  }
+}
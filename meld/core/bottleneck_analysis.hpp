@@ -0,0 +1,71 @@
+#ifndef meld_core_bottleneck_analysis_hpp
+#define meld_core_bottleneck_analysis_hpp
+
+// =======================================================================================
+// At the end of a job, the timing statistics of the nodes (see node_statistics.hpp) are
+// combined with the structure of the function graph to explain why the job does not
+// scale further:
+//
+//   - The critical path is the chain of dependent nodes (producers of inputs and
+//     predicates) with the longest mean execution time per invocation.  No product can
+//     be created faster than the time it takes to traverse this path.
+//
+//   - The serial fraction is the fraction of the total execution time spent in nodes
+//     whose concurrency is concurrency::serial.  Following Amdahl's law, the speedup
+//     with respect to a single thread cannot exceed
+//
+//         1 / (serial_fraction + (1 - serial_fraction) / max_parallelism)
+//
+//   - The effective parallelism is the total execution time divided by the elapsed
+//     time of the job, i.e. the mean number of simultaneously executing nodes.
+//
+//   - The nodes whose messages waited longest (in total) before being processed are
+//     listed in decreasing order of waiting time.
+//
+// If requested (see framework_graph::enable_bottleneck_report), the report is logged at
+// the end of each job.
+// =======================================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace meld {
+  struct node_profile {
+    std::string name;
+    std::string kind;
+    std::size_t concurrency; // tbb::flow::unlimited is 0
+    std::uint64_t calls;
+    std::uint64_t execution_time; // ns, summed over all invocations
+    std::uint64_t queue_wait;     // ns, summed over all invocations
+    std::vector<std::string> upstream;
+  };
+
+  struct bottleneck_report {
+    struct waiting_node {
+      std::string name;
+      double total_wait; // s
+      double mean_wait;  // s
+    };
+
+    std::vector<std::string> critical_path;
+    double critical_path_time{}; // s, per invocation of each node along the path
+    double total_execution_time{};
+    double serial_execution_time{};
+    double serial_fraction{};
+    std::size_t max_parallelism{};
+    double speedup_ceiling{};
+    double effective_parallelism{};
+    std::vector<waiting_node> top_waiting;
+  };
+
+  bottleneck_report analyze_bottlenecks(std::vector<node_profile> const& nodes,
+                                        std::size_t max_parallelism,
+                                        double elapsed_time,
+                                        std::size_t n_waiting = 5);
+
+  void log_bottleneck_report(bottleneck_report const& report);
+}
+
+#endif // meld_core_bottleneck_analysis_hpp
@@ -10,13 +10,19 @@
 #include "meld/core/declared_transform.hpp"
 #include "meld/core/node_catalog.hpp"
 #include "meld/core/node_options.hpp"
+#include "meld/core/replicas.hpp"
 #include "meld/metaprogramming/delegate.hpp"
 #include "meld/metaprogramming/type_deduction.hpp"
 #include "meld/model/algorithm_name.hpp"
 
+#include "fmt/format.h"
+
 #include <concepts>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace meld {
 
@@ -35,7 +41,8 @@ namespace meld {
                    concurrency c,
                    tbb::flow::graph& g,
                    node_catalog& nodes,
-                   std::vector<std::string>& errors) :
+                   std::vector<std::string>& errors,
+                   replicas_ptr<T> replicas = nullptr) :
       node_options_t{config},
       name_{config ? config->get<std::string>("module_label") : "", std::move(name)},
       obj_{obj},
@@ -43,8 +50,35 @@ namespace meld {
       concurrency_{c},
       graph_{g},
       nodes_{nodes},
-      errors_{errors}
+      errors_{errors},
+      replicas_{std::move(replicas)}
+    {
+      if (config) {
+        cache_version_ = config->get_if_present<std::string>("cache_version");
+      }
+    }
+
+    // Uses n instances of the bound class (the bound object and n-1 new ones), each of which
+    // is used by at most one invocation at a time.  The instances are shared with the other
+    // algorithms bound to the same object; this algorithm may be invoked concurrently up to n
+    // times.
+    auto& replicated(std::size_t const n)
+      requires(not std::same_as<T, void_tag>)
     {
+      if (not replicas_) {
+        errors_.push_back(fmt::format(
+          "Algorithm '{}' cannot be replicated: its class was not created with make_replicable.",
+          name_.full()));
+        return *this;
+      }
+      if (n == 0ull) {
+        errors_.push_back(
+          fmt::format("Algorithm '{}' must be replicated at least once.", name_.full()));
+        return *this;
+      }
+      replicas_->reserve(n);
+      concurrency_ = concurrency{n};
+      return *this;
     }
 
     auto evaluate(std::array<specified_label, N> input_args)
@@ -56,8 +90,9 @@ namespace meld {
                            std::move(name_),
                            concurrency_.value,
                            node_options_t::release_predicates(),
+                           resources(),
                            graph_,
-                           delegate(obj_, ft_),
+                           bound_delegate(),
                            std::move(inputs)};
     }
 
@@ -70,8 +105,9 @@ namespace meld {
                           std::move(name_),
                           concurrency_.value,
                           node_options_t::release_predicates(),
+                          resources(),
                           graph_,
-                          delegate(obj_, ft_),
+                          bound_delegate(),
                           std::move(inputs)};
     }
 
@@ -80,13 +116,23 @@ namespace meld {
     {
       auto inputs =
         form_input_arguments<input_parameter_types>(name_.full(), std::move(input_args));
+      if (cache_version_ and not detail::cacheable_transform<FT, decltype(inputs)>) {
+        errors_.push_back(fmt::format(
+          "The results of transform '{}' cannot be cached: its input and result types must be "
+          "cacheable (see transform_cache.hpp).",
+          name_.full()));
+        cache_version_.reset();
+      }
       return pre_transform{nodes_.register_transform(errors_),
                            std::move(name_),
                            concurrency_.value,
                            node_options_t::release_predicates(),
+                           resources(),
                            graph_,
-                           delegate(obj_, ft_),
-                           std::move(inputs)};
+                           bound_delegate(),
+                           std::move(inputs),
+                           nodes_.transform_cache_,
+                           std::move(cache_version_)};
     }
 
     auto fold(std::array<specified_label, N - 1> input_args)
@@ -98,8 +144,9 @@ namespace meld {
                       std::move(name_),
                       concurrency_.value,
                       node_options_t::release_predicates(),
+                      resources(),
                       graph_,
-                      delegate(obj_, ft_),
+                      bound_delegate(),
                       std::move(inputs)};
     }
 
@@ -161,6 +208,28 @@ namespace meld {
     }
 
   private:
+    // Algorithms bound to a replicable object also hold a token of the replicas' resource,
+    // whose capacity follows the size of the (possibly grown) pool.
+    std::vector<serializer_node*> resources()
+    {
+      auto names = node_options_t::release_resources();
+      if (replicas_) {
+        nodes_.resource(graph_, replicas_->resource_name()).set_capacity(replicas_->size());
+        names.push_back(replicas_->resource_name());
+      }
+      return nodes_.resources(graph_, names);
+    }
+
+    auto bound_delegate()
+    {
+      if constexpr (std::is_member_function_pointer_v<FT>) {
+        if (replicas_) {
+          return delegate(replicas_, ft_);
+        }
+      }
+      return delegate(obj_, ft_);
+    }
+
     algorithm_name name_;
     std::shared_ptr<T> obj_;
     FT ft_;
@@ -168,6 +237,8 @@ namespace meld {
     tbb::flow::graph& graph_;
     node_catalog& nodes_;
     std::vector<std::string>& errors_;
+    replicas_ptr<T> replicas_;
+    std::optional<std::string> cache_version_;
   };
 
   template <typename T, typename FT>
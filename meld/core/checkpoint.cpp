@@ -0,0 +1,130 @@
+#include "meld/core/checkpoint.hpp"
+#include "meld/utilities/sync_file.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+  constexpr std::string_view checkpoint_magic{"MELDCKP1"};
+
+  void append_map(std::string& out, std::map<std::string, std::string> const& entries)
+  {
+    meld::detail::append_entry(out, std::to_string(entries.size()));
+    for (auto const& [name, state] : entries) {
+      meld::detail::append_entry(out, name);
+      meld::detail::append_entry(out, state);
+    }
+  }
+
+  std::map<std::string, std::string> read_map(meld::detail::state_reader& reader)
+  {
+    auto const n = std::stoull(std::string{reader.next_entry()});
+    std::map<std::string, std::string> result;
+    for (std::size_t i = 0; i != n; ++i) {
+      std::string name{reader.next_entry()};
+      result.emplace(std::move(name), reader.next_entry());
+    }
+    return result;
+  }
+}
+
+namespace meld {
+  void write_checkpoint(std::string const& filename, checkpoint_state const& state)
+  {
+    std::string contents{checkpoint_magic};
+    detail::append_entry(contents, std::to_string(state.completed_levels));
+    append_map(contents, state.folds);
+    append_map(contents, state.objects);
+
+    auto const tmp = filename + ".tmp";
+    {
+      std::ofstream file{tmp, std::ios::binary | std::ios::trunc};
+      file.write(contents.data(), contents.size());
+      if (not file.flush()) {
+        throw std::runtime_error("Could not write checkpoint file '" + tmp + "'.");
+      }
+    }
+
+    // The output data have been synced by the objects' checkpoint functions.  The new
+    // checkpoint must reach the disk before it replaces the old one, and the rename must
+    // reach the disk before the job proceeds.
+    auto const directory = std::filesystem::absolute(filename).parent_path();
+    sync_file(tmp);
+    sync_file(directory);
+    std::filesystem::rename(tmp, filename);
+    sync_file(directory);
+  }
+
+  checkpoint_state read_checkpoint(std::string const& filename)
+  {
+    std::ifstream file{filename, std::ios::binary};
+    if (not file) {
+      throw std::runtime_error("Could not open checkpoint file '" + filename + "'.");
+    }
+    std::string const contents{std::istreambuf_iterator<char>{file}, {}};
+    if (not std::string_view{contents}.starts_with(checkpoint_magic)) {
+      throw std::runtime_error("File '" + filename + "' is not a checkpoint file.");
+    }
+
+    detail::state_reader reader{std::string_view{contents}.substr(checkpoint_magic.size())};
+    checkpoint_state result;
+    result.completed_levels = std::stoull(std::string{reader.next_entry()});
+    result.folds = read_map(reader);
+    result.objects = read_map(reader);
+    return result;
+  }
+}
+
+namespace meld::detail {
+  void append_entry(std::string& out, std::string_view const entry)
+  {
+    auto const size = static_cast<std::uint64_t>(entry.size());
+    out.append(reinterpret_cast<char const*>(&size), sizeof(size));
+    out += entry;
+  }
+
+  void append_level_id(std::string& out, level_id const& id)
+  {
+    append_entry(out, std::to_string(id.depth()));
+    std::vector<level_id const*> ancestry;
+    for (auto const* current = &id; current->has_parent(); current = current->parent().get()) {
+      ancestry.push_back(current);
+    }
+    for (auto const* current : ancestry | std::views::reverse) {
+      append_entry(out, std::to_string(current->number()));
+      append_entry(out, current->level_name());
+    }
+  }
+
+  std::string_view state_reader::next_entry()
+  {
+    std::uint64_t size{};
+    if (state_.size() < sizeof(size)) {
+      throw std::runtime_error("Saved state is truncated.");
+    }
+    std::memcpy(&size, state_.data(), sizeof(size));
+    state_.remove_prefix(sizeof(size));
+    if (state_.size() < size) {
+      throw std::runtime_error("Saved state is truncated.");
+    }
+    auto const result = state_.substr(0, size);
+    state_.remove_prefix(size);
+    return result;
+  }
+
+  level_id_ptr state_reader::next_level_id()
+  {
+    auto const depth = std::stoull(std::string{next_entry()});
+    auto result = level_id::base_ptr();
+    for (std::size_t i = 0; i != depth; ++i) {
+      auto const number = std::stoull(std::string{next_entry()});
+      result = result->make_child(number, std::string{next_entry()});
+    }
+    return result;
+  }
+}
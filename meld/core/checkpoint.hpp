@@ -0,0 +1,123 @@
+#ifndef meld_core_checkpoint_hpp
+#define meld_core_checkpoint_hpp
+
+// =======================================================================================
+// Checkpoints permit a long job to be resumed after a failure.  When checkpointing is
+// enabled, the framework pauses the source after every 'interval' top-level stores (the
+// children of the job store), waits until the graph has finished processing them, and
+// saves:
+//
+//   - the number of top-level stores that have been completely processed,
+//   - the partial results of the folds that are still in progress (i.e. those whose
+//     partitions span several top-level stores), and
+//   - the state of each output object that satisfies the 'checkpointable' concept (e.g.
+//     the offset of the file it writes).
+//
+// Upon resuming, the saved states are restored, and the stores that belong to the
+// completed top-level stores are read from the source but not processed.
+//
+// Fold results can be saved if their type is trivially copyable or an std::atomic of a
+// trivially copyable type.  A job that saves checkpoints is rejected before it starts if
+// a fold partitioned by the job has a result that cannot be saved.
+// =======================================================================================
+
+#include "meld/model/fwd.hpp"
+#include "meld/model/level_id.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace meld {
+  struct checkpoint_options {
+    std::string file;
+    std::size_t interval{1};
+    bool resume{false};
+  };
+
+  struct checkpoint_state {
+    std::size_t completed_levels{};
+    std::map<std::string, std::string> folds{};
+    std::map<std::string, std::string> objects{};
+  };
+
+  // The checkpoint file is replaced atomically so that a failure while writing it leaves
+  // the previous checkpoint intact.  The file and its directory are synced to disk before
+  // and after the replacement.
+  void write_checkpoint(std::string const& filename, checkpoint_state const& state);
+  checkpoint_state read_checkpoint(std::string const& filename);
+
+  template <typename T>
+  concept checkpointable = requires(T& t, std::string_view state) {
+    { t.checkpoint() } -> std::same_as<std::string>;
+    { t.restore(state) } -> std::same_as<void>;
+  };
+
+  namespace detail {
+    template <typename T>
+    struct is_atomic : std::false_type {
+      using value_type = T;
+    };
+    template <typename T>
+    struct is_atomic<std::atomic<T>> : std::true_type {
+      using value_type = T;
+    };
+
+    // Compilers consider aggregates of atomics to be trivially copyable even though they
+    // cannot be copy-constructed, so such results cannot be restored.
+    template <typename T>
+    concept savable_fold_result =
+      (std::is_trivially_copyable_v<T> and std::is_copy_constructible_v<T>) or
+      (is_atomic<T>::value and std::is_trivially_copyable_v<typename T::value_type>);
+
+    // Length-prefixed encoding of the entries of a saved state
+    void append_entry(std::string& out, std::string_view entry);
+    void append_level_id(std::string& out, level_id const& id);
+
+    class state_reader {
+    public:
+      explicit state_reader(std::string_view state) : state_{state} {}
+      bool empty() const noexcept { return state_.empty(); }
+      std::string_view next_entry();
+      level_id_ptr next_level_id();
+
+    private:
+      std::string_view state_;
+    };
+
+    template <savable_fold_result T>
+    void append_fold_result(std::string& out, T const& t)
+    {
+      if constexpr (is_atomic<T>::value) {
+        auto const value = t.load();
+        append_entry(out, {reinterpret_cast<char const*>(&value), sizeof(value)});
+      }
+      else {
+        append_entry(out, {reinterpret_cast<char const*>(&t), sizeof(T)});
+      }
+    }
+
+    template <savable_fold_result T>
+    std::unique_ptr<T> make_fold_result(std::string_view bytes)
+    {
+      using value_type = typename is_atomic<T>::value_type;
+      if (bytes.size() != sizeof(value_type)) {
+        throw std::runtime_error("Saved fold result has the wrong size.");
+      }
+      std::array<std::byte, sizeof(value_type)> buffer;
+      std::memcpy(buffer.data(), bytes.data(), buffer.size());
+      return std::unique_ptr<T>{new T(std::bit_cast<value_type>(buffer))};
+    }
+  }
+}
+
+#endif // meld_core_checkpoint_hpp
@@ -6,6 +6,7 @@
 #include "meld/model/fwd.hpp"
 
 #include <concepts>
+#include <future>
 #include <utility>
 
 namespace meld {
@@ -43,6 +44,26 @@ namespace meld {
   template <typename T, typename R>
   concept returns = std::same_as<return_type<T>, R>;
 
+  namespace detail {
+    template <typename T>
+    constexpr bool is_future = false;
+
+    template <typename T>
+    constexpr bool is_future<std::future<T>> = true;
+
+    template <typename T>
+    constexpr bool is_future<std::shared_future<T>> = true;
+  }
+
+  // Asynchronous algorithms return futures; their results are retrieved once ready.
+  template <typename T>
+  concept returns_future = detail::is_future<return_type<T>>;
+
+  template <typename T>
+  concept returns_void_or_future_void = returns<T, void> ||
+                                        returns<T, std::future<void>> ||
+                                        returns<T, std::shared_future<void>>;
+
   template <typename T, typename... Args>
   concept expects_input_parameters = at_least_n_input_parameters<T, sizeof...(Args)> &&
                                      check_parameters<T, Args...>::value;
@@ -51,7 +72,7 @@ namespace meld {
   concept is_predicate_like = at_least_one_input_parameter<T> && returns<T, bool>;
 
   template <typename T>
-  concept is_observer_like = at_least_one_input_parameter<T> && returns<T, void>;
+  concept is_observer_like = at_least_one_input_parameter<T> && returns_void_or_future_void<T>;
 
   template <typename T>
   concept is_output_like = std::is_member_function_pointer_v<T> &&
@@ -1,15 +1,31 @@
 #include "meld/core/consumer.hpp"
 
+#include <algorithm>
+
 namespace meld {
-  consumer::consumer(algorithm_name name, std::vector<std::string> predicates) :
-    name_{std::move(name)}, predicates_{std::move(predicates)}
+  consumer::consumer(algorithm_name name,
+                     std::size_t const concurrency,
+                     std::vector<std::string> predicates) :
+    name_{std::move(name)},
+    full_name_{name_.full()},
+    concurrency_{concurrency},
+    predicates_{std::move(predicates)}
   {
   }
 
-  std::string consumer::full_name() const { return name_.full(); }
+  std::string const& consumer::full_name() const noexcept { return full_name_; }
 
   std::string const& consumer::plugin() const noexcept { return name_.plugin(); }
   std::string const& consumer::algorithm() const noexcept { return name_.algorithm(); }
 
   std::vector<std::string> const& consumer::when() const noexcept { return predicates_; }
+
+  void consumer::add_predicates(std::vector<std::string> const& predicates)
+  {
+    for (auto const& predicate : predicates) {
+      if (std::ranges::find(predicates_, predicate) == cend(predicates_)) {
+        predicates_.push_back(predicate);
+      }
+    }
+  }
 }
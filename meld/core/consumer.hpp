@@ -1,24 +1,46 @@
 #ifndef meld_core_consumer_hpp
 #define meld_core_consumer_hpp
 
+#include "meld/core/node_statistics.hpp"
 #include "meld/model/algorithm_name.hpp"
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
 namespace meld {
   class consumer {
   public:
-    consumer(algorithm_name name, std::vector<std::string> predicates);
+    consumer(algorithm_name name, std::size_t concurrency, std::vector<std::string> predicates);
 
-    std::string full_name() const;
+    // Product stores created by the consumer refer to this name as their source.
+    std::string const& full_name() const noexcept;
     std::string const& plugin() const noexcept;
     std::string const& algorithm() const noexcept;
     std::vector<std::string> const& when() const noexcept;
 
+    // The maximum number of simultaneous invocations (tbb::flow::unlimited is 0)
+    std::size_t concurrency() const noexcept { return concurrency_; }
+
+    // Adds predicates (ignoring those already present) that must be satisfied before the
+    // consumer is invoked.  Must be called before any filters are created.
+    void add_predicates(std::vector<std::string> const& predicates);
+
+    // Dense identifier assigned when the graph is finalized (see node_catalog.hpp)
+    std::size_t id() const noexcept { return id_; }
+    void set_id(std::size_t const id) noexcept { id_ = id; }
+
+    // Counters and timing of the consumer's invocations (see node_statistics.hpp)
+    node_statistics& statistics() noexcept { return statistics_; }
+    node_statistics const& statistics() const noexcept { return statistics_; }
+
   private:
     algorithm_name name_;
+    std::string full_name_;
+    std::size_t concurrency_;
     std::vector<std::string> predicates_;
+    std::size_t id_{-1ull};
+    node_statistics statistics_;
   };
 }
 
@@ -2,6 +2,7 @@
 #define meld_core_declared_fold_hpp
 
 #include "meld/concurrency.hpp"
+#include "meld/core/checkpoint.hpp"
 #include "meld/core/concepts.hpp"
 #include "meld/core/detail/port_names.hpp"
 #include "meld/core/fold/send.hpp"
@@ -11,12 +12,14 @@
 #include "meld/core/products_consumer.hpp"
 #include "meld/core/registrar.hpp"
 #include "meld/core/store_counters.hpp"
+#include "meld/graph/resource_gate.hpp"
 #include "meld/model/algorithm_name.hpp"
 #include "meld/model/handle.hpp"
 #include "meld/model/level_id.hpp"
 #include "meld/model/product_store.hpp"
 #include "meld/model/qualified_name.hpp"
 
+#include "boost/core/demangle.hpp"
 #include "oneapi/tbb/concurrent_unordered_map.h"
 #include "oneapi/tbb/flow_graph.h"
 
@@ -31,6 +34,7 @@
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -38,13 +42,20 @@
 namespace meld {
   class declared_fold : public products_consumer {
   public:
-    declared_fold(algorithm_name name, std::vector<std::string> predicates);
+    declared_fold(algorithm_name name,
+                  std::size_t concurrency,
+                  std::vector<std::string> predicates);
     virtual ~declared_fold();
 
     virtual tbb::flow::sender<message>& sender() = 0;
     virtual tbb::flow::sender<message>& to_output() = 0;
     virtual qualified_names output() const = 0;
-    virtual std::size_t product_count() const = 0;
+    std::size_t product_count() const noexcept { return statistics().products(); }
+
+    // Partial results of the fold, saved and restored at checkpoints (see checkpoint.hpp)
+    virtual bool can_save_state() const noexcept = 0;
+    virtual std::string save_state() const = 0;
+    virtual void restore_state(std::string_view state) = 0;
   };
 
   using declared_fold_ptr = std::unique_ptr<declared_fold>;
@@ -69,12 +80,14 @@ namespace meld {
              algorithm_name name,
              std::size_t concurrency,
              std::vector<std::string> predicates,
+             std::vector<serializer_node*> resources,
              tbb::flow::graph& g,
              function_t&& f,
              InputArgs input_args) :
       name_{std::move(name)},
       concurrency_{concurrency},
       predicates_{std::move(predicates)},
+      resources_{std::move(resources)},
       graph_{g},
       ft_{std::move(f)},
       input_args_{std::move(input_args)},
@@ -126,6 +139,7 @@ namespace meld {
       return std::make_unique<total_fold<decltype(init)>>(std::move(name_),
                                                           concurrency_,
                                                           std::move(predicates_),
+                                                          std::move(resources_),
                                                           graph_,
                                                           std::move(ft_),
                                                           std::move(init),
@@ -138,6 +152,7 @@ namespace meld {
     algorithm_name name_;
     std::size_t concurrency_;
     std::vector<std::string> predicates_;
+    std::vector<serializer_node*> resources_;
     tbb::flow::graph& graph_;
     function_t ft_;
     InputArgs input_args_;
@@ -154,6 +169,7 @@ namespace meld {
     total_fold(algorithm_name name,
                std::size_t concurrency,
                std::vector<std::string> predicates,
+               std::vector<serializer_node*> resources,
                tbb::flow::graph& g,
                function_t&& f,
                InitTuple initializer,
@@ -161,19 +177,24 @@ namespace meld {
                std::array<specified_label, N> product_labels,
                std::array<qualified_name, M> output,
                std::string fold_interval) :
-      declared_fold{std::move(name), std::move(predicates)},
+      declared_fold{std::move(name), concurrency, std::move(predicates)},
       initializer_{std::move(initializer)},
       product_labels_{std::move(product_labels)},
       input_{std::move(input)},
       output_{std::move(output)},
       fold_interval_{std::move(fold_interval)},
       join_{make_join_or_none(g, std::make_index_sequence<N>{})},
+      gate_{
+        make_resource_gate<messages_t<N>>(g, concurrency, std::move(resources), is_flush<N>)},
       fold_{
-        g, concurrency, [this, ft = std::move(f)](messages_t<N> const& messages, auto& outputs) {
+        g,
+        concurrency_behind(gate_, concurrency),
+        [this, ft = std::move(f)](messages_t<N> const& messages, auto& outputs) {
           // N.B. The assumption is that a fold will *never* need to cache
           //      the product store it creates.  Any flush messages *do not* need
           //      to be propagated to downstream nodes.
           auto const& msg = most_derived(messages);
+          held_resources const held{msg.store->is_flush() ? nullptr : gate_.get()};
           auto const& [store, original_message_id] = std::tie(msg.store, msg.original_id);
 
           if (not store->is_flush() and not store->id()->parent(fold_interval_)) {
@@ -203,13 +224,13 @@ namespace meld {
           if (auto counter = done_with(id_hash_for_counter)) {
             auto parent = fold_store->make_continuation(this->full_name());
             commit_(*parent);
-            ++product_count_;
+            statistics().count_products();
             // FIXME: This msg.eom value may be wrong!
             get<0>(outputs).try_put({parent, msg.eom, counter->original_message_id()});
           }
         }}
     {
-      make_edge(join_, fold_);
+      make_edges_through(join_, gate_, fold_);
     }
 
   private:
@@ -224,10 +245,16 @@ namespace meld {
     tbb::flow::sender<message>& to_output() override { return sender(); }
     specified_labels input() const override { return product_labels_; }
     qualified_names output() const override { return output_; }
+    backlog_t backlog() const override
+    {
+      return {{"results", results_.size()}, {"store_counters", pending_counters()}};
+    }
 
     template <std::size_t... Is>
     void call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
     {
+      auto const timer =
+        statistics().time(latest_arrival(messages), most_derived(messages).store->id());
       auto const& parent_id = *most_derived(messages).store->id()->parent(fold_interval_);
       // FIXME: Not the safest approach!
       auto it = results_.find(parent_id);
@@ -239,12 +266,52 @@ namespace meld {
                                         std::make_index_sequence<std::tuple_size_v<InitTuple>>{})})
             .first;
       }
-      ++calls_;
+      statistics().count_call();
       return std::invoke(ft, *it->second, std::get<Is>(input_).retrieve(messages)...);
     }
 
-    std::size_t num_calls() const final { return calls_.load(); }
-    std::size_t product_count() const final { return product_count_.load(); }
+    // Only the results of folds partitioned by the job can still be in progress at a
+    // checkpoint.
+    bool can_save_state() const noexcept final
+    {
+      return detail::savable_fold_result<R> or fold_interval_ != level_id::base().level_name();
+    }
+
+    std::string save_state() const final
+    {
+      std::string result;
+      for (auto const& [id, partial_result] : results_) {
+        if (not partial_result) {
+          continue; // Already committed
+        }
+        if constexpr (detail::savable_fold_result<R>) {
+          detail::append_level_id(result, id);
+          detail::append_fold_result(result, *partial_result);
+        }
+        else {
+          throw std::runtime_error("Cannot save the partial result of fold '" + full_name() +
+                                   "' at a checkpoint: type '" +
+                                   boost::core::demangle(typeid(R).name()) +
+                                   "' is not trivially copyable.");
+        }
+      }
+      return result;
+    }
+
+    void restore_state(std::string_view state) final
+    {
+      if constexpr (detail::savable_fold_result<R>) {
+        detail::state_reader reader{state};
+        while (not reader.empty()) {
+          auto const id = reader.next_level_id();
+          results_[*id] = detail::make_fold_result<R>(reader.next_entry());
+        }
+      }
+      else if (not state.empty()) {
+        throw std::runtime_error("Cannot restore the partial result of fold '" + full_name() +
+                                 "'.");
+      }
+    }
 
     template <size_t... Is>
     auto initialized_object(InitTuple&& tuple, std::index_sequence<Is...>) const
@@ -273,10 +340,9 @@ namespace meld {
     std::array<qualified_name, M> output_;
     std::string fold_interval_;
     join_or_none_t<N> join_;
+    std::unique_ptr<resource_gate<messages_t<N>>> gate_;
     tbb::flow::multifunction_node<messages_t<N>, messages_t<1>> fold_;
     tbb::concurrent_unordered_map<level_id, std::unique_ptr<R>> results_;
-    std::atomic<std::size_t> calls_;
-    std::atomic<std::size_t> product_count_;
   };
 }
 
@@ -9,6 +9,8 @@
 #include "meld/core/registrar.hpp"
 #include "meld/core/specified_label.hpp"
 #include "meld/core/store_counters.hpp"
+#include "meld/graph/resource_gate.hpp"
+#include "meld/graph/future_waiter.hpp"
 #include "meld/metaprogramming/type_deduction.hpp"
 #include "meld/model/algorithm_name.hpp"
 #include "meld/model/handle.hpp"
@@ -39,7 +41,9 @@ namespace meld {
 
   class declared_observer : public products_consumer {
   public:
-    declared_observer(algorithm_name name, std::vector<std::string> predicates);
+    declared_observer(algorithm_name name,
+                      std::size_t concurrency,
+                      std::vector<std::string> predicates);
     virtual ~declared_observer();
   };
 
@@ -59,12 +63,14 @@ namespace meld {
                  algorithm_name name,
                  std::size_t concurrency,
                  std::vector<std::string> predicates,
+                 std::vector<serializer_node*> resources,
                  tbb::flow::graph& g,
                  function_t&& f,
                  InputArgs input_args) :
       name_{std::move(name)},
       concurrency_{concurrency},
       predicates_{std::move(predicates)},
+      resources_{std::move(resources)},
       graph_{g},
       ft_{std::move(f)},
       input_args_{std::move(input_args)},
@@ -90,6 +96,7 @@ namespace meld {
       return std::make_unique<complete_observer>(std::move(name_),
                                                  concurrency_,
                                                  std::move(predicates_),
+                                                 std::move(resources_),
                                                  graph_,
                                                  std::move(ft_),
                                                  std::move(input_args_),
@@ -98,6 +105,7 @@ namespace meld {
     algorithm_name name_;
     std::size_t concurrency_;
     std::vector<std::string> predicates_;
+    std::vector<serializer_node*> resources_;
     tbb::flow::graph& graph_;
     function_t ft_;
     InputArgs input_args_;
@@ -119,36 +127,49 @@ namespace meld {
     complete_observer(algorithm_name name,
                       std::size_t concurrency,
                       std::vector<std::string> predicates,
+                      std::vector<serializer_node*> resources,
                       tbb::flow::graph& g,
                       function_t&& f,
                       InputArgs input,
                       std::array<specified_label, N> product_labels) :
-      declared_observer{std::move(name), std::move(predicates)},
+      declared_observer{std::move(name), concurrency, std::move(predicates)},
       product_labels_{std::move(product_labels)},
       input_{std::move(input)},
       join_{make_join_or_none(g, std::make_index_sequence<N>{})},
+      gate_{
+        make_resource_gate<messages_t<N>>(g, concurrency, std::move(resources), is_flush<N>)},
       observer_{g,
-                concurrency,
+                concurrency_behind(gate_, concurrency),
                 [this, ft = std::move(f)](
                   messages_t<N> const& messages) -> oneapi::tbb::flow::continue_msg {
                   auto const& msg = most_derived(messages);
+                  held_resources const held{msg.store->is_flush() ? nullptr : gate_.get()};
                   auto const& [store, message_id] = std::tie(msg.store, msg.id);
                   if (store->is_flush()) {
                     flag_for(store->id()->hash()).flush_received(message_id);
                   }
                   else if (accessor a; needs_new(store, a)) {
-                    call(ft, messages, std::make_index_sequence<N>{});
-                    a->second = true;
-                    flag_for(store->id()->hash()).mark_as_processed();
+                    if constexpr (returns_future<function_t>) {
+                      // The result may be ready before 'launch' returns (see 'resume').
+                      a.release();
+                      launch(ft, messages);
+                      return {};
+                    }
+                    else {
+                      call(ft, messages, std::make_index_sequence<N>{});
+                      a->second = true;
+                      flag_for(store->id()->hash()).mark_as_processed();
+                    }
                   }
 
                   if (done_with(store)) {
                     stores_.erase(store->id()->hash());
                   }
                   return {};
-                }}
+                }},
+      waiter_{returns_future<function_t> ? std::make_unique<future_waiter>(g) : nullptr}
     {
-      make_edge(join_, observer_);
+      make_edges_through(join_, gate_, observer_);
     }
 
     ~complete_observer()
@@ -170,6 +191,10 @@ namespace meld {
     std::vector<tbb::flow::receiver<message>*> ports() override { return input_ports<N>(join_); }
 
     specified_labels input() const override { return product_labels_; }
+    backlog_t backlog() const override
+    {
+      return {{"stores", stores_.size()}, {"flush_flags", pending_flags()}};
+    }
 
     bool needs_new(product_store_const_ptr const& store, accessor& a)
     {
@@ -180,20 +205,71 @@ namespace meld {
     }
 
     template <std::size_t... Is>
-    void call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
+    auto call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
+    {
+      auto const timer =
+        statistics().time(latest_arrival(messages), most_derived(messages).store->id());
+      statistics().count_call();
+      return invoke(ft, messages, std::index_sequence<Is...>{});
+    }
+
+    template <std::size_t... Is>
+    auto invoke(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
     {
-      ++calls_;
       return std::invoke(ft, std::get<Is>(input_).retrieve(messages)...);
     }
 
-    std::size_t num_calls() const final { return calls_.load(); }
+    // Asynchronous calls return immediately; the 'resume' function is invoked as a separate
+    // flow-graph task once the future is ready.  The invocation is timed from its launch
+    // until its result has been retrieved.
+    void launch(function_t const& ft, messages_t<N> const& messages)
+    {
+      auto const arrival = latest_arrival(messages);
+      auto const start = node_statistics::clock::now();
+      statistics().count_call();
+      std::shared_ptr<return_type<function_t>> pending;
+      try {
+        pending = std::make_shared<return_type<function_t>>(
+          invoke(ft, messages, std::make_index_sequence<N>{}));
+      }
+      catch (...) {
+        statistics().count_failure();
+        throw;
+      }
+      waiter_->submit(*pending,
+                      [this, pending, store = most_derived(messages).store, arrival, start] {
+                        resume(*pending, store, arrival, start);
+                      });
+    }
+
+    void resume(auto& pending,
+                product_store_const_ptr const& store,
+                node_statistics::clock::time_point const arrival,
+                node_statistics::clock::time_point const start)
+    {
+      {
+        auto const timer = statistics().time_since(arrival, start, store->id());
+        pending.get();
+      }
+      {
+        accessor a;
+        stores_.find(a, store->id()->hash());
+        a->second = true;
+      }
+      flag_for(store->id()->hash()).mark_as_processed();
+
+      if (done_with(store)) {
+        stores_.erase(store->id()->hash());
+      }
+    }
 
     std::array<specified_label, N> product_labels_;
     InputArgs input_;
     join_or_none_t<N> join_;
+    std::unique_ptr<resource_gate<messages_t<N>>> gate_;
     tbb::flow::function_node<messages_t<N>> observer_;
     tbb::concurrent_hash_map<level_id::hash_type, bool> stores_;
-    std::atomic<std::size_t> calls_;
+    std::unique_ptr<future_waiter> waiter_;
   };
 }
 
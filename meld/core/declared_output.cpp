@@ -5,10 +5,22 @@ namespace meld {
                                    std::size_t concurrency,
                                    std::vector<std::string> predicates,
                                    tbb::flow::graph& g,
-                                   detail::output_function_t&& ft) :
-    consumer{std::move(name), std::move(predicates)},
-    node_{g, concurrency, [f = std::move(ft)](message const& msg) -> tbb::flow::continue_msg {
-            if (not msg.store->is_flush()) {
+                                   detail::output_function_t&& ft,
+                                   std::optional<output_buffer_options> buffering) :
+    consumer{std::move(name), concurrency, std::move(predicates)},
+    buffer_{buffering ? std::make_unique<output_buffer>(g, std::move(ft), *buffering) : nullptr},
+    node_{g,
+          buffer_ ? tbb::flow::unlimited : concurrency,
+          [this, f = std::move(ft)](message const& msg) -> tbb::flow::continue_msg {
+            if (msg.store->is_flush()) {
+              return {};
+            }
+            auto const timer = statistics().time(msg.sent, msg.store->id());
+            statistics().count_call();
+            if (buffer_) {
+              buffer_->push(msg.store);
+            }
+            else {
               f(*msg.store);
             }
             return {};
@@ -17,4 +29,25 @@ namespace meld {
   }
 
   tbb::flow::receiver<message>& declared_output::port() noexcept { return node_; }
+
+  bool declared_output::full() const { return buffer_ and buffer_->full(); }
+
+  void declared_output::on_capacity(std::function<void()> notify)
+  {
+    if (buffer_) {
+      buffer_->on_capacity(std::move(notify));
+    }
+  }
+
+  std::size_t declared_output::buffered_stores() const
+  {
+    return buffer_ ? buffer_->size() : 0ull;
+  }
+
+  void declared_output::rethrow_if_failed()
+  {
+    if (buffer_) {
+      buffer_->rethrow_if_failed();
+    }
+  }
 }
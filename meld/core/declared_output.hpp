@@ -6,6 +6,7 @@
 #include "meld/core/fwd.hpp"
 #include "meld/core/message.hpp"
 #include "meld/core/node_options.hpp"
+#include "meld/core/output_buffer.hpp"
 #include "meld/core/registrar.hpp"
 #include "meld/model/algorithm_name.hpp"
 #include "meld/model/level_id.hpp"
@@ -13,10 +14,12 @@
 
 #include "oneapi/tbb/flow_graph.h"
 
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -31,11 +34,22 @@ namespace meld {
                     std::size_t concurrency,
                     std::vector<std::string> predicates,
                     tbb::flow::graph& g,
-                    detail::output_function_t&& ft);
+                    detail::output_function_t&& ft,
+                    std::optional<output_buffer_options> buffering = std::nullopt);
 
     tbb::flow::receiver<message>& port() noexcept;
 
+    // Whether the output buffer (if any) is full
+    bool full() const;
+    // Invoked by the writer thread once a full output buffer has room again
+    void on_capacity(std::function<void()> notify);
+    void rethrow_if_failed();
+
+    // The number of stores waiting in the output buffer (zero if the output is unbuffered)
+    std::size_t buffered_stores() const;
+
   private:
+    std::unique_ptr<output_buffer> buffer_;
     tbb::flow::function_node<message> node_;
   };
 
@@ -59,9 +73,34 @@ namespace meld {
       concurrency_{c},
       reg_{std::move(reg)}
     {
+      if (auto buffering = config ? config->get_if_present<boost::json::object>("buffered")
+                                  : std::nullopt) {
+        configuration const options{*buffering};
+        output_buffer_options const defaults{};
+        buffered(options.get_if_present<std::size_t>("capacity").value_or(defaults.capacity),
+                 options.get_if_present<std::size_t>("batch_size").value_or(defaults.batch_size),
+                 std::chrono::milliseconds{
+                   options.get_if_present<std::chrono::milliseconds::rep>("flush_interval_ms")
+                     .value_or(defaults.flush_interval.count())});
+      }
       reg_.set([this] { return create(); });
     }
 
+    // Instead of being invoked on a worker thread, the output function is invoked
+    // serially by a dedicated writer thread, which writes the stores in batches of up to
+    // 'batch_size'.  A partial batch is written once 'flush_interval' has elapsed.  The
+    // framework stops reading new stores from the source while 'capacity' stores are
+    // waiting to be written.
+    output_creator& buffered(std::size_t capacity,
+                             std::size_t batch_size = 1,
+                             std::chrono::milliseconds flush_interval = {})
+    {
+      if (!buffering_) {
+        buffering_ = output_buffer_options{capacity, batch_size, flush_interval};
+      }
+      return *this;
+    }
+
   private:
     declared_output_ptr create()
     {
@@ -69,13 +108,15 @@ namespace meld {
                                                concurrency_.value,
                                                node_options_t::release_predicates(),
                                                graph_,
-                                               std::move(ft_));
+                                               std::move(ft_),
+                                               buffering_);
     }
 
     algorithm_name name_;
     tbb::flow::graph& graph_;
     detail::output_function_t ft_;
     concurrency concurrency_;
+    std::optional<output_buffer_options> buffering_;
     registrar<declared_outputs> reg_;
   };
 }
@@ -10,6 +10,7 @@
 #include "meld/core/registrar.hpp"
 #include "meld/core/specified_label.hpp"
 #include "meld/core/store_counters.hpp"
+#include "meld/graph/resource_gate.hpp"
 #include "meld/metaprogramming/type_deduction.hpp"
 #include "meld/model/algorithm_name.hpp"
 #include "meld/model/handle.hpp"
@@ -40,7 +41,9 @@ namespace meld {
 
   class declared_predicate : public products_consumer {
   public:
-    declared_predicate(algorithm_name name, std::vector<std::string> predicates);
+    declared_predicate(algorithm_name name,
+                       std::size_t concurrency,
+                       std::vector<std::string> predicates);
     virtual ~declared_predicate();
 
     virtual tbb::flow::sender<predicate_result>& sender() = 0;
@@ -63,12 +66,14 @@ namespace meld {
                   algorithm_name name,
                   std::size_t concurrency,
                   std::vector<std::string> predicates,
+                  std::vector<serializer_node*> resources,
                   tbb::flow::graph& g,
                   function_t&& f,
                   InputArgs input_args) :
       name_{std::move(name)},
       concurrency_{concurrency},
       predicates_{std::move(predicates)},
+      resources_{std::move(resources)},
       graph_{g},
       ft_{std::move(f)},
       input_args_{std::move(input_args)},
@@ -94,6 +99,7 @@ namespace meld {
       return std::make_unique<complete_predicate>(std::move(name_),
                                                   concurrency_,
                                                   std::move(predicates_),
+                                                  std::move(resources_),
                                                   graph_,
                                                   std::move(ft_),
                                                   std::move(input_args_),
@@ -102,6 +108,7 @@ namespace meld {
     algorithm_name name_;
     std::size_t concurrency_;
     std::vector<std::string> predicates_;
+    std::vector<serializer_node*> resources_;
     tbb::flow::graph& graph_;
     function_t ft_;
     InputArgs input_args_;
@@ -125,18 +132,22 @@ namespace meld {
     complete_predicate(algorithm_name name,
                        std::size_t concurrency,
                        std::vector<std::string> predicates,
+                       std::vector<serializer_node*> resources,
                        tbb::flow::graph& g,
                        function_t&& f,
                        InputArgs input,
                        std::array<specified_label, N> product_labels) :
-      declared_predicate{std::move(name), std::move(predicates)},
+      declared_predicate{std::move(name), concurrency, std::move(predicates)},
       product_labels_{std::move(product_labels)},
       input_{std::move(input)},
       join_{make_join_or_none(g, std::make_index_sequence<N>{})},
+      gate_{
+        make_resource_gate<messages_t<N>>(g, concurrency, std::move(resources), is_flush<N>)},
       predicate_{g,
-                 concurrency,
+                 concurrency_behind(gate_, concurrency),
                  [this, ft = std::move(f)](messages_t<N> const& messages) -> predicate_result {
                    auto const& msg = most_derived(messages);
+                   held_resources const held{msg.store->is_flush() ? nullptr : gate_.get()};
                    auto const& [store, message_id] = std::tie(msg.store, msg.id);
                    predicate_result result{};
                    if (store->is_flush()) {
@@ -157,7 +168,7 @@ namespace meld {
                    return result;
                  }}
     {
-      make_edge(join_, predicate_);
+      make_edges_through(join_, gate_, predicate_);
     }
 
     ~complete_predicate()
@@ -177,22 +188,26 @@ namespace meld {
 
     tbb::flow::sender<predicate_result>& sender() override { return predicate_; }
     specified_labels input() const override { return product_labels_; }
+    backlog_t backlog() const override
+    {
+      return {{"results", results_.size()}, {"flush_flags", pending_flags()}};
+    }
 
     template <std::size_t... Is>
     bool call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
     {
-      ++calls_;
+      auto const timer =
+        statistics().time(latest_arrival(messages), most_derived(messages).store->id());
+      statistics().count_call();
       return std::invoke(ft, std::get<Is>(input_).retrieve(messages)...);
     }
 
-    std::size_t num_calls() const final { return calls_.load(); }
-
     std::array<specified_label, N> product_labels_;
     InputArgs input_;
     join_or_none_t<N> join_;
+    std::unique_ptr<resource_gate<messages_t<N>>> gate_;
     tbb::flow::function_node<messages_t<N>, predicate_result> predicate_;
     results_t results_;
-    std::atomic<std::size_t> calls_;
   };
 
 }
@@ -12,6 +12,9 @@
 #include "meld/core/registrar.hpp"
 #include "meld/core/specified_label.hpp"
 #include "meld/core/store_counters.hpp"
+#include "meld/core/transform_cache.hpp"
+#include "meld/graph/resource_gate.hpp"
+#include "meld/graph/future_waiter.hpp"
 #include "meld/metaprogramming/type_deduction.hpp"
 #include "meld/model/algorithm_name.hpp"
 #include "meld/model/handle.hpp"
@@ -32,8 +35,10 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <span>
+#include <vector>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -43,18 +48,33 @@ namespace meld {
 
   class declared_transform : public products_consumer {
   public:
-    declared_transform(algorithm_name name, std::vector<std::string> predicates);
+    declared_transform(algorithm_name name,
+                       std::size_t concurrency,
+                       std::vector<std::string> predicates);
     virtual ~declared_transform();
 
     virtual tbb::flow::sender<message>& sender() = 0;
     virtual tbb::flow::sender<message>& to_output() = 0;
     virtual qualified_names output() const = 0;
-    virtual std::size_t product_count() const = 0;
+    std::size_t product_count() const noexcept { return statistics().products(); }
+
+    // The number of results loaded from and missing from the transform cache, or no value
+    // if the transform's results are not cached
+    virtual std::optional<cache_counts> cache_statistics() const = 0;
   };
 
   using declared_transform_ptr = std::unique_ptr<declared_transform>;
   using declared_transforms = std::map<std::string, declared_transform_ptr>;
 
+  namespace detail {
+    // Both the inputs (which form the cache key) and the results must be cacheable.
+    template <typename FT, typename InputArgs>
+    constexpr bool cacheable_transform =
+      cacheable<return_type<FT>> and []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return (cacheable<typename std::tuple_element_t<Is, InputArgs>::handle_arg_t> and ...);
+      }(std::make_index_sequence<std::tuple_size_v<InputArgs>>{});
+  }
+
   // =====================================================================================
 
   template <is_transform_like FT, typename InputArgs>
@@ -71,16 +91,22 @@ namespace meld {
                   algorithm_name name,
                   std::size_t concurrency,
                   std::vector<std::string> predicates,
+                  std::vector<serializer_node*> resources,
                   tbb::flow::graph& g,
                   function_t&& f,
-                  InputArgs input_args) :
+                  InputArgs input_args,
+                  transform_cache const& cache,
+                  std::optional<std::string> cache_version) :
       name_{std::move(name)},
       concurrency_{concurrency},
       predicates_{std::move(predicates)},
+      resources_{std::move(resources)},
       graph_{g},
       ft_{std::move(f)},
       input_args_{std::move(input_args)},
       product_labels_{detail::port_names(input_args_)},
+      cache_{cache},
+      cache_version_{std::move(cache_version)},
       reg_{std::move(reg)}
     {
     }
@@ -118,26 +144,45 @@ namespace meld {
       return to(std::array<std::string, M>{std::forward<decltype(ts)>(ts)...});
     }
 
+    // Caches the results on disk, identified by the version of the transform's code (see
+    // transform_cache.hpp).  The version must be changed whenever the code changes.
+    auto& cached(std::string version)
+    {
+      static_assert(detail::cacheable_transform<function_t, InputArgs>,
+                    "The input and result types of a cached transform must be cacheable (see "
+                    "transform_cache.hpp).");
+      if (!cache_version_) {
+        cache_version_ = std::move(version);
+      }
+      return *this;
+    }
+
   private:
     declared_transform_ptr create(std::array<qualified_name, M> outputs)
     {
       return std::make_unique<total_transform<M>>(std::move(name_),
                                                   concurrency_,
                                                   std::move(predicates_),
+                                                  std::move(resources_),
                                                   graph_,
                                                   std::move(ft_),
                                                   std::move(input_args_),
                                                   std::move(product_labels_),
-                                                  std::move(outputs));
+                                                  std::move(outputs),
+                                                  cache_,
+                                                  std::move(cache_version_));
     }
 
     algorithm_name name_;
     std::size_t concurrency_;
     std::vector<std::string> predicates_;
+    std::vector<serializer_node*> resources_;
     tbb::flow::graph& graph_;
     function_t ft_;
     InputArgs input_args_;
     std::array<specified_label, N> product_labels_;
+    transform_cache const& cache_;
+    std::optional<std::string> cache_version_;
     registrar<declared_transforms> reg_;
   };
 
@@ -151,24 +196,35 @@ namespace meld {
     using stores_t = tbb::concurrent_hash_map<level_id::hash_type, product_store_ptr>;
     using accessor = stores_t::accessor;
     using const_accessor = stores_t::const_accessor;
+    using waiting_t = tbb::concurrent_hash_map<level_id::hash_type, std::vector<message>>;
 
   public:
     total_transform(algorithm_name name,
                     std::size_t concurrency,
                     std::vector<std::string> predicates,
+                    std::vector<serializer_node*> resources,
                     tbb::flow::graph& g,
                     function_t&& f,
                     InputArgs input,
                     std::array<specified_label, N> product_labels,
-                    std::array<qualified_name, M> output) :
-      declared_transform{std::move(name), std::move(predicates)},
+                    std::array<qualified_name, M> output,
+                    transform_cache const& cache,
+                    std::optional<std::string> cache_version) :
+      declared_transform{std::move(name), concurrency, std::move(predicates)},
       product_labels_{std::move(product_labels)},
       input_{std::move(input)},
       output_{std::move(output)},
+      cache_{cache},
+      cache_version_{std::move(cache_version)},
       join_{make_join_or_none(g, std::make_index_sequence<N>{})},
+      gate_{
+        make_resource_gate<messages_t<N>>(g, concurrency, std::move(resources), is_flush<N>)},
       transform_{
-        g, concurrency, [this, ft = std::move(f)](messages_t<N> const& messages, auto& output) {
+        g,
+        concurrency_behind(gate_, concurrency),
+        [this, ft = std::move(f)](messages_t<N> const& messages, auto& output) {
           auto const& msg = most_derived(messages);
+          held_resources const held{msg.store->is_flush() ? nullptr : gate_.get()};
           auto const& [store, message_eom, message_id] = std::tie(msg.store, msg.eom, msg.id);
           auto& [stay_in_graph, to_output] = output;
           if (store->is_flush()) {
@@ -179,17 +235,32 @@ namespace meld {
           else {
             accessor a;
             if (stores_.insert(a, store->id()->hash())) {
-              auto result = call(ft, messages, std::make_index_sequence<N>{});
-              ++calls_;
-              ++product_count_[store->id()->level_hash()];
-              products new_products;
-              new_products.add_all(output_, std::move(result));
-              a->second = store->make_continuation(this->full_name(), std::move(new_products));
-
-              message const new_msg{a->second, msg.eom, message_id};
-              stay_in_graph.try_put(new_msg);
-              to_output.try_put(new_msg);
-              flag_for(store->id()->hash()).mark_as_processed();
+              if constexpr (returns_future<function_t>) {
+                // The new store is created once the result is ready (see 'resume'), which
+                // may happen before 'launch' returns.
+                a.release();
+                launch(ft, messages);
+                return;
+              }
+              else {
+                auto result = call_or_load(ft, messages);
+                statistics().count_products();
+                products new_products;
+                new_products.add_all(output_, std::move(result));
+                a->second = store->make_continuation(this->full_name(), std::move(new_products));
+
+                message const new_msg{a->second, msg.eom, message_id};
+                stay_in_graph.try_put(new_msg);
+                to_output.try_put(new_msg);
+                flag_for(store->id()->hash()).mark_as_processed();
+              }
+            }
+            else if (not a->second) {
+              // The result of an asynchronous call is still outstanding.
+              waiting_t::accessor wa;
+              waiting_.insert(wa, store->id()->hash());
+              wa->second.push_back(msg);
+              return;
             }
             else {
               stay_in_graph.try_put({a->second, msg.eom, message_id});
@@ -199,9 +270,10 @@ namespace meld {
           if (done_with(store)) {
             stores_.erase(store->id()->hash());
           }
-        }}
+        }},
+      waiter_{returns_future<function_t> ? std::make_unique<future_waiter>(g) : nullptr}
     {
-      make_edge(join_, transform_);
+      make_edges_through(join_, gate_, transform_);
     }
 
     ~total_transform()
@@ -226,6 +298,12 @@ namespace meld {
     tbb::flow::sender<message>& to_output() override { return output_port<1>(transform_); }
     specified_labels input() const override { return product_labels_; }
     qualified_names output() const override { return output_; }
+    backlog_t backlog() const override
+    {
+      return {{"stores", stores_.size()},
+              {"waiting", waiting_.size()},
+              {"flush_flags", pending_flags()}};
+    }
 
     template <std::size_t... Is>
     auto call(function_t const& ft, messages_t<N> const& messages, std::index_sequence<Is...>)
@@ -233,24 +311,143 @@ namespace meld {
       return std::invoke(ft, std::get<Is>(input_).retrieve(messages)...);
     }
 
-    std::size_t num_calls() const final { return calls_.load(); }
-    std::size_t product_count() const final
+    static constexpr bool cacheable_results = detail::cacheable_transform<function_t, InputArgs>;
+
+    auto call_or_load(function_t const& ft, messages_t<N> const& messages)
     {
-      std::size_t result{};
-      for (auto const& count : product_count_ | std::views::values) {
-        result += count.load();
+      auto const timer =
+        statistics().time(latest_arrival(messages), most_derived(messages).store->id());
+      using result_t = return_type<function_t>;
+      if constexpr (cacheable_results) {
+        if (cache_version_ and cache_.enabled()) {
+          auto const [key, identity] = cache_entry(messages, std::make_index_sequence<N>{});
+          if (auto const bytes = cache_.load(key, identity)) {
+            try {
+              std::string_view remaining{*bytes};
+              auto result = cache_traits<result_t>::from_bytes(remaining);
+              ++cache_hits_;
+              return result;
+            }
+            catch (std::exception const& e) {
+              spdlog::warn("Ignoring cached result of transform {}: {}", full_name(), e.what());
+            }
+          }
+          ++cache_misses_;
+          auto result = call(ft, messages, std::make_index_sequence<N>{});
+          statistics().count_call();
+          std::string bytes;
+          cache_traits<result_t>::to_bytes(result, bytes);
+          cache_.store(key, identity, bytes);
+          return result;
+        }
       }
+      auto result = call(ft, messages, std::make_index_sequence<N>{});
+      statistics().count_call();
       return result;
     }
 
+    // The key and the identity of the cache entry for the inputs
+    template <std::size_t... Is>
+    std::pair<std::string, std::string> cache_entry(messages_t<N> const& messages,
+                                                    std::index_sequence<Is...>) const
+    {
+      std::string input_bytes;
+      (append_input(input_bytes, *std::get<Is>(input_).retrieve(messages)), ...);
+      algorithm_name const name{this->plugin(), this->algorithm()};
+      return {transform_cache::make_key(name, *cache_version_, input_bytes),
+              transform_cache::make_identity(name, *cache_version_, input_bytes)};
+    }
+
+    template <typename T>
+    static void append_input(std::string& out, T const& t)
+    {
+      cache_traits<T>::to_bytes(t, out);
+    }
+
+    // Asynchronous calls return immediately; the result is retrieved by the 'resume'
+    // function, which is invoked as a separate flow-graph task once the future is ready.
+    // The invocation is timed from its launch until its result has been retrieved.
+    void launch(function_t const& ft, messages_t<N> const& messages)
+    {
+      auto const& msg = most_derived(messages);
+      auto const arrival = latest_arrival(messages);
+      auto const start = node_statistics::clock::now();
+      statistics().count_call();
+      std::shared_ptr<return_type<function_t>> pending;
+      try {
+        pending = std::make_shared<return_type<function_t>>(
+          call(ft, messages, std::make_index_sequence<N>{}));
+      }
+      catch (...) {
+        statistics().count_failure();
+        throw;
+      }
+      waiter_->submit(*pending, [this, pending, msg, arrival, start] {
+        resume(*pending, msg, arrival, start);
+      });
+    }
+
+    void resume(auto& pending,
+                message const& msg,
+                node_statistics::clock::time_point const arrival,
+                node_statistics::clock::time_point const start)
+    {
+      auto const& store = msg.store;
+      products new_products;
+      {
+        auto const timer = statistics().time_since(arrival, start, store->id());
+        new_products.add_all(output_, pending.get());
+      }
+      statistics().count_products();
+
+      product_store_ptr new_store;
+      std::vector<message> waiting;
+      {
+        accessor a;
+        stores_.find(a, store->id()->hash());
+        a->second = store->make_continuation(this->full_name(), std::move(new_products));
+        new_store = a->second;
+        if (waiting_t::accessor wa; waiting_.find(wa, store->id()->hash())) {
+          waiting = std::move(wa->second);
+          waiting_.erase(wa);
+        }
+      }
+
+      message const new_msg{new_store, msg.eom, msg.id};
+      auto& [stay_in_graph, to_output] = transform_.output_ports();
+      stay_in_graph.try_put(new_msg);
+      to_output.try_put(new_msg);
+      for (auto const& waiting_msg : waiting) {
+        stay_in_graph.try_put({new_store, waiting_msg.eom, waiting_msg.id});
+      }
+      flag_for(store->id()->hash()).mark_as_processed();
+
+      if (done_with(store)) {
+        stores_.erase(store->id()->hash());
+      }
+    }
+
+    std::optional<cache_counts> cache_statistics() const final
+    {
+      if (not cache_version_ or not cache_.enabled()) {
+        return std::nullopt;
+      }
+      return cache_counts{cache_hits_.load(), cache_misses_.load()};
+    }
+
     std::array<specified_label, N> product_labels_;
     InputArgs input_;
     std::array<qualified_name, M> output_;
+    transform_cache const& cache_;
+    std::optional<std::string> cache_version_;
     join_or_none_t<N> join_;
+    std::unique_ptr<resource_gate<messages_t<N>>> gate_;
     tbb::flow::multifunction_node<messages_t<N>, messages_t<2u>> transform_;
     stores_t stores_;
-    std::atomic<std::size_t> calls_;
-    tbb::concurrent_unordered_map<std::size_t, std::atomic<std::size_t>> product_count_;
+    waiting_t waiting_;
+    std::unique_ptr<future_waiter> waiter_;
+    std::atomic<std::size_t> cache_hits_;
+    std::atomic<std::size_t> cache_misses_;
   };
 
 }
@@ -30,8 +30,10 @@ namespace meld {
     return result;
   }
 
-  declared_unfold::declared_unfold(algorithm_name name, std::vector<std::string> predicates) :
-    products_consumer{std::move(name), std::move(predicates)}
+  declared_unfold::declared_unfold(algorithm_name name,
+                                   std::size_t const concurrency,
+                                   std::vector<std::string> predicates) :
+    products_consumer{std::move(name), concurrency, std::move(predicates)}
   {
   }
 
@@ -60,13 +60,15 @@ namespace meld {
 
   class declared_unfold : public products_consumer {
   public:
-    declared_unfold(algorithm_name name, std::vector<std::string> predicates);
+    declared_unfold(algorithm_name name,
+                    std::size_t concurrency,
+                    std::vector<std::string> predicates);
     virtual ~declared_unfold();
 
     virtual tbb::flow::sender<message>& to_output() = 0;
     virtual qualified_names output() const = 0;
     virtual void finalize(multiplexer::head_ports_t head_ports) = 0;
-    virtual std::size_t product_count() const = 0;
+    std::size_t product_count() const noexcept { return statistics().products(); }
     virtual multiplexer::head_ports_t const& downstream_ports() const = 0;
   };
 
@@ -173,7 +175,7 @@ namespace meld {
                     std::array<specified_label, N> product_labels,
                     std::array<qualified_name, M> output_products,
                     std::string new_level_name) :
-      declared_unfold{std::move(name), std::move(predicates)},
+      declared_unfold{std::move(name), concurrency, std::move(predicates)},
       product_labels_{std::move(product_labels)},
       input_{std::move(input)},
       output_{std::move(output_products)},
@@ -230,6 +232,10 @@ namespace meld {
 
     specified_labels input() const override { return product_labels_; }
     qualified_names output() const override { return output_; }
+    backlog_t backlog() const override
+    {
+      return {{"stores", stores_.size()}, {"flush_flags", pending_flags()}};
+    }
 
     void finalize(multiplexer::head_ports_t head_ports) override
     {
@@ -250,7 +256,9 @@ namespace meld {
               messages_t<N> const& messages,
               std::index_sequence<Is...>)
     {
-      ++calls_;
+      auto const timer =
+        statistics().time(latest_arrival(messages), most_derived(messages).store->id());
+      statistics().count_call();
       Object obj(std::get<Is>(input_).retrieve(messages)...);
       std::size_t counter = 0;
       auto running_value = obj.initial_value();
@@ -267,15 +275,12 @@ namespace meld {
           new_products.add_all(output_, std::move(prods));
           running_value = next_value;
         }
-        ++product_count_;
+        statistics().count_products();
         auto child = g.make_child_for(counter++, std::move(new_products));
         to_output_.try_put({child, eom->make_child(child->id()), ++msg_counter_});
       }
     }
 
-    std::size_t num_calls() const final { return calls_.load(); }
-    std::size_t product_count() const final { return product_count_.load(); }
-
     std::array<specified_label, N> product_labels_;
     InputArgs input_;
     std::array<qualified_name, M> output_;
@@ -286,8 +291,6 @@ namespace meld {
     tbb::flow::broadcast_node<message> to_output_;
     tbb::concurrent_hash_map<level_id::hash_type, product_store_ptr> stores_;
     std::atomic<std::size_t> msg_counter_{}; // Is this sufficient?  Probably not.
-    std::atomic<std::size_t> calls_{};
-    std::atomic<std::size_t> product_count_{};
   };
 }
 
@@ -1,5 +1,6 @@
 #include "meld/core/detail/filter_impl.hpp"
 
+#include <algorithm>
 #include <string>
 
 namespace {
@@ -78,7 +79,9 @@ namespace meld {
   {
     decltype(stores_)::const_accessor a;
     if (stores_.find(a, msg_id)) {
-      return a->second.size() == nargs_;
+      // Each slot is filled only once the store providing the corresponding product has
+      // been received.
+      return std::ranges::none_of(a->second, [](auto const& store) { return store == nullptr; });
     }
     return false;
   }
@@ -40,6 +40,7 @@ namespace meld {
     void update(predicate_result result);
     unsigned int value(std::size_t msg_id) const;
     void erase(std::size_t msg_id);
+    std::size_t size() const { return results_.size(); }
 
   private:
     unsigned int const total_decisions_;
@@ -62,6 +63,7 @@ namespace meld {
 
     void update(std::size_t const msg_id, product_store_const_ptr const& store);
     std::vector<product_store_const_ptr> release_data(accessor& a, std::size_t const msg_id);
+    std::size_t size() const { return stores_.size(); }
 
   private:
     stores_t stores_;
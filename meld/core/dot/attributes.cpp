@@ -1,7 +1,12 @@
 #include "meld/core/dot/attributes.hpp"
 
+#include "fmt/format.h"
+
+#include <algorithm>
+
 namespace {
   std::string maybe_comma(std::string const& result) { return result.empty() ? "" : ", "; }
+  double clamped(double const heat) { return std::clamp(heat, 0., 1.); }
 }
 
 namespace meld::dot {
@@ -26,8 +31,30 @@ namespace meld::dot {
     if (not attrs.style.empty()) {
       result += maybe_comma(result) + "style=" + attrs.style;
     }
+    if (not attrs.fillcolor.empty()) {
+      result += maybe_comma(result) + "fillcolor=" + attrs.fillcolor;
+    }
+    if (not attrs.penwidth.empty()) {
+      result += maybe_comma(result) + "penwidth=" + attrs.penwidth;
+    }
     return "[" + result + "]";
   }
 
   std::string parenthesized(std::string const& n) { return "(" + n + ")"; }
+
+  // The colors are specified as "hue saturation value".
+  std::string heat_fillcolor(double const heat)
+  {
+    return fmt::format("\"0.000 {:.3f} 1.000\"", clamped(heat));
+  }
+
+  std::string heat_color(double const heat)
+  {
+    return fmt::format("\"{:.3f} 1.000 0.850\"", 0.667 * (1. - clamped(heat)));
+  }
+
+  std::string heat_penwidth(double const heat)
+  {
+    return fmt::format("{:.1f}", 1. + 4. * clamped(heat));
+  }
 }
@@ -11,12 +11,20 @@ namespace meld::dot {
     std::string label;
     std::string shape;
     std::string style;
+    std::string fillcolor;
+    std::string penwidth;
   };
 
   inline std::string const default_fontsize{"12"};
 
   std::string to_string(attributes const& attrs);
   std::string parenthesized(std::string const& n);
+
+  // Attribute values representing the given heat, a fraction between 0 and 1: fill colors
+  // range from white to red, line colors from blue to red, and pen widths from 1 to 5.
+  std::string heat_fillcolor(double heat);
+  std::string heat_color(double heat);
+  std::string heat_penwidth(double heat);
 }
 
 #endif // meld_core_dot_attributes_hpp
@@ -117,9 +117,21 @@ namespace meld::dot {
     edges_.push_back({source_full_name, target_full_name, function_name});
   }
 
-  void data_graph::to_file(std::string const& file_prefix) const
+  void data_graph::annotate(std::string const& function_name, std::string const& note)
   {
-    std::ofstream out{file_prefix + "-data-pre.gv"};
+    auto& notes = notes_[function_name];
+    notes += "\\n";
+    notes += note;
+  }
+
+  void data_graph::heat(std::string const& function_name, double const heat)
+  {
+    heat_.insert_or_assign(function_name, heat);
+  }
+
+  void data_graph::to_file(std::string const& file_prefix, std::string const& stage) const
+  {
+    std::ofstream out{file_prefix + "-data-" + stage + ".gv"};
     prolog(out);
     for (auto const& [source_name, target_name, edge_name] : edges_) {
       if (edge_name == zip_name) {
@@ -129,10 +141,15 @@ namespace meld::dot {
              attributes{.color = "\"#a9a9a9\"", .fontsize = default_fontsize, .style = "dotted"});
       }
       else {
-        edge(out,
-             source_name,
-             target_name,
-             attributes{.color = "blue", .fontsize = default_fontsize, .label = edge_name});
+        attributes attrs{.color = "blue", .fontsize = default_fontsize, .label = edge_name};
+        if (auto it = notes_.find(edge_name); it != notes_.end()) {
+          attrs.label += it->second;
+        }
+        if (auto it = heat_.find(edge_name); it != heat_.end()) {
+          attrs.color = heat_color(it->second);
+          attrs.penwidth = heat_penwidth(it->second);
+        }
+        edge(out, source_name, target_name, attrs);
       }
     }
 
@@ -6,6 +6,7 @@
 #include "meld/model/qualified_name.hpp"
 
 #include <iosfwd>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -15,7 +16,16 @@ namespace meld::dot {
   class data_graph {
   public:
     void add(std::string const& function_name, specified_labels input, qualified_names output);
-    void to_file(std::string const& file_prefix) const;
+
+    // Appends a line to the label of the edge that represents the function
+    void annotate(std::string const& function_name, std::string const& note);
+
+    // Draws the edge that represents the function with the color and width of the heat
+    // (see attributes.hpp)
+    void heat(std::string const& function_name, double heat);
+
+    // Writes the file <file_prefix>-data-<stage>.gv
+    void to_file(std::string const& file_prefix, std::string const& stage = "pre") const;
 
   private:
     struct product_edge {
@@ -29,6 +39,8 @@ namespace meld::dot {
     };
     std::vector<product_edge> edges_;
     std::vector<product_node> nodes_;
+    std::map<std::string, std::string> notes_;
+    std::map<std::string, double> heat_;
   };
 }
 #endif // meld_core_dot_data_graph_hpp
@@ -42,36 +42,74 @@ namespace meld::dot {
     nodes_.push_back({node_name, attrs});
   }
 
-  void function_graph::edge(std::string const& source_node,
-                            std::string const& target_node,
-                            attributes const& attrs)
+  std::size_t function_graph::edge(std::string const& source_node,
+                                   std::string const& target_node,
+                                   attributes const& attrs)
   {
     edges_.push_back({source_node, target_node, attrs});
+    return edges_.size() - 1;
   }
 
-  void function_graph::edges_for(std::string const& source_name,
-                                 std::string const& target_name,
-                                 multiplexer::named_input_ports_t const& target_ports)
+  std::vector<std::size_t> function_graph::edges_for(
+    std::string const& source_name,
+    std::string const& target_name,
+    multiplexer::named_input_ports_t const& target_ports)
   {
+    std::vector<std::size_t> result;
+    result.reserve(target_ports.size());
     for (auto const& head_port : target_ports) {
-      edge(source_name,
-           target_name,
-           {.color = "blue",
-            .fontsize = default_fontsize,
-            .label = parenthesized(head_port.product_label.to_string()),
-            .style = "dashed"});
+      result.push_back(edge(source_name,
+                            target_name,
+                            {.color = "blue",
+                             .fontsize = default_fontsize,
+                             .label = parenthesized(head_port.product_label.to_string()),
+                             .style = "dashed"}));
     }
+    return result;
   }
 
-  void function_graph::to_file(std::string const& file_prefix) const
+  void function_graph::annotate(std::string const& node_name,
+                                std::string const& note,
+                                double const heat)
   {
-    std::ofstream out{file_prefix + "-functions.gv"};
+    node_notes_.insert_or_assign(node_name, heat_note{note, heat});
+  }
+
+  void function_graph::annotate_edge(std::size_t const edge_index,
+                                     std::string const& note,
+                                     double const heat)
+  {
+    edge_notes_.insert_or_assign(edge_index, heat_note{note, heat});
+  }
+
+  void function_graph::to_file(std::string const& file_prefix, std::string const& stage) const
+  {
+    std::ofstream out{file_prefix + "-functions" + (stage.empty() ? "" : "-" + stage) + ".gv"};
     prolog(out);
     for (auto const& [name, attrs] : nodes_) {
-      out_node(out, name, attrs);
+      auto it = node_notes_.find(name);
+      if (it == node_notes_.end()) {
+        out_node(out, name, attrs);
+        continue;
+      }
+      auto annotated = attrs;
+      annotated.label = (attrs.label.empty() ? name : attrs.label) + "\\n" + it->second.note;
+      annotated.style = attrs.style.empty() ? "filled" : "\"" + attrs.style + ",filled\"";
+      annotated.fillcolor = heat_fillcolor(it->second.heat);
+      out_node(out, name, annotated);
     }
-    for (auto const& [source, target, attrs] : edges_) {
-      out_edge(out, source, target, attrs);
+    for (std::size_t i = 0; auto const& [source, target, attrs] : edges_) {
+      auto it = edge_notes_.find(i++);
+      if (it == edge_notes_.end()) {
+        out_edge(out, source, target, attrs);
+        continue;
+      }
+      auto annotated = attrs;
+      annotated.label =
+        attrs.label.empty() ? it->second.note : attrs.label + "\\n" + it->second.note;
+      annotated.color = heat_color(it->second.heat);
+      annotated.penwidth = heat_penwidth(it->second.heat);
+      out_edge(out, source, target, annotated);
     }
     epilog(out);
   }
@@ -4,7 +4,9 @@
 #include "meld/core/dot/attributes.hpp"
 #include "meld/core/multiplexer.hpp"
 
+#include <cstddef>
 #include <iosfwd>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -12,16 +14,35 @@ namespace meld::dot {
   class function_graph {
   public:
     void node(std::string const& node_name, attributes const& attrs);
-    void edge(std::string const& source_node,
-              std::string const& target_node,
-              attributes const& attrs);
-    void edges_for(std::string const& source_name,
-                   std::string const& target_name,
-                   multiplexer::named_input_ports_t const& target_ports);
 
-    void to_file(std::string const& file_prefix) const;
+    // The returned indices identify the edges for 'annotate_edge'.
+    std::size_t edge(std::string const& source_node,
+                     std::string const& target_node,
+                     attributes const& attrs);
+    std::vector<std::size_t> edges_for(std::string const& source_name,
+                                       std::string const& target_name,
+                                       multiplexer::named_input_ports_t const& target_ports);
+
+    // Appends a line to the label of the node and fills the node with the color of the
+    // heat (see attributes.hpp)
+    void annotate(std::string const& node_name, std::string const& note, double heat);
+
+    // Appends a line to the label of the edge and draws it with the color and width of the
+    // heat
+    void annotate_edge(std::size_t edge_index, std::string const& note, double heat);
+
+    // Writes the file <file_prefix>-functions.gv, or <file_prefix>-functions-<stage>.gv if
+    // a stage is specified
+    void to_file(std::string const& file_prefix, std::string const& stage = {}) const;
 
   private:
+    struct heat_note {
+      std::string note;
+      double heat;
+    };
+    std::map<std::string, heat_note> node_notes_;
+    std::map<std::size_t, heat_note> edge_notes_;
+
     struct function_node {
       std::string name;
       attributes attrs;
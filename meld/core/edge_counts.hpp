@@ -0,0 +1,56 @@
+#ifndef meld_core_edge_counts_hpp
+#define meld_core_edge_counts_hpp
+
+// =======================================================================================
+// When DOT files are requested, a message_counter is interposed on each edge of the
+// function graph along which the framework passes messages, so that the post-execution
+// graph can show the number of messages that each consumer received from each producer.
+// Without DOT files, no counters are created and the edges connect the nodes directly.
+// =======================================================================================
+
+#include "meld/core/message.hpp"
+
+#include "oneapi/tbb/flow_graph.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace meld {
+  class message_counter :
+    public tbb::flow::function_node<message, message, tbb::flow::lightweight> {
+    using base = tbb::flow::function_node<message, message, tbb::flow::lightweight>;
+
+  public:
+    explicit message_counter(tbb::flow::graph& g) :
+      base{g, tbb::flow::unlimited, [this](message const& msg) {
+             if (not msg.store->is_flush()) {
+               count_.fetch_add(1, std::memory_order_relaxed);
+             }
+             return msg;
+           }}
+    {
+    }
+
+    // Flush messages are not counted.
+    std::size_t count() const noexcept { return count_.load(); }
+
+  private:
+    std::atomic<std::size_t> count_{};
+  };
+
+  struct counted_edge {
+    std::size_t index; // Of the edge in the function graph
+    std::string source;
+    message_counter const* counter; // Null for the results sent by predicates
+  };
+
+  struct edge_counts {
+    std::vector<std::unique_ptr<message_counter>> counters;
+    std::vector<counted_edge> edges;
+  };
+}
+
+#endif // meld_core_edge_counts_hpp
@@ -0,0 +1,36 @@
+#include "meld/core/edge_maker.hpp"
+
+#include <algorithm>
+
+namespace meld {
+  std::string edge_maker::resolved_name(std::map<algorithm_name, std::string> const& names,
+                                        std::string const& spec)
+  {
+    algorithm_name const name{spec};
+    if (auto it = names.find(name); it != cend(names)) {
+      return it->second;
+    }
+    auto it = std::ranges::find_if(
+      names, [&name](auto const& entry) { return entry.first.match(name); });
+    return it != cend(names) ? it->second : spec;
+  }
+
+  message_counter& edge_maker::counter_to(tbb::flow::receiver<message>& receiver)
+  {
+    auto& counter = *edge_counts_.counters.emplace_back(std::make_unique<message_counter>(graph_));
+    make_edge(counter, receiver);
+    return counter;
+  }
+
+  void edge_maker::edges_for(std::string const& source_name,
+                             std::string const& target_name,
+                             multiplexer::named_input_ports_t const& target_ports)
+  {
+    auto const indices = function_graph_->edges_for(source_name, target_name, target_ports);
+    for (std::size_t i = 0; i != indices.size(); ++i) {
+      // Each head port is the counter interposed in front of the consumer's port.
+      auto const* counter = dynamic_cast<message_counter const*>(target_ports[i].port);
+      edge_counts_.edges.push_back({indices[i], source_name, counter});
+    }
+  }
+}
@@ -2,18 +2,24 @@
 #define meld_core_edge_maker_hpp
 
 #include "meld/core/declared_output.hpp"
+#include "meld/core/declared_transform.hpp"
 #include "meld/core/declared_unfold.hpp"
 #include "meld/core/dot/attributes.hpp"
 #include "meld/core/dot/data_graph.hpp"
 #include "meld/core/dot/function_graph.hpp"
+#include "meld/core/edge_counts.hpp"
 #include "meld/core/edge_creation_policy.hpp"
 #include "meld/core/filter.hpp"
 #include "meld/core/multiplexer.hpp"
 
 #include "oneapi/tbb/flow_graph.h"
+#include "spdlog/spdlog.h"
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <set>
 #include <string>
@@ -44,8 +50,10 @@ namespace meld {
 
   class edge_maker {
   public:
+    // If a file prefix is specified, the messages passed along each edge are counted (see
+    // edge_counts.hpp).
     template <typename... Args>
-    edge_maker(std::string const& file_prefix, Args&... args);
+    edge_maker(tbb::flow::graph& g, std::string const& file_prefix, Args&... args);
 
     template <typename... Args>
     void operator()(tbb::flow::input_node<message>& source,
@@ -54,18 +62,66 @@ namespace meld {
                     declared_outputs& outputs,
                     consumers<Args>... cons);
 
+    // For demand-driven execution: each transform whose products are consumed only by
+    // nodes guarded by predicates inherits the predicates common to all of its consumers.
+    // The transform is then invoked only for messages that some consumer will accept.
+    template <typename... Args>
+    void defer_to_predicates(declared_transforms& transforms, Args const&... nodes);
+
+    // The nodes on which each node directly depends: the producers of its inputs and its
+    // predicates.  Nodes that consume only products provided by the source have none.
+    template <typename... Args>
+    std::map<std::string, std::set<std::string>> upstream_nodes(Args const&... nodes) const;
+
     auto release_data_graph() { return std::move(data_graph_); }
     auto release_function_graph() { return std::move(function_graph_); }
+    auto release_edge_counts() { return std::move(edge_counts_); }
 
   private:
+    // The producer records hold parsed algorithm names, which do not necessarily
+    // round-trip to the names under which the nodes are registered.
+    template <typename... Args>
+    static std::map<algorithm_name, std::string> registered_names(Args const&... nodes);
+
+    // Predicates may be specified without their module labels; the name under which the
+    // predicate is registered is returned (or the specified name if no node matches).
+    static std::string resolved_name(std::map<algorithm_name, std::string> const& names,
+                                     std::string const& spec);
+
     template <typename T>
     void record_attributes(T& consumers);
 
     template <typename T>
     multiplexer::head_ports_t edges(std::map<std::string, filter>& filters, T& consumers);
 
+    // Returns the counter to which the sender of a counted edge is to be connected
+    message_counter& counter_to(tbb::flow::receiver<message>& receiver);
+
+    template <typename Sender>
+    void connect(Sender& sender,
+                 tbb::flow::receiver<message>& receiver,
+                 std::string const& source_name,
+                 std::string const& target_name,
+                 dot::attributes const& attrs)
+    {
+      if (not function_graph_) {
+        make_edge(sender, receiver);
+        return;
+      }
+      auto const index = function_graph_->edge(source_name, target_name, attrs);
+      auto& counter = counter_to(receiver);
+      make_edge(sender, counter);
+      edge_counts_.edges.push_back({index, source_name, &counter});
+    }
+
+    void edges_for(std::string const& source_name,
+                   std::string const& target_name,
+                   multiplexer::named_input_ports_t const& target_ports);
+
+    tbb::flow::graph& graph_;
     std::unique_ptr<dot::function_graph> function_graph_;
     std::unique_ptr<dot::data_graph> data_graph_;
+    edge_counts edge_counts_;
 
     edge_creation_policy producers_;
     std::map<std::string, dot::attributes> attributes_;
@@ -80,7 +136,8 @@ namespace meld {
       auto const& node_name = node->full_name();
       function_graph_->node(node_name, node_attributes);
       for (auto const& predicate_name : node->when()) {
-        function_graph_->edge(predicate_name, node_name, {.color = "red"});
+        auto const index = function_graph_->edge(predicate_name, node_name, {.color = "red"});
+        edge_counts_.edges.push_back({index, predicate_name, nullptr});
       }
 
       if constexpr (supports_output<decltype(node)>) {
@@ -96,27 +153,160 @@ namespace meld {
                        std::string const& receiver_node_name,
                        std::string const& product_name)
     {
-      make_edge(*sender.port, receiver);
-      if (function_graph_) {
-        function_graph_->edge(sender.node.full(),
-                              receiver_node_name,
-                              {.color = "blue",
-                               .fontsize = dot::default_fontsize,
-                               .label = dot::parenthesized(product_name)});
-      }
+      connect(*sender.port,
+              receiver,
+              sender.node.full(),
+              receiver_node_name,
+              {.color = "blue",
+               .fontsize = dot::default_fontsize,
+               .label = dot::parenthesized(product_name)});
     }
   };
 
   // =============================================================================
   // Implementation
   template <typename... Args>
-  edge_maker::edge_maker(std::string const& file_prefix, Args&... producers) :
+  edge_maker::edge_maker(tbb::flow::graph& g, std::string const& file_prefix, Args&... producers) :
+    graph_{g},
     function_graph_{file_prefix.empty() ? nullptr : std::make_unique<dot::function_graph>()},
     data_graph_{file_prefix.empty() ? nullptr : std::make_unique<dot::data_graph>()},
     producers_{producers...}
   {
   }
 
+  template <typename... Args>
+  void edge_maker::defer_to_predicates(declared_transforms& transforms, Args const&... nodes)
+  {
+    // Nodes on which each node directly depends (producers of its inputs and its
+    // predicates), and the direct consumers of each produced product.
+    std::map<std::string, std::set<std::string>> upstream;
+    std::map<std::string, std::vector<std::string>> downstream;
+    std::map<std::string, std::set<std::string>> guards;
+
+    auto const names = registered_names(nodes...);
+    auto record_dependencies = [&](auto const& node_map) {
+      for (auto const& [node_name, node] : node_map) {
+        auto const& predicates = node->when();
+        guards[node_name].insert(begin(predicates), end(predicates));
+        for (auto const& predicate_name : predicates) {
+          upstream[node_name].insert(resolved_name(names, predicate_name));
+        }
+        for (auto const& product_label : node->input()) {
+          auto producer = producers_.find_producer(product_label.name);
+          if (not producer) {
+            continue;
+          }
+          auto const& producer_name = names.at(producer->node);
+          upstream[node_name].insert(producer_name);
+          downstream[producer_name].push_back(node_name);
+        }
+      }
+    };
+    (record_dependencies(nodes), ...);
+
+    // A transform may not wait on a predicate that (directly or indirectly) needs the
+    // transform's products--doing so would starve the predicate.
+    auto depends_on = [&upstream](std::string const& node_name, std::string const& target) {
+      std::set<std::string> visited;
+      std::vector<std::string> pending{node_name};
+      while (not empty(pending)) {
+        auto current = std::move(pending.back());
+        pending.pop_back();
+        if (current == target) {
+          return true;
+        }
+        if (not visited.insert(current).second) {
+          continue;
+        }
+        if (auto it = upstream.find(current); it != cend(upstream)) {
+          pending.insert(end(pending), begin(it->second), end(it->second));
+        }
+      }
+      return false;
+    };
+
+    // Predicates inherited by a transform may allow its own producers to be deferred, so
+    // iterate until the full dependency cone has been processed.
+    std::map<std::string, std::vector<std::string>> deferred;
+    bool changed{true};
+    while (changed) {
+      changed = false;
+      for (auto const& transform_name : transforms | std::views::keys) {
+        auto it = downstream.find(transform_name);
+        if (it == cend(downstream)) {
+          // Products not consumed by any node are presumably meant for output.
+          continue;
+        }
+
+        std::optional<std::set<std::string>> common;
+        for (auto const& consumer_name : it->second) {
+          auto const& guard = guards[consumer_name];
+          if (not common) {
+            common = guard;
+            continue;
+          }
+          std::set<std::string> intersection;
+          std::ranges::set_intersection(
+            *common, guard, std::inserter(intersection, begin(intersection)));
+          common = std::move(intersection);
+        }
+
+        for (auto const& predicate_name : *common) {
+          if (guards[transform_name].contains(predicate_name) or
+              depends_on(resolved_name(names, predicate_name), transform_name)) {
+            continue;
+          }
+          guards[transform_name].insert(predicate_name);
+          upstream[transform_name].insert(resolved_name(names, predicate_name));
+          deferred[transform_name].push_back(predicate_name);
+          changed = true;
+        }
+      }
+    }
+
+    for (auto const& [transform_name, predicates] : deferred) {
+      spdlog::debug("Transform {} will execute only when {} succeed.",
+                    transform_name,
+                    fmt::join(predicates, ", "));
+      transforms.at(transform_name)->add_predicates(predicates);
+    }
+  }
+
+  template <typename... Args>
+  std::map<algorithm_name, std::string> edge_maker::registered_names(Args const&... nodes)
+  {
+    std::map<algorithm_name, std::string> result;
+    auto record_names = [&result](auto const& node_map) {
+      for (auto const& node_name : node_map | std::views::keys) {
+        result.try_emplace(algorithm_name{node_name}, node_name);
+      }
+    };
+    (record_names(nodes), ...);
+    return result;
+  }
+
+  template <typename... Args>
+  std::map<std::string, std::set<std::string>> edge_maker::upstream_nodes(
+    Args const&... nodes) const
+  {
+    auto const names = registered_names(nodes...);
+    std::map<std::string, std::set<std::string>> result;
+    auto record_dependencies = [&](auto const& node_map) {
+      for (auto const& [node_name, node] : node_map) {
+        for (auto const& predicate_name : node->when()) {
+          result[node_name].insert(resolved_name(names, predicate_name));
+        }
+        for (auto const& product_label : node->input()) {
+          if (auto producer = producers_.find_producer(product_label.name)) {
+            result[node_name].insert(names.at(producer->node));
+          }
+        }
+      }
+    };
+    (record_dependencies(nodes), ...);
+    return result;
+  }
+
   template <typename T>
   void edge_maker::record_attributes(T& consumers)
   {
@@ -144,6 +334,9 @@ namespace meld {
         auto producer = producers_.find_producer(product_label.name);
         if (not producer) {
           // Is there a way to detect mis-specified product dependencies?
+          if (function_graph_) {
+            receiver_port = &counter_to(*receiver_port);
+          }
           result[node_name].push_back({product_label, receiver_port});
           continue;
         }
@@ -169,22 +362,20 @@ namespace meld {
     auto& unfolds = std::get<consumers<declared_unfolds>&>(std::tie(cons...));
 
     for (auto const& [output_name, output_node] : outputs) {
-      make_edge(source, output_node->port());
       if (function_graph_) {
         function_graph_->node(output_name, {.shape = "cylinder"});
-        function_graph_->edge("Source", output_name, {.color = "gray"});
       }
+      connect(source, output_node->port(), "Source", output_name, {.color = "gray"});
       for (auto const& named_port : producers_.values()) {
-        make_edge(*named_port.to_output, output_node->port());
-        if (function_graph_) {
-          function_graph_->edge(named_port.node.full(), output_name, {.color = "gray"});
-        }
+        connect(*named_port.to_output,
+                output_node->port(),
+                named_port.node.full(),
+                output_name,
+                {.color = "gray"});
       }
       for (auto const& [unfold_name, unfold] : unfolds.data) {
-        make_edge(unfold->to_output(), output_node->port());
-        if (function_graph_) {
-          function_graph_->edge(unfold_name, output_name, {.color = "gray"});
-        }
+        connect(
+          unfold->to_output(), output_node->port(), unfold_name, output_name, {.color = "gray"});
       }
     }
 
@@ -235,12 +426,12 @@ namespace meld {
     if (function_graph_) {
       for (auto const& [name, unfold] : unfolds.data) {
         for (auto const& [node_name, ports] : unfold->downstream_ports()) {
-          function_graph_->edges_for(name, node_name, ports);
+          edges_for(name, node_name, ports);
         }
       }
 
       for (auto const& [node_name, ports] : multi.downstream_ports()) {
-        function_graph_->edges_for("Source", node_name, ports);
+        edges_for("Source", node_name, ports);
       }
     }
   }
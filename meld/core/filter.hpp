@@ -26,6 +26,11 @@ namespace meld {
     auto& data_port() { return input_port<0>(*this); }
     auto& predicate_port() { return input_port<1>(*this); }
 
+    // The numbers of messages awaiting their predicate decisions, and of decisions
+    // awaiting their messages
+    std::size_t pending_data() const { return data_.size(); }
+    std::size_t pending_decisions() const { return decisions_.size(); }
+
   private:
     oneapi::tbb::flow::continue_msg execute(tag_t const& tag);
 
@@ -2,13 +2,19 @@
 
 #include "meld/concurrency.hpp"
 #include "meld/core/edge_maker.hpp"
+#include "meld/model/algorithm_name.hpp"
 #include "meld/model/level_counter.hpp"
+#include "meld/model/product_memory.hpp"
 #include "meld/model/product_store.hpp"
 
 #include "spdlog/cfg/env.h"
+#include "spdlog/spdlog.h"
 
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
 #include <iostream>
+#include <ranges>
 
 namespace meld {
   level_sentry::level_sentry(flush_counters& counters,
@@ -41,16 +47,26 @@ namespace meld {
   framework_graph::framework_graph(detail::next_store_t next_store, int const max_parallelism) :
     parallelism_limit_{static_cast<std::size_t>(max_parallelism)},
     driver_{std::move(next_store)},
+    readahead_{[this] { return pull_store(); }, 2ull * static_cast<std::size_t>(max_parallelism)},
     src_{graph_,
          [this](tbb::flow_control& fc) mutable -> message {
-           auto item = driver_();
-           if (not item) {
+           // Backpressure from buffered outputs: the source stops while any output buffer
+           // is full, and is re-activated once the buffer has room (see resume_source).
+           if (throttle()) {
+             fc.stop();
+             return {};
+           }
+           auto store = read_store();
+           if (not store) {
              drain();
              fc.stop();
              return {};
            }
-           auto store = *item;
-           assert(not store->is_flush());
+           if (checkpoint_due(store)) {
+             pause_for_checkpoint(std::move(store));
+             fc.stop();
+             return {};
+           }
            return sender_.make_message(accept(std::move(store)));
          }},
     multiplexer_{graph_}
@@ -74,53 +90,341 @@ namespace meld {
 
   framework_graph::~framework_graph() = default;
 
+  namespace {
+    bool creates_products(std::string_view const kind)
+    {
+      return kind == "fold" or kind == "unfold" or kind == "transform";
+    }
+  }
+
   std::size_t framework_graph::execution_counts(std::string const& node_name) const
   {
-    // FIXME: Yuck!
-    if (auto it = nodes_.predicates_.find(node_name); it != nodes_.predicates_.end()) {
-      return it->second->num_calls();
-    }
-    if (auto it = nodes_.observers_.find(node_name); it != nodes_.observers_.end()) {
-      return it->second->num_calls();
-    }
-    if (auto it = nodes_.folds_.find(node_name); it != nodes_.folds_.end()) {
-      return it->second->num_calls();
+    // Outputs are not algorithms and are therefore not reported.
+    auto const* node = nodes_.find(node_name);
+    if (not node or std::string_view{nodes_.kind_of(node->id())} == "output") {
+      return -1u;
     }
-    if (auto it = nodes_.unfolds_.find(node_name); it != nodes_.unfolds_.end()) {
-      return it->second->num_calls();
-    }
-    if (auto it = nodes_.transforms_.find(node_name); it != nodes_.transforms_.end()) {
-      return it->second->num_calls();
-    }
-    return -1u;
+    return node->statistics().calls();
   }
 
   std::size_t framework_graph::product_counts(std::string const& node_name) const
   {
-    // FIXME: Yuck!
-    if (auto it = nodes_.folds_.find(node_name); it != nodes_.folds_.end()) {
-      return it->second->product_count();
-    }
-    if (auto it = nodes_.unfolds_.find(node_name); it != nodes_.unfolds_.end()) {
-      return it->second->product_count();
-    }
-    if (auto it = nodes_.transforms_.find(node_name); it != nodes_.transforms_.end()) {
-      return it->second->product_count();
+    auto const* node = nodes_.find(node_name);
+    if (not node or not creates_products(nodes_.kind_of(node->id()))) {
+      return -1u;
     }
-    return -1u;
+    return node->statistics().products();
   }
 
   void framework_graph::execute(std::string const& dot_file_prefix)
   {
     finalize(dot_file_prefix);
+    if (checkpoints_ and checkpoints_->resume) {
+      restore_checkpoint();
+    }
     run();
-    // post_data_graph(dot_file_prefix);
+    post_execution_graphs(dot_file_prefix);
+  }
+
+  void framework_graph::declare_resource(std::string const& name, std::size_t const capacity)
+  {
+    if (capacity == 0ull) {
+      throw std::runtime_error("The capacity of resource '" + name + "' must be at least 1.");
+    }
+    nodes_.resource(graph_, name).set_capacity(capacity);
   }
 
   void framework_graph::run()
   {
+    nodes_.activate_resources();
+    if (trace_) {
+      nodes_.enable_tracing(*trace_);
+    }
+    if (perf_) {
+      nodes_.enable_perf_counters(*perf_);
+    }
+    if (allocation_profiling_) {
+      nodes_.enable_allocation_profiling();
+    }
+    std::unique_ptr<progress_reporter> progress;
+    if (progress_) {
+      progress =
+        std::make_unique<progress_reporter>(*progress_, [this] { return sample_progress(); });
+    }
+    if (backlog_interval_) {
+      backlogs_ =
+        std::make_unique<backlog_monitor>(*backlog_interval_, [this] { return sample_backlogs(); });
+    }
+    for (auto& output : nodes_.outputs_ | std::views::values) {
+      output->on_capacity([this] { resume_source(); });
+    }
+    auto const begin = std::chrono::steady_clock::now();
     src_.activate();
     graph_.wait_for_all();
+
+    // The source is paused at each checkpoint boundary; the graph is then idle, and
+    // processing resumes once the checkpoint has been saved.  A source stopped by a full
+    // output buffer is normally re-activated by the buffer's writer; if the graph became
+    // idle first, it is re-activated here.
+    while (paused_store_ or std::exchange(throttled_, false)) {
+      if (paused_store_) {
+        save_checkpoint();
+      }
+      src_.activate();
+      graph_.wait_for_all();
+    }
+    elapsed_time_ =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    graph_resource_usage_.sample();
+    // Writes the final progress report
+    progress.reset();
+    if (backlogs_) {
+      backlogs_->stop();
+    }
+
+    for (auto& output : nodes_.outputs_ | std::views::values) {
+      output->rethrow_if_failed();
+    }
+    for (auto const& report : post_run_reports_) {
+      report();
+    }
+    if (checkpoints_) {
+      // The job is complete, so there is nothing to resume.
+      std::filesystem::remove(checkpoints_->file);
+    }
+  }
+
+  void framework_graph::add_post_run_report(std::function<void()> report)
+  {
+    post_run_reports_.push_back(std::move(report));
+  }
+
+  void framework_graph::log_cache_statistics() const
+  {
+    for (auto const& [name, transform] : nodes_.transforms_) {
+      if (auto const counts = transform->cache_statistics()) {
+        spdlog::info(
+          "Transform cache for {}: {} hits, {} misses", name, counts->hits, counts->misses);
+      }
+    }
+  }
+
+  void framework_graph::log_product_memory() const
+  {
+    for (auto const& [name, usage] : product_memory_->node_usage()) {
+      spdlog::info("Product memory of node {}: {:.3f} MB peak, {:.3f} MB live",
+                   name,
+                   usage.peak / 1e6,
+                   usage.live / 1e6);
+    }
+    for (auto const& [name, usage] : product_memory_->level_usage()) {
+      spdlog::info("Product memory of level {}: {:.3f} MB peak, {:.3f} MB live",
+                   name,
+                   usage.peak / 1e6,
+                   usage.live / 1e6);
+    }
+  }
+
+  void framework_graph::log_allocations() const
+  {
+    for (auto const& counts : nodes_.counts()) {
+      if (counts.calls == 0ull) {
+        continue;
+      }
+      spdlog::info("Allocations of node {}: {:.1f} per call, {:.1f} bytes per call",
+                   counts.name,
+                   static_cast<double>(counts.allocations) / counts.calls,
+                   static_cast<double>(counts.allocated_bytes) / counts.calls);
+    }
+  }
+
+  void framework_graph::log_backlog_marks() const
+  {
+    for (auto const& [name, mark] : backlog_high_water_marks()) {
+      if (mark.high_water == 0ull) {
+        continue;
+      }
+      spdlog::info(
+        "Backlog of {}: high-water mark {} at {:.3f}s", name, mark.high_water, mark.reached_at);
+    }
+  }
+
+  void framework_graph::write_trace() const
+  {
+    trace_->write(trace_file_);
+    spdlog::info("Trace written to {}", trace_file_);
+    if (auto const n = trace_->overwritten_events()) {
+      spdlog::warn("The oldest {} trace events were overwritten.", n);
+    }
+  }
+
+  bottleneck_report framework_graph::bottlenecks() const
+  {
+    std::vector<node_profile> profiles;
+    for (auto const& [name, kind, queue_wait, execution_time, _] : nodes_.timings()) {
+      auto const* node = nodes_.find(name);
+      node_profile profile{.name = name,
+                           .kind = kind,
+                           .concurrency = node ? node->concurrency() : 0ull,
+                           .calls = execution_time.count(),
+                           .execution_time = execution_time.sum(),
+                           .queue_wait = queue_wait.sum(),
+                           .upstream = {}};
+      if (auto it = upstream_nodes_.find(name); it != upstream_nodes_.end()) {
+        profile.upstream.assign(begin(it->second), end(it->second));
+      }
+      profiles.push_back(std::move(profile));
+    }
+    return analyze_bottlenecks(
+      profiles, concurrency::max_allowed_parallelism::active_value(), elapsed_time_);
+  }
+
+  void framework_graph::enable_bottleneck_report()
+  {
+    if (not bottleneck_report_) {
+      add_post_run_report([this] { log_bottleneck_report(bottlenecks()); });
+    }
+    bottleneck_report_ = true;
+  }
+
+  void framework_graph::set_transform_cache(std::filesystem::path directory)
+  {
+    if (not nodes_.transform_cache_.enabled()) {
+      add_post_run_report([this] { log_cache_statistics(); });
+    }
+    nodes_.transform_cache_.set_directory(std::move(directory));
+  }
+
+  void framework_graph::set_timing_report(std::string filename)
+  {
+    if (timing_report_.empty()) {
+      add_post_run_report([this] {
+        write_timing_report(timing_report_, nodes_.timings());
+        spdlog::info("Node timing report written to {}", timing_report_);
+      });
+    }
+    timing_report_ = std::move(filename);
+  }
+
+  void framework_graph::enable_tracing(std::string filename, std::size_t const events_per_thread)
+  {
+    if (filename.empty()) {
+      throw std::runtime_error("A trace file must be specified.");
+    }
+    if (not trace_) {
+      add_post_run_report([this] { write_trace(); });
+    }
+    trace_file_ = std::move(filename);
+    trace_ = std::make_unique<trace_recorder>(events_per_thread);
+  }
+
+  void framework_graph::enable_perf_counters()
+  {
+    perf_ = std::make_unique<perf_counters>();
+  }
+
+  void framework_graph::enable_allocation_profiling()
+  {
+    if (not allocations_interposed()) {
+      spdlog::warn("Allocations will not be counted: meld was built without "
+                   "ENABLE_ALLOCATION_PROFILING.");
+    }
+    if (not allocation_profiling_) {
+      add_post_run_report([this] { log_allocations(); });
+    }
+    allocation_profiling_ = true;
+  }
+
+  void framework_graph::enable_memory_accounting()
+  {
+    if (not product_memory_) {
+      add_post_run_report([this] { log_product_memory(); });
+      product_memory_ = std::make_shared<product_memory>();
+    }
+  }
+
+  std::optional<product_store_ptr> framework_graph::pull_store()
+  {
+    auto store = driver_();
+    if (product_memory_ and store and *store and not(*store)->parent()) {
+      (*store)->account_memory_in(product_memory_);
+    }
+    return store;
+  }
+
+  void framework_graph::enable_progress_reports(progress_options options)
+  {
+    if (options.file.empty()) {
+      throw std::runtime_error("A progress file must be specified.");
+    }
+    progress_ = std::move(options);
+  }
+
+  progress_sample framework_graph::sample_progress() const
+  {
+    progress_sample result{};
+    result.processed_stores = hierarchy_.counts();
+    std::size_t processed{};
+    for (auto const count : result.processed_stores | std::views::values) {
+      processed += count;
+    }
+    auto const accepted = accepted_stores_.load();
+    result.in_flight_stores = accepted > processed ? accepted - processed : 0ull;
+    for (auto const& counts : nodes_.counts()) {
+      if (counts.kind != "output") {
+        result.nodes.push_back({counts.name, nodes_.kind_of(counts.id), counts.calls});
+      }
+    }
+    result.queue_depths = sample_backlogs();
+    result.rss_bytes = current_rss();
+    return result;
+  }
+
+  void framework_graph::enable_backlog_sampling(std::chrono::milliseconds const interval)
+  {
+    if (interval.count() <= 0) {
+      throw std::runtime_error("The backlog-sampling interval must be positive.");
+    }
+    if (not backlog_interval_) {
+      add_post_run_report([this] { log_backlog_marks(); });
+    }
+    backlog_interval_ = interval;
+  }
+
+  std::map<std::string, backlog_mark> framework_graph::backlog_high_water_marks() const
+  {
+    return backlogs_ ? backlogs_->marks() : std::map<std::string, backlog_mark>{};
+  }
+
+  std::map<std::string, std::size_t> framework_graph::sample_backlogs() const
+  {
+    std::map<std::string, std::size_t> result;
+    nodes_.for_each_node([&result](std::string const& name, char const*, auto const& node) {
+      if constexpr (requires { node.backlog(); }) {
+        for (auto const& [buffer, depth] : node.backlog()) {
+          result.emplace(name + '/' + buffer, depth);
+        }
+      }
+    });
+    for (auto const& [name, filter] : filters_) {
+      result.emplace("filter:" + name + "/data", filter.pending_data());
+      result.emplace("filter:" + name + "/decisions", filter.pending_decisions());
+    }
+    for (auto const& [name, output] : nodes_.outputs_) {
+      result.emplace("output:" + name, output->buffered_stores());
+    }
+    return result;
+  }
+
+  void framework_graph::enable_checkpoints(checkpoint_options options)
+  {
+    if (options.file.empty()) {
+      throw std::runtime_error("A checkpoint file must be specified.");
+    }
+    if (options.interval == 0ull) {
+      throw std::runtime_error("The checkpoint interval must be at least 1.");
+    }
+    checkpoints_ = std::move(options);
   }
 
   namespace {
@@ -139,6 +443,13 @@ namespace meld {
         auto [it, success] = result.try_emplace(name, g, *consumer);
         for (auto const& predicate_name : predicates) {
           auto fit = all_predicates.find(predicate_name);
+          if (fit == cend(all_predicates)) {
+            // The module label of the predicate may be omitted
+            algorithm_name const spec{predicate_name};
+            fit = std::ranges::find_if(all_predicates, [&spec](auto const& entry) {
+              return algorithm_name{entry.first}.match(spec);
+            });
+          }
           if (fit == cend(all_predicates)) {
             throw std::runtime_error("A non-existent filter with the name '" + predicate_name +
                                      "' was specified for " + name);
@@ -152,6 +463,16 @@ namespace meld {
 
   void framework_graph::finalize(std::string const& dot_file_prefix)
   {
+    if (checkpoints_) {
+      // Otherwise, the job would fail only once the first checkpoint is reached.
+      for (auto const& [name, fold] : nodes_.folds_) {
+        if (not fold->can_save_state()) {
+          registration_errors_.push_back(
+            fmt::format("The partial results of fold '{}' cannot be saved at checkpoints.", name));
+        }
+      }
+    }
+
     if (not empty(registration_errors_)) {
       std::string error_msg{"\nConfiguration errors:\n"};
       for (auto const& error : registration_errors_) {
@@ -160,6 +481,23 @@ namespace meld {
       throw std::runtime_error(error_msg);
     }
 
+    edge_maker make_edges{graph_, dot_file_prefix, nodes_.transforms_, nodes_.folds_};
+    if (mode_ == execution_mode::demand_driven) {
+      make_edges.defer_to_predicates(nodes_.transforms_,
+                                     nodes_.predicates_,
+                                     nodes_.observers_,
+                                     nodes_.folds_,
+                                     nodes_.unfolds_,
+                                     nodes_.transforms_);
+    }
+
+    nodes_.assign_ids();
+    upstream_nodes_ = make_edges.upstream_nodes(nodes_.predicates_,
+                                                nodes_.observers_,
+                                                nodes_.folds_,
+                                                nodes_.unfolds_,
+                                                nodes_.transforms_);
+
     filters_.merge(internal_edges_for_predicates(graph_, nodes_.predicates_, nodes_.predicates_));
     filters_.merge(internal_edges_for_predicates(graph_, nodes_.predicates_, nodes_.observers_));
     filters_.merge(internal_edges_for_predicates(graph_, nodes_.predicates_, nodes_.outputs_));
@@ -167,7 +505,6 @@ namespace meld {
     filters_.merge(internal_edges_for_predicates(graph_, nodes_.predicates_, nodes_.unfolds_));
     filters_.merge(internal_edges_for_predicates(graph_, nodes_.predicates_, nodes_.transforms_));
 
-    edge_maker make_edges{dot_file_prefix, nodes_.transforms_, nodes_.folds_};
     make_edges(src_,
                multiplexer_,
                filters_,
@@ -180,10 +517,209 @@ namespace meld {
 
     if (auto data_graph = make_edges.release_data_graph()) {
       data_graph->to_file(dot_file_prefix);
+      data_graph_ = std::move(data_graph);
     }
     if (auto function_graph = make_edges.release_function_graph()) {
       function_graph->to_file(dot_file_prefix);
+      function_graph_ = std::move(function_graph);
+    }
+    edge_counts_ = make_edges.release_edge_counts();
+  }
+
+  void framework_graph::post_execution_graphs(std::string const& dot_file_prefix)
+  {
+    if (not function_graph_ or not data_graph_) {
+      return;
+    }
+
+    std::map<std::string, memory_usage> memory;
+    if (product_memory_) {
+      memory = product_memory_->node_usage();
+    }
+
+    // Messages sent by each node: the products of transforms, folds, and unfolds, and the
+    // results of predicates
+    std::map<std::string, std::size_t> messages{{"Source", accepted_stores_.load()}};
+    for (auto const& counts : nodes_.counts()) {
+      if (creates_products(counts.kind)) {
+        messages.emplace(counts.name, counts.products);
+      }
+      else if (counts.kind == "predicate") {
+        messages.emplace(counts.name, counts.calls);
+      }
+    }
+
+    auto const timings = nodes_.timings();
+    std::uint64_t max_time{1};
+    for (auto const& timing : timings) {
+      max_time = std::max(max_time, timing.execution_time.sum());
+    }
+    for (auto const& [name, kind, queue_wait, execution_time, _] : timings) {
+      auto const heat = static_cast<double>(execution_time.sum()) / max_time;
+      auto const note = fmt::format(
+        "{} calls, {:.3f} ms", execution_time.count(), execution_time.sum() / 1e6);
+      function_graph_->annotate(name, note, heat);
+      data_graph_->annotate(name, note);
+      data_graph_->heat(name, heat);
+    }
+
+    // The messages along each edge are counted, except for the results of predicates,
+    // which are sent along every edge leaving the predicate.  The bytes along an edge are
+    // estimated from the average size of the products of the sending node.
+    struct edge_load {
+      std::size_t index;
+      std::size_t messages;
+      std::optional<double> bytes;
+    };
+    std::vector<edge_load> loads;
+    std::size_t max_messages{1};
+    double max_bytes{1.};
+    for (auto const& [index, source, counter] : edge_counts_.edges) {
+      auto const count = counter ? counter->count() : messages[source];
+      std::optional<double> bytes;
+      // The products provided by the source are accounted for as those of "[source]".
+      auto const sent = messages[source];
+      if (auto it = memory.find(source == "Source" ? "[source]" : source);
+          it != memory.end() and sent != 0ull) {
+        bytes = static_cast<double>(it->second.total) / sent * count;
+        max_bytes = std::max(max_bytes, *bytes);
+      }
+      max_messages = std::max(max_messages, count);
+      loads.push_back({index, count, bytes});
+    }
+    for (auto const& [index, count, bytes] : loads) {
+      auto note = fmt::format("{} messages", count);
+      auto heat = static_cast<double>(count) / max_messages;
+      if (bytes) {
+        note += fmt::format(", {:.3f} MB", *bytes / 1e6);
+        heat = *bytes / max_bytes;
+      }
+      function_graph_->annotate_edge(index, note, heat);
+    }
+    for (auto const& [name, usage] : memory) {
+      data_graph_->annotate(
+        name, fmt::format("peak {:.3f} MB, total {:.3f} MB", usage.peak / 1e6, usage.total / 1e6));
+    }
+
+    function_graph_->to_file(dot_file_prefix, "post");
+    data_graph_->to_file(dot_file_prefix, "post");
+  }
+
+  bool framework_graph::outputs_full() const
+  {
+    return std::ranges::any_of(nodes_.outputs_ | std::views::values,
+                               [](auto const& output) { return output->full(); });
+  }
+
+  bool framework_graph::throttle()
+  {
+    std::lock_guard lock{throttle_mutex_};
+    throttled_ = outputs_full();
+    return throttled_;
+  }
+
+  void framework_graph::resume_source()
+  {
+    {
+      std::lock_guard lock{throttle_mutex_};
+      if (not throttled_ or outputs_full()) {
+        return;
+      }
+      throttled_ = false;
+    }
+    // Activating the source outside of the lock: the source's body (which runs while the
+    // node's own lock is held) acquires the throttle lock.
+    src_.activate();
+  }
+
+  product_store_ptr framework_graph::read_store()
+  {
+    if (paused_store_) {
+      return std::exchange(paused_store_, nullptr);
+    }
+
+    while (auto item = readahead_()) {
+      auto store = std::move(*item);
+      assert(not store->is_flush());
+      auto const depth = store->id()->depth();
+      if (depth == 1ull) {
+        ++top_levels_;
+      }
+      // Stores belonging to top-level stores completed before resuming are not processed.
+      if (depth > 0ull and top_levels_ <= resumed_levels_) {
+        continue;
+      }
+      return store;
+    }
+    return nullptr;
+  }
+
+  bool framework_graph::checkpoint_due(product_store_ptr const& store) const
+  {
+    if (not checkpoints_ or store->id()->depth() != 1ull) {
+      return false;
+    }
+    auto const completed_levels = top_levels_ - 1;
+    return completed_levels - checkpointed_levels_ >= checkpoints_->interval;
+  }
+
+  void framework_graph::pause_for_checkpoint(product_store_ptr store)
+  {
+    // Closing the completed top-level store sends its flush message so that all folds
+    // partitioned at or below that level are committed before the graph becomes idle.
+    while (not empty(levels_) and levels_.top().depth() > 0ull) {
+      levels_.pop();
+      eoms_.pop();
+    }
+    paused_store_ = std::move(store);
+  }
+
+  void framework_graph::save_checkpoint()
+  {
+    checkpoint_state state{.completed_levels = top_levels_ - 1};
+    for (auto const& [name, fold] : nodes_.folds_) {
+      if (auto fold_state = fold->save_state(); not fold_state.empty()) {
+        state.folds.emplace(name, std::move(fold_state));
+      }
+    }
+    for (auto const& [name, object] : nodes_.checkpointed_) {
+      state.objects.emplace(name, object.save());
+    }
+    write_checkpoint(checkpoints_->file, state);
+    checkpointed_levels_ = state.completed_levels;
+    spdlog::info("Saved checkpoint '{}' after {} top-level stores.",
+                 checkpoints_->file,
+                 state.completed_levels);
+  }
+
+  void framework_graph::restore_checkpoint()
+  {
+    if (not std::filesystem::exists(checkpoints_->file)) {
+      spdlog::info("No checkpoint '{}' exists; starting from the beginning.", checkpoints_->file);
+      return;
+    }
+
+    auto const state = read_checkpoint(checkpoints_->file);
+    for (auto const& [name, fold_state] : state.folds) {
+      auto it = nodes_.folds_.find(name);
+      if (it == nodes_.folds_.end()) {
+        throw std::runtime_error("The checkpoint contains the state of fold '" + name +
+                                 "', which is not part of this job.");
+      }
+      it->second->restore_state(fold_state);
+    }
+    for (auto const& [name, object_state] : state.objects) {
+      auto it = nodes_.checkpointed_.find(name);
+      if (it == nodes_.checkpointed_.end()) {
+        throw std::runtime_error("The checkpoint contains the state of output '" + name +
+                                 "', which is not part of this job.");
+      }
+      it->second.restore(object_state);
     }
+    resumed_levels_ = checkpointed_levels_ = state.completed_levels;
+    spdlog::info("Resuming from checkpoint '{}' after {} top-level stores.",
+                 checkpoints_->file,
+                 state.completed_levels);
   }
 
   product_store_ptr framework_graph::accept(product_store_ptr store)
@@ -195,6 +731,7 @@ namespace meld {
       eoms_.pop();
     }
     levels_.emplace(counters_, sender_, store);
+    ++accepted_stores_;
     return store;
   }
 
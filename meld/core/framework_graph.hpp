@@ -2,8 +2,14 @@
 #define meld_core_framework_graph_hpp
 
 #include "meld/configuration.hpp"
+#include "meld/core/backlog_monitor.hpp"
+#include "meld/core/bottleneck_analysis.hpp"
+#include "meld/core/checkpoint.hpp"
 #include "meld/core/declared_fold.hpp"
 #include "meld/core/declared_unfold.hpp"
+#include "meld/core/dot/data_graph.hpp"
+#include "meld/core/dot/function_graph.hpp"
+#include "meld/core/edge_counts.hpp"
 #include "meld/core/end_of_message.hpp"
 #include "meld/core/filter.hpp"
 #include "meld/core/glue.hpp"
@@ -12,7 +18,13 @@
 #include "meld/core/message_sender.hpp"
 #include "meld/core/multiplexer.hpp"
 #include "meld/core/node_catalog.hpp"
+#include "meld/core/perf_counters.hpp"
+#include "meld/core/progress_reporter.hpp"
+#include "meld/core/readahead.hpp"
+#include "meld/core/replicas.hpp"
+#include "meld/core/trace_recorder.hpp"
 #include "meld/model/level_hierarchy.hpp"
+#include "meld/metaprogramming/type_deduction.hpp"
 #include "meld/model/product_store.hpp"
 #include "meld/source.hpp"
 #include "meld/utilities/resource_usage.hpp"
@@ -20,9 +32,15 @@
 #include "oneapi/tbb/flow_graph.h"
 #include "oneapi/tbb/info.h"
 
+#include <atomic>
+#include <filesystem>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <set>
 #include <stack>
 #include <string>
 #include <tuple>
@@ -44,6 +62,11 @@ namespace meld {
     std::size_t depth_;
   };
 
+  // In the eager mode, every node executes for every message it receives.  In the
+  // demand-driven mode, transforms whose products are consumed only by nodes guarded by
+  // predicates execute only after the predicates have accepted the message.
+  enum class execution_mode { eager, demand_driven };
+
   class framework_graph {
   public:
     explicit framework_graph(product_store_ptr store,
@@ -52,11 +75,112 @@ namespace meld {
                              int max_parallelism = oneapi::tbb::info::default_concurrency());
     ~framework_graph();
 
+    // If a DOT prefix is specified, the function and data graphs are written before the
+    // execution, and again afterward with each node colored by its total execution time,
+    // and each edge by the number of messages (or, if memory accounting is enabled, the
+    // bytes of the products) sent along it.
     void execute(std::string const& dot_prefix = {});
+    void set_execution_mode(execution_mode mode) noexcept { mode_ = mode; }
+
+    // Sets the number of functions that may simultaneously hold the named resource (see
+    // node_options::using_resources).
+    void declare_resource(std::string const& name, std::size_t capacity);
+
+    // Registers a function that decodes the input product into the output product in the
+    // readahead stage (see readahead.hpp).  The decoding of different stores proceeds in
+    // parallel, but the stores are seen by the graph in the order the source yielded them.
+    template <typename F>
+    void decode(std::string const& input_product, std::string const& output_product, F f)
+    {
+      using input_t = std::remove_cvref_t<function_parameter_type<0, F>>;
+      readahead_.add_decoder(input_product,
+                             [input_product, output_product, f](product_store& store) {
+                               store.add_product(output_product,
+                                                 f(store.get_product<input_t>(input_product)));
+                             });
+    }
+
+    // Saves the state of the job every 'options.interval' top-level stores, or resumes the
+    // job from the saved state (see checkpoint.hpp).
+    void enable_checkpoints(checkpoint_options options);
+
+    // The maximum number of stores read from the source ahead of the graph when decoders
+    // have been registered (default is twice the maximum parallelism)
+    void set_readahead_depth(std::size_t depth) { readahead_.set_depth(depth); }
+
+    // The directory in which the results of cached transforms are stored (see
+    // transform_cache.hpp)
+    void set_transform_cache(std::filesystem::path directory);
+
+    // Writes the queue-wait and execution-time distributions of each node to the given
+    // JSON file at the end of the job (see node_statistics.hpp)
+    void set_timing_report(std::string filename);
+
+    // Writes the begin and end of each node invocation to the given file in the Chrome
+    // trace-event format at the end of the job (see trace_recorder.hpp)
+    void enable_tracing(std::string filename,
+                        std::size_t events_per_thread = trace_recorder::default_events_per_thread);
+
+    // Measures each node invocation with the performance counters of the executing thread
+    // (task clock, context switches, page faults, and, if the kernel permits, cycles,
+    // instructions, and cache misses).  The totals per node are included in the timing
+    // report (see perf_counters.hpp).
+    void enable_perf_counters();
+
+    // Attributes the allocations made during each node invocation to the node, and reports
+    // the allocations per call of each node at the end of the job.  Allocations are counted
+    // only if meld is built with ENABLE_ALLOCATION_PROFILING (see allocation_profiler.hpp).
+    void enable_allocation_profiling();
+
+    // Accounts for the memory held by the products of each node and of each level (see
+    // product_memory.hpp).  The live and peak sizes are reported at the end of the job and,
+    // if a DOT file is requested, in the post-execution data graph.  Only the stores read
+    // by this graph after accounting has been enabled are accounted for.
+    void enable_memory_accounting();
+
+    // Null unless memory accounting is enabled; the returned object is updated for as long
+    // as any accounted store exists.
+    std::shared_ptr<product_memory const> memory_accounting() const noexcept
+    {
+      return product_memory_;
+    }
+
+    // Periodically writes the progress of the job (processed stores per level, calls per
+    // node, queue depths, RSS, etc.) to the given file (see progress_reporter.hpp)
+    void enable_progress_reports(progress_options options);
+
+    // Samples the number of entries in each buffer owned by meld every 'interval', and
+    // reports the high-water mark of each buffer at the end of the job (see
+    // backlog_monitor.hpp)
+    void enable_backlog_sampling(std::chrono::milliseconds interval);
+    std::map<std::string, backlog_mark> backlog_high_water_marks() const;
+
+    // Registers a function that is invoked, in order of registration, once the job has
+    // been processed.  The reports of the statistics enabled above are registered this way.
+    void add_post_run_report(std::function<void()> report);
 
     std::size_t execution_counts(std::string const& node_name) const;
     std::size_t product_counts(std::string const& node_name) const;
 
+    // The counters of all nodes, indexed by the IDs assigned when the graph is finalized
+    // (see node_catalog.hpp)
+    std::vector<node_counts> statistics() const { return nodes_.counts(); }
+
+    // The critical path, serial fraction, speedup ceiling, and longest-waiting nodes of
+    // the executed job (see bottleneck_analysis.hpp)
+    bottleneck_report bottlenecks() const;
+
+    // Logs the bottleneck report at the end of each job
+    void enable_bottleneck_report();
+
+    // The resources used since the graph was constructed, of which a snapshot is taken at
+    // the end of each job and, if requested, every 'interval' (see resource_usage.hpp)
+    resource_usage const& resources() const noexcept { return graph_resource_usage_; }
+    void sample_resources(std::chrono::milliseconds const interval)
+    {
+      graph_resource_usage_.sample_periodically(interval);
+    }
+
     graph_proxy<void_tag> proxy(configuration const& config)
     {
       return {config, graph_, nodes_, registration_errors_};
@@ -85,14 +209,44 @@ namespace meld {
         graph_, nodes_, std::make_shared<T>(std::forward<Args>(args)...), registration_errors_};
     }
 
+    // Like make, but retains copies of the arguments so that the algorithms bound to the
+    // object may be replicated (see replicas.hpp).
+    template <typename T, typename... Args>
+      requires replicable_from<T, Args...>
+    glue<T> make_replicable(Args&&... args)
+    {
+      auto make_replica = make_replica_factory<T>(args...);
+      auto obj = std::make_shared<T>(std::forward<Args>(args)...);
+      auto replicas = std::make_shared<meld::replicas<T>>(obj, std::move(make_replica));
+      return {graph_, nodes_, std::move(obj), registration_errors_, nullptr, std::move(replicas)};
+    }
+
   private:
     void run();
     void finalize(std::string const& dot_file_prefix);
-    void post_data_graph(std::string const& dot_file_prefix);
+    void post_execution_graphs(std::string const& dot_file_prefix);
 
+    std::optional<product_store_ptr> pull_store();
+    product_store_ptr read_store();
     product_store_ptr accept(product_store_ptr store);
     void drain();
+    bool outputs_full() const;
+    bool throttle();
+    void resume_source();
+    bool checkpoint_due(product_store_ptr const& store) const;
+    void pause_for_checkpoint(product_store_ptr store);
+    void save_checkpoint();
+    void restore_checkpoint();
     std::size_t original_message_id(product_store_ptr const& store);
+    progress_sample sample_progress() const;
+    std::map<std::string, std::size_t> sample_backlogs() const;
+
+    // Post-run reports
+    void log_cache_statistics() const;
+    void log_product_memory() const;
+    void log_allocations() const;
+    void log_backlog_marks() const;
+    void write_trace() const;
 
     glue<void_tag> proxy() { return {graph_, nodes_, nullptr, registration_errors_}; }
 
@@ -108,6 +262,7 @@ namespace meld {
     node_catalog nodes_{};
     tbb::flow::graph graph_{};
     framework_driver driver_;
+    readahead readahead_;
     std::vector<std::string> registration_errors_{};
     std::map<std::string, filter> filters_{};
     tbb::flow::input_node<message> src_;
@@ -117,6 +272,31 @@ namespace meld {
     std::queue<product_store_ptr> pending_stores_;
     flush_counters counters_;
     std::stack<level_sentry> levels_;
+    execution_mode mode_{execution_mode::eager};
+    std::optional<checkpoint_options> checkpoints_{};
+    std::size_t top_levels_{};           // Number of top-level stores read from the source
+    std::size_t resumed_levels_{};       // Number of top-level stores completed before resuming
+    std::size_t checkpointed_levels_{};  // Number of top-level stores completed at last checkpoint
+    product_store_ptr paused_store_{};   // First store read after a checkpoint boundary
+    std::mutex throttle_mutex_;
+    bool throttled_{false}; // Source stopped while an output buffer is full
+    std::string timing_report_{};
+    std::string trace_file_{};
+    std::unique_ptr<trace_recorder> trace_{};
+    std::unique_ptr<perf_counters> perf_{};
+    bool allocation_profiling_{false};
+    bool bottleneck_report_{false};
+    std::shared_ptr<product_memory> product_memory_{};
+    std::optional<progress_options> progress_{};
+    std::atomic<std::size_t> accepted_stores_{}; // Read by the progress reporter
+    std::optional<std::chrono::milliseconds> backlog_interval_{};
+    std::unique_ptr<backlog_monitor> backlogs_{};
+    std::unique_ptr<dot::function_graph> function_graph_{};
+    std::unique_ptr<dot::data_graph> data_graph_{};
+    edge_counts edge_counts_{};
+    std::map<std::string, std::set<std::string>> upstream_nodes_{};
+    std::vector<std::function<void()>> post_run_reports_{};
+    double elapsed_time_{}; // s, of the most recent run
     bool shutdown_{false};
   };
 }
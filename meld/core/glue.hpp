@@ -8,6 +8,7 @@
 #include "meld/core/double_bound_function.hpp"
 #include "meld/core/node_catalog.hpp"
 #include "meld/core/registrar.hpp"
+#include "meld/core/replicas.hpp"
 #include "meld/metaprogramming/delegate.hpp"
 #include "meld/metaprogramming/function_name.hpp"
 
@@ -31,8 +32,14 @@ namespace meld {
          node_catalog& nodes,
          std::shared_ptr<T> bound_obj,
          std::vector<std::string>& errors,
-         configuration const* config = nullptr) :
-      graph_{g}, nodes_{nodes}, bound_obj_{std::move(bound_obj)}, errors_{errors}, config_{config}
+         configuration const* config = nullptr,
+         replicas_ptr<T> replicas = nullptr) :
+      graph_{g},
+      nodes_{nodes},
+      bound_obj_{std::move(bound_obj)},
+      errors_{errors},
+      config_{config},
+      replicas_{std::move(replicas)}
     {
     }
 
@@ -48,13 +55,18 @@ namespace meld {
         }
         throw std::runtime_error{msg};
       }
-      return bound_function{config_, std::move(name), bound_obj_, f, c, graph_, nodes_, errors_};
+      return bound_function{
+        config_, std::move(name), bound_obj_, f, c, graph_, nodes_, errors_, replicas_};
     }
 
     auto with(auto f, concurrency c = concurrency::serial) { return with(function_name(f), f, c); }
 
     auto output_with(std::string name, is_output_like auto f, concurrency c = concurrency::serial)
     {
+      if constexpr (checkpointable<T>) {
+        std::string const module = config_ ? config_->get<std::string>("module_label") : "";
+        nodes_.register_checkpointed(algorithm_name{module, name}.full(), bound_obj_);
+      }
       return output_creator{nodes_.register_output(errors_),
                             config_,
                             std::move(name),
@@ -73,6 +85,7 @@ namespace meld {
     std::shared_ptr<T> bound_obj_;
     std::vector<std::string>& errors_;
     configuration const* config_;
+    replicas_ptr<T> replicas_;
   };
 
   template <typename T>
@@ -7,6 +7,7 @@
 #include "meld/core/glue.hpp"
 #include "meld/core/node_catalog.hpp"
 #include "meld/core/registrar.hpp"
+#include "meld/core/replicas.hpp"
 #include "meld/metaprogramming/delegate.hpp"
 #include "meld/metaprogramming/function_name.hpp"
 
@@ -46,9 +47,21 @@ namespace meld {
         config_, graph_, nodes_, std::make_shared<U>(std::forward<Args>(args)...), errors_};
     }
 
+    // Like make, but retains copies of the arguments so that the algorithms bound to the
+    // object may be replicated (see replicas.hpp).
+    template <typename U, typename... Args>
+      requires replicable_from<U, Args...>
+    graph_proxy<U> make_replicable(Args&&... args)
+    {
+      auto make_replica = make_replica_factory<U>(args...);
+      auto obj = std::make_shared<U>(std::forward<Args>(args)...);
+      auto replicas = std::make_shared<meld::replicas<U>>(obj, std::move(make_replica));
+      return graph_proxy<U>{config_, graph_, nodes_, std::move(obj), errors_, std::move(replicas)};
+    }
+
     auto with(std::string name, auto f, concurrency c = concurrency::serial)
     {
-      return glue{graph_, nodes_, bound_obj_, errors_, config_}.with(name, f, c);
+      return glue{graph_, nodes_, bound_obj_, errors_, config_, replicas_}.with(name, f, c);
     }
 
     auto with(auto f, concurrency c = concurrency::serial) { return with(function_name(f), f, c); }
@@ -61,6 +74,10 @@ namespace meld {
 
     auto output_with(std::string name, is_output_like auto f, concurrency c = concurrency::serial)
     {
+      if constexpr (checkpointable<T>) {
+        std::string const module = config_ ? config_->get<std::string>("module_label") : "";
+        nodes_.register_checkpointed(algorithm_name{module, name}.full(), bound_obj_);
+      }
       return output_creator{
         nodes_.register_output(errors_), config_, name, graph_, delegate(bound_obj_, f), c};
     }
@@ -74,9 +91,15 @@ namespace meld {
                 tbb::flow::graph& g,
                 node_catalog& nodes,
                 std::shared_ptr<T> bound_obj,
-                std::vector<std::string>& errors)
+                std::vector<std::string>& errors,
+                replicas_ptr<T> replicas = nullptr)
       requires(not std::same_as<T, void_tag>)
-      : config_{config}, graph_{g}, nodes_{nodes}, bound_obj_{bound_obj}, errors_{errors}
+      : config_{config},
+        graph_{g},
+        nodes_{nodes},
+        bound_obj_{bound_obj},
+        errors_{errors},
+        replicas_{std::move(replicas)}
     {
     }
 
@@ -85,6 +108,7 @@ namespace meld {
     node_catalog& nodes_;
     std::shared_ptr<T> bound_obj_;
     std::vector<std::string>& errors_;
+    replicas_ptr<T> replicas_{};
   };
 }
 
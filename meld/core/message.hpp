@@ -9,6 +9,8 @@
 
 #include "oneapi/tbb/flow_graph.h" // <-- belongs somewhere else
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <span>
 #include <stdexcept>
@@ -23,11 +25,27 @@ namespace meld {
     end_of_message_ptr eom;
     std::size_t id;
     std::size_t original_id{-1ull}; // Used during flush
+    // Restamped whenever the message is enqueued for a node (see 'stamped')
+    std::chrono::steady_clock::time_point sent{std::chrono::steady_clock::now()};
   };
 
+  // A copy of the message, stamped with the current time
+  inline message stamped(message msg)
+  {
+    msg.sent = std::chrono::steady_clock::now();
+    return msg;
+  }
+
   template <std::size_t N>
   using messages_t = sized_tuple<message, N>;
 
+  // The time at which the last of the messages was sent
+  template <typename Tuple>
+  std::chrono::steady_clock::time_point latest_arrival(Tuple const& messages)
+  {
+    return std::apply([](auto const&... msgs) { return std::max({msgs.sent...}); }, messages);
+  }
+
   struct MessageHasher {
     std::size_t operator()(message const& msg) const noexcept;
   };
@@ -35,6 +53,13 @@ namespace meld {
   // Overload for use with most_derived
   message const& more_derived(message const& a, message const& b);
 
+  // Flush messages never invoke the algorithm of the node receiving them.
+  template <std::size_t N>
+  bool is_flush(messages_t<N> const& messages)
+  {
+    return most_derived(messages).store->is_flush();
+  }
+
   namespace detail {
     template <std::size_t N>
     using join_messages_t = tbb::flow::join_node<messages_t<N>, tbb::flow::tag_matching>;
@@ -43,7 +68,8 @@ namespace meld {
 
     struct no_join : no_join_base_t {
       no_join(tbb::flow::graph& g, MessageHasher) :
-        no_join_base_t{g, tbb::flow::unlimited, [](message const& msg) { return std::tuple{msg}; }}
+        no_join_base_t{
+          g, tbb::flow::unlimited, [](message const& msg) { return std::tuple{stamped(msg)}; }}
       {
       }
     };
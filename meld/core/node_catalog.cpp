@@ -0,0 +1,106 @@
+#include "meld/core/node_catalog.hpp"
+
+#include <ranges>
+
+namespace meld {
+  serializer_node& node_catalog::resource(tbb::flow::graph& g, std::string const& name)
+  {
+    return resources_.try_emplace(name, g, name).first->second;
+  }
+
+  std::vector<serializer_node*> node_catalog::resources(tbb::flow::graph& g,
+                                                        std::vector<std::string> const& names)
+  {
+    std::vector<serializer_node*> result;
+    result.reserve(names.size());
+    for (auto const& name : names) {
+      result.push_back(&resource(g, name));
+    }
+    return result;
+  }
+
+  void node_catalog::activate_resources()
+  {
+    for (auto& resource : resources_ | std::views::values) {
+      resource.activate();
+    }
+  }
+
+  void node_catalog::assign_ids()
+  {
+    registry_.clear();
+    ids_.clear();
+    for_each_node([this](std::string const& name, char const* kind, consumer& node) {
+      node.set_id(registry_.size());
+      ids_.emplace(name, registry_.size());
+      registry_.push_back({&name, kind, &node});
+    });
+  }
+
+  consumer const* node_catalog::find(std::size_t const id) const noexcept
+  {
+    return id < registry_.size() ? registry_[id].node : nullptr;
+  }
+
+  consumer const* node_catalog::find(std::string const& name) const
+  {
+    auto it = ids_.find(name);
+    return it != ids_.end() ? registry_[it->second].node : nullptr;
+  }
+
+  char const* node_catalog::kind_of(std::size_t const id) const noexcept
+  {
+    return id < registry_.size() ? registry_[id].kind : "";
+  }
+
+  std::vector<node_counts> node_catalog::counts() const
+  {
+    std::vector<node_counts> result;
+    result.reserve(registry_.size());
+    for (std::size_t id = 0; auto const& [name, kind, node] : registry_) {
+      auto const& stats = node->statistics();
+      result.push_back({id++,
+                        *name,
+                        kind,
+                        stats.calls(),
+                        stats.products(),
+                        stats.failures(),
+                        stats.total_execution_time(),
+                        stats.allocations(),
+                        stats.allocated_bytes()});
+    }
+    return result;
+  }
+
+  std::vector<node_timing> node_catalog::timings() const
+  {
+    std::vector<node_timing> result;
+    for_each_node([&result](std::string const& name, char const* kind, consumer const& node) {
+      auto const& stats = node.statistics();
+      result.push_back(
+        {name, kind, stats.queue_wait(), stats.execution_time(), stats.perf_totals()});
+    });
+    return result;
+  }
+
+  void node_catalog::enable_perf_counters(perf_counters& counters)
+  {
+    for_each_node([&counters](std::string const&, char const*, consumer& node) {
+      node.statistics().enable_perf_counters(counters);
+    });
+  }
+
+  void node_catalog::enable_allocation_profiling()
+  {
+    for_each_node([](std::string const&, char const*, consumer& node) {
+      node.statistics().enable_allocation_profiling();
+    });
+  }
+
+  void node_catalog::enable_tracing(trace_recorder& recorder)
+  {
+    for_each_node([&recorder](std::string const& name, char const* kind, consumer& node) {
+      node.statistics().enable_tracing(recorder, name, kind);
+    });
+  }
+}
@@ -1,13 +1,28 @@
 #ifndef meld_core_node_catalog_hpp
 #define meld_core_node_catalog_hpp
 
+#include "meld/core/checkpoint.hpp"
 #include "meld/core/declared_fold.hpp"
 #include "meld/core/declared_observer.hpp"
 #include "meld/core/declared_output.hpp"
 #include "meld/core/declared_predicate.hpp"
 #include "meld/core/declared_transform.hpp"
 #include "meld/core/declared_unfold.hpp"
+#include "meld/core/perf_counters.hpp"
 #include "meld/core/registrar.hpp"
+#include "meld/core/trace_recorder.hpp"
+#include "meld/core/transform_cache.hpp"
+#include "meld/graph/serializer_node.hpp"
+
+#include "oneapi/tbb/flow_graph.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace meld {
   struct node_catalog {
@@ -33,6 +48,90 @@ namespace meld {
     declared_folds folds_{};
     declared_unfolds unfolds_{};
     declared_transforms transforms_{};
+
+    // Persistent results of the transforms that are declared as cached
+    transform_cache transform_cache_{};
+
+    // Shared resources, each of which has a limited number of simultaneous holders
+    serializer_node& resource(tbb::flow::graph& g, std::string const& name);
+    std::vector<serializer_node*> resources(tbb::flow::graph& g,
+                                            std::vector<std::string> const& names);
+    void activate_resources();
+
+    std::map<std::string, serializer_node> resources_{};
+
+    // The registry assigns each declared node a dense ID (in the order of for_each_node),
+    // through which its statistics can be accessed in constant time.  Must be called once
+    // all nodes have been declared.
+    void assign_ids();
+    std::size_t size() const noexcept { return registry_.size(); }
+    consumer const* find(std::size_t id) const noexcept;
+    consumer const* find(std::string const& name) const;
+    char const* kind_of(std::size_t id) const noexcept;
+
+    // The counters of all declared nodes, indexed by ID
+    std::vector<node_counts> counts() const;
+
+    // Timing statistics of all declared nodes, merged over threads
+    std::vector<node_timing> timings() const;
+    void enable_tracing(trace_recorder& recorder);
+    void enable_perf_counters(perf_counters& counters);
+    void enable_allocation_profiling();
+
+    // Invokes f(name, kind, node) for each declared node, where kind is the string literal
+    // "predicate", "observer", "output", "fold", "unfold", or "transform".
+    template <typename F>
+    void for_each_node(F&& f)
+    {
+      for_each_node_in(*this, f);
+    }
+    template <typename F>
+    void for_each_node(F&& f) const
+    {
+      for_each_node_in(*this, f);
+    }
+
+    // Objects bound to outputs whose states are saved at checkpoints
+    struct checkpointed_object {
+      std::function<std::string()> save;
+      std::function<void(std::string_view)> restore;
+    };
+
+    template <checkpointable T>
+    void register_checkpointed(std::string const& name, std::shared_ptr<T> obj)
+    {
+      checkpointed_.insert_or_assign(
+        name,
+        checkpointed_object{[obj] { return obj->checkpoint(); },
+                            [obj](std::string_view state) { obj->restore(state); }});
+    }
+
+    std::map<std::string, checkpointed_object> checkpointed_{};
+
+  private:
+    struct registered_node {
+      std::string const* name;
+      char const* kind;
+      consumer* node;
+    };
+    std::vector<registered_node> registry_{};
+    std::unordered_map<std::string, std::size_t> ids_{};
+
+    template <typename Self, typename F>
+    static void for_each_node_in(Self& self, F& f)
+    {
+      auto apply = [&f](auto& nodes, char const* kind) {
+        for (auto& [name, node] : nodes) {
+          f(name, kind, *node);
+        }
+      };
+      apply(self.predicates_, "predicate");
+      apply(self.observers_, "observer");
+      apply(self.outputs_, "output");
+      apply(self.folds_, "fold");
+      apply(self.unfolds_, "unfold");
+      apply(self.transforms_, "transform");
+    }
   };
 }
 
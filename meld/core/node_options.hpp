@@ -30,6 +30,22 @@ namespace meld {
       return when({std::forward<decltype(names)>(names)...});
     }
 
+    // Each invocation of the function holds one token of each of the specified shared
+    // resources.  The number of tokens per resource is set by
+    // framework_graph::declare_resource (the default is 1).
+    T& using_resources(std::vector<std::string> resources)
+    {
+      if (!resources_) {
+        resources_ = std::move(resources);
+      }
+      return self();
+    }
+
+    T& using_resources(std::convertible_to<std::string> auto&&... names)
+    {
+      return using_resources({std::forward<decltype(names)>(names)...});
+    }
+
   protected:
     explicit node_options(configuration const* config)
     {
@@ -37,6 +53,7 @@ namespace meld {
         return;
       }
       predicates_ = config->get_if_present<std::vector<std::string>>("when");
+      resources_ = config->get_if_present<std::vector<std::string>>("resources");
     }
 
     std::vector<std::string> release_predicates()
@@ -44,9 +61,15 @@ namespace meld {
       return std::move(predicates_).value_or(std::vector<std::string>{});
     }
 
+    std::vector<std::string> release_resources()
+    {
+      return std::move(resources_).value_or(std::vector<std::string>{});
+    }
+
   private:
     auto& self() { return *static_cast<T*>(this); }
     std::optional<std::vector<std::string>> predicates_{};
+    std::optional<std::vector<std::string>> resources_{};
   };
 }
 
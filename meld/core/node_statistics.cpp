@@ -0,0 +1,170 @@
+#include "meld/core/node_statistics.hpp"
+#include "meld/core/trace_recorder.hpp"
+#include "meld/utilities/escaped.hpp"
+
+#include "fmt/format.h"
+
+#include <fstream>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+  std::uint64_t to_nanoseconds(steady_clock::duration const d)
+  {
+    auto const ns = duration_cast<nanoseconds>(d).count();
+    return ns < 0 ? 0 : ns;
+  }
+
+  std::string to_json(meld::histogram const& h)
+  {
+    return fmt::format(R"({{"count": {}, "mean": {:.1f}, "min": {}, "p50": {}, "p90": {}, )"
+                       R"("p99": {}, "max": {}}})",
+                       h.count(),
+                       h.mean(),
+                       h.min(),
+                       h.percentile(50.),
+                       h.percentile(90.),
+                       h.percentile(99.),
+                       h.max());
+  }
+}
+
+namespace meld {
+  node_statistics::timer::timer(node_statistics& stats,
+                                clock::time_point const arrival,
+                                level_id_ptr const& id) noexcept :
+    stats_{stats},
+    arrival_{arrival},
+    id_{id},
+    asynchronous_{false},
+    perf_start_{stats_.perf_ ? stats_.perf_->read() : perf_values{}},
+    start_{clock::now()}
+  {
+    if (stats_.profile_allocations_) {
+      previous_allocations_ = attribute_allocations_to(&stats_.counters_.allocations);
+    }
+  }
+
+  node_statistics::timer::timer(node_statistics& stats,
+                                clock::time_point const arrival,
+                                clock::time_point const start,
+                                level_id_ptr const& id) noexcept :
+    stats_{stats}, arrival_{arrival}, id_{id}, asynchronous_{true}, start_{start}
+  {
+  }
+
+  node_statistics::timer::~timer()
+  {
+    auto const end = clock::now();
+    if (stats_.profile_allocations_ and not asynchronous_) {
+      attribute_allocations_to(previous_allocations_);
+    }
+    if (stats_.perf_ and not asynchronous_) {
+      auto const perf_end = stats_.perf_->read();
+      auto& totals = stats_.histograms_.local().perf;
+      for (std::size_t i = 0; i != n_perf_events; ++i) {
+        totals[i] += perf_end[i] - perf_start_[i];
+      }
+    }
+    stats_.record(start_ - arrival_, end - start_);
+    if (std::uncaught_exceptions() > uncaught_exceptions_) {
+      stats_.count_failure();
+    }
+    if (stats_.trace_) {
+      stats_.trace_->record(stats_.trace_name_, stats_.trace_kind_, id_, start_, end);
+    }
+  }
+
+  void node_statistics::enable_tracing(trace_recorder& recorder,
+                                       std::string name,
+                                       char const* kind)
+  {
+    trace_ = &recorder;
+    trace_name_ = std::move(name);
+    trace_kind_ = kind;
+  }
+
+  void node_statistics::record(clock::duration const queue_wait,
+                               clock::duration const execution) noexcept
+  {
+    auto const execution_ns = to_nanoseconds(execution);
+    auto& local = histograms_.local();
+    local.queue_wait.record(to_nanoseconds(queue_wait));
+    local.execution_time.record(execution_ns);
+    counters_.execution_ns.fetch_add(execution_ns, std::memory_order_relaxed);
+  }
+
+  histogram node_statistics::queue_wait() const
+  {
+    histogram result;
+    for (auto const& local : histograms_) {
+      result.merge(local.queue_wait);
+    }
+    return result;
+  }
+
+  histogram node_statistics::execution_time() const
+  {
+    histogram result;
+    for (auto const& local : histograms_) {
+      result.merge(local.execution_time);
+    }
+    return result;
+  }
+
+  std::vector<std::pair<char const*, std::uint64_t>> node_statistics::perf_totals() const
+  {
+    std::vector<std::pair<char const*, std::uint64_t>> result;
+    if (not perf_) {
+      return result;
+    }
+    perf_values totals{};
+    for (auto const& local : histograms_) {
+      for (std::size_t i = 0; i != n_perf_events; ++i) {
+        totals[i] += local.perf[i];
+      }
+    }
+    for (std::size_t i = 0; i != n_perf_events; ++i) {
+      auto const event = static_cast<perf_event>(i);
+      if (perf_->available(event)) {
+        result.emplace_back(to_string(event), totals[i]);
+      }
+    }
+    return result;
+  }
+
+  void write_timing_report(std::string const& filename, std::vector<node_timing> const& nodes)
+  {
+    std::ofstream file{filename};
+    if (!file) {
+      throw std::runtime_error("Cannot open timing report file " + filename);
+    }
+    file << "{\n  \"units\": \"ns\",\n  \"nodes\": [";
+    bool first = true;
+    for (auto const& [name, kind, queue_wait, execution_time, perf_counters] : nodes) {
+      file << (first ? "\n" : ",\n");
+      file << fmt::format(R"(    {{"name": "{}", "kind": "{}",)"
+                          "\n"
+                          R"(     "execution_time": {},)"
+                          "\n"
+                          R"(     "queue_wait": {})",
+                          escaped(name),
+                          kind,
+                          to_json(execution_time),
+                          to_json(queue_wait));
+      if (not perf_counters.empty()) {
+        file << ",\n     \"perf_counters\": {";
+        bool first_counter = true;
+        for (auto const& [event, value] : perf_counters) {
+          file << fmt::format(R"({}"{}": {})", first_counter ? "" : ", ", event, value);
+          first_counter = false;
+        }
+        file << '}';
+      }
+      file << '}';
+      first = false;
+    }
+    file << "\n  ]\n}\n";
+  }
+}
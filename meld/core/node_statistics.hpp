@@ -0,0 +1,176 @@
+#ifndef meld_core_node_statistics_hpp
+#define meld_core_node_statistics_hpp
+
+// =======================================================================================
+// Each declared node records, for every invocation of its algorithm:
+//
+//   - the queue wait: the time between the arrival of the (last) message that makes the
+//     invocation possible and the start of the invocation, and
+//   - the execution time of the invocation itself, which for asynchronous invocations
+//     lasts until their results have been retrieved.
+//
+// Messages are stamped with their arrival time whenever they are enqueued for a node, so
+// that the queue wait of a node does not include the latency of the nodes upstream of it.
+//
+// The durations are recorded in per-thread histograms, which are merged only when the
+// statistics are requested (typically at the end of the job).  A JSON report of all
+// nodes can be written with framework_graph::set_timing_report.
+//
+// In addition, every node type maintains the same counters: the number of calls of its
+// algorithm, the number of products it has created, the number of invocations that
+// threw an exception, and the total execution time.  The counters of each node occupy
+// their own cache line, so that nodes executing concurrently do not contend for it.
+//
+// If tracing is enabled, each invocation is also recorded by the trace_recorder (see
+// trace_recorder.hpp).  If performance counters are enabled, the differences of the
+// counters of the executing thread before and after each invocation are accumulated in
+// per-thread totals (see perf_counters.hpp).  If allocation profiling is enabled, the
+// allocations made during each invocation are attributed to the node (see
+// allocation_profiler.hpp).
+// =======================================================================================
+
+#include "meld/core/perf_counters.hpp"
+#include "meld/model/fwd.hpp"
+#include "meld/utilities/allocation_profiler.hpp"
+#include "meld/utilities/histogram.hpp"
+
+#include "oneapi/tbb/enumerable_thread_specific.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace meld {
+  class trace_recorder;
+
+  class node_statistics {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    class timer {
+    public:
+      timer(node_statistics& stats, clock::time_point arrival, level_id_ptr const& id) noexcept;
+      timer(node_statistics& stats,
+            clock::time_point arrival,
+            clock::time_point start,
+            level_id_ptr const& id) noexcept;
+      ~timer();
+
+      timer(timer const&) = delete;
+      timer& operator=(timer const&) = delete;
+
+    private:
+      node_statistics& stats_;
+      clock::time_point arrival_;
+      level_id_ptr const& id_;
+      bool const asynchronous_;
+      int const uncaught_exceptions_{std::uncaught_exceptions()};
+      perf_values perf_start_{};
+      allocation_counters* previous_allocations_{nullptr};
+      clock::time_point start_;
+    };
+
+    // The level ID must outlive the returned timer.
+    timer time(clock::time_point const arrival, level_id_ptr const& id) noexcept
+    {
+      return {*this, arrival, id};
+    }
+
+    // For an asynchronous invocation that was launched at 'start' and is complete once the
+    // returned timer is destroyed.  As the work of such an invocation is not done by the
+    // timing thread, neither performance counters nor allocations are attributed to it.
+    timer time_since(clock::time_point const arrival,
+                     clock::time_point const start,
+                     level_id_ptr const& id) noexcept
+    {
+      return {*this, arrival, start, id};
+    }
+    void record(clock::duration queue_wait, clock::duration execution) noexcept;
+
+    void count_call() noexcept { counters_.calls.fetch_add(1, std::memory_order_relaxed); }
+    void count_products(std::size_t const n = 1) noexcept
+    {
+      counters_.products.fetch_add(n, std::memory_order_relaxed);
+    }
+    void count_failure() noexcept { counters_.failures.fetch_add(1, std::memory_order_relaxed); }
+
+    std::size_t calls() const noexcept { return counters_.calls.load(); }
+    std::size_t products() const noexcept { return counters_.products.load(); }
+    std::size_t failures() const noexcept { return counters_.failures.load(); }
+    std::uint64_t total_execution_time() const noexcept { return counters_.execution_ns.load(); }
+    std::uint64_t allocations() const { return counters_.allocations.total().allocations; }
+    std::uint64_t allocated_bytes() const { return counters_.allocations.total().bytes; }
+
+    // Each subsequent invocation is recorded by the trace recorder, which must outlive the
+    // statistics.
+    void enable_tracing(trace_recorder& recorder, std::string name, char const* kind);
+
+    // Each subsequent invocation is measured with the performance counters, which must
+    // outlive the statistics.
+    void enable_perf_counters(perf_counters& counters) noexcept { perf_ = &counters; }
+
+    // Each subsequent invocation is made the target of the allocations of its thread.
+    void enable_allocation_profiling() noexcept { profile_allocations_ = true; }
+
+    // Merged over all threads
+    histogram queue_wait() const;
+    histogram execution_time() const;
+
+    // Merged over all threads, for the available events only (empty if performance counters
+    // are not enabled)
+    std::vector<std::pair<char const*, std::uint64_t>> perf_totals() const;
+
+  private:
+    static constexpr std::size_t cache_line_size{64};
+    struct alignas(cache_line_size) counters {
+      std::atomic<std::size_t> calls{};
+      std::atomic<std::size_t> products{};
+      std::atomic<std::size_t> failures{};
+      std::atomic<std::uint64_t> execution_ns{};
+      allocation_counters allocations{};
+    };
+
+    struct per_thread {
+      histogram queue_wait;
+      histogram execution_time;
+      perf_values perf{};
+    };
+    counters counters_;
+    tbb::enumerable_thread_specific<per_thread> histograms_;
+    trace_recorder* trace_{nullptr};
+    std::string trace_name_{};
+    char const* trace_kind_{""};
+    perf_counters* perf_{nullptr};
+    bool profile_allocations_{false};
+  };
+
+  struct node_timing {
+    std::string name;
+    std::string kind;
+    histogram queue_wait;
+    histogram execution_time;
+    std::vector<std::pair<char const*, std::uint64_t>> perf_counters{};
+  };
+
+  // The counters of a node, as exported by the node registry (see node_catalog.hpp)
+  struct node_counts {
+    std::size_t id;
+    std::string name;
+    std::string kind;
+    std::size_t calls;
+    std::size_t products;
+    std::size_t failures;
+    std::uint64_t execution_time; // ns
+    std::uint64_t allocations;    // Zero unless allocation profiling is enabled
+    std::uint64_t allocated_bytes;
+  };
+
+  void write_timing_report(std::string const& filename, std::vector<node_timing> const& nodes);
+}
+
+#endif // meld_core_node_statistics_hpp
@@ -0,0 +1,120 @@
+#include "meld/core/output_buffer.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace meld {
+  output_buffer::output_buffer(tbb::flow::graph& g,
+                               write_t write,
+                               output_buffer_options const& options) :
+    graph_{g}, write_{std::move(write)}, options_{options}
+  {
+    if (options_.capacity == 0ull) {
+      throw std::runtime_error("The capacity of an output buffer must be at least 1.");
+    }
+    options_.batch_size = std::clamp(options_.batch_size, std::size_t{1}, options_.capacity);
+    thread_ = std::thread{[this] { write_batches(); }};
+  }
+
+  output_buffer::~output_buffer()
+  {
+    {
+      std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    pushed_.notify_one();
+    thread_.join();
+  }
+
+  void output_buffer::push(product_store_const_ptr store)
+  {
+    // Balanced by the release_wait() call once the store has been written.
+    graph_.reserve_wait();
+    {
+      std::lock_guard lock{mutex_};
+      queue_.push_back(std::move(store));
+    }
+    pushed_.notify_one();
+  }
+
+  bool output_buffer::full()
+  {
+    std::lock_guard lock{mutex_};
+    return queue_.size() >= options_.capacity;
+  }
+
+  void output_buffer::on_capacity(std::function<void()> notify)
+  {
+    on_capacity_ = std::move(notify);
+  }
+
+  std::size_t output_buffer::size()
+  {
+    std::lock_guard lock{mutex_};
+    return queue_.size();
+  }
+
+  void output_buffer::rethrow_if_failed()
+  {
+    std::lock_guard lock{mutex_};
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+  void output_buffer::write_batches()
+  {
+    std::deque<product_store_const_ptr> batch;
+    while (true) {
+      bool relieved{false};
+      {
+        std::unique_lock lock{mutex_};
+        pushed_.wait(lock, [this] { return stop_ or not queue_.empty(); });
+        if (queue_.empty()) {
+          return;
+        }
+        // Give the batch a chance to fill before writing it.
+        if (queue_.size() < options_.batch_size and options_.flush_interval.count() > 0) {
+          pushed_.wait_for(lock, options_.flush_interval, [this] {
+            return stop_ or queue_.size() >= options_.batch_size;
+          });
+        }
+        auto const n = std::min(queue_.size(), options_.batch_size);
+        batch.insert(end(batch),
+                     std::make_move_iterator(begin(queue_)),
+                     std::make_move_iterator(begin(queue_) + n));
+        relieved = queue_.size() >= options_.capacity and queue_.size() - n < options_.capacity;
+        queue_.erase(begin(queue_), begin(queue_) + n);
+      }
+      // The stores of the batch still hold the graph's wait (released once written), so the
+      // graph cannot complete before a source re-activated here has run.
+      if (relieved and on_capacity_) {
+        on_capacity_();
+      }
+      write(batch);
+    }
+  }
+
+  void output_buffer::write(std::deque<product_store_const_ptr>& batch)
+  {
+    for (auto const& store : batch) {
+      // Once the output function has failed, the remaining stores are discarded so that
+      // the graph and the source are not left waiting on them.
+      if (not failed_) {
+        try {
+          write_(*store);
+        }
+        catch (...) {
+          spdlog::error("Exception thrown while writing store {}", store->id()->to_string());
+          failed_ = true;
+          std::lock_guard lock{mutex_};
+          error_ = std::current_exception();
+        }
+      }
+      graph_.release_wait();
+    }
+    batch.clear();
+  }
+}
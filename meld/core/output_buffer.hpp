@@ -0,0 +1,74 @@
+#ifndef meld_core_output_buffer_hpp
+#define meld_core_output_buffer_hpp
+
+#include "meld/model/product_store.hpp"
+
+#include "oneapi/tbb/flow_graph.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace meld {
+
+  struct output_buffer_options {
+    // Number of stores that may wait to be written before the source is throttled
+    std::size_t capacity{64};
+    // Maximum number of stores written per batch
+    std::size_t batch_size{1};
+    // Maximum time the writer waits for a batch to fill once it has received a store
+    std::chrono::milliseconds flush_interval{};
+  };
+
+  // The output_buffer decouples an output function from the TBB worker threads.  Workers
+  // enqueue the completed stores without blocking, and a dedicated writer thread drains
+  // the queue in batches, invoking the output function serially.  The graph is kept alive
+  // (see graph::reserve_wait) until each enqueued store has been written.
+  //
+  // The buffer itself is unbounded--backpressure is applied by the framework's source,
+  // which stops reading stores while the buffer is full.  The writer thread invokes the
+  // on_capacity callback once the buffer is no longer full so that the source can be
+  // re-activated.
+  class output_buffer {
+  public:
+    using write_t = std::function<void(product_store const&)>;
+
+    output_buffer(tbb::flow::graph& g, write_t write, output_buffer_options const& options);
+    ~output_buffer();
+
+    void push(product_store_const_ptr store);
+    bool full();
+
+    // Must be set before any store is pushed
+    void on_capacity(std::function<void()> notify);
+
+    // The number of stores waiting to be written
+    std::size_t size();
+
+    // Rethrows the first exception thrown by the output function, if any.
+    void rethrow_if_failed();
+
+  private:
+    void write_batches();
+    void write(std::deque<product_store_const_ptr>& batch);
+
+    tbb::flow::graph& graph_;
+    write_t write_;
+    output_buffer_options options_;
+    std::mutex mutex_;
+    std::condition_variable pushed_;
+    std::function<void()> on_capacity_;
+    std::deque<product_store_const_ptr> queue_;
+    std::exception_ptr error_;
+    bool failed_{false}; // Accessed only by the writer thread
+    bool stop_{false};
+    std::thread thread_;
+  };
+}
+
+#endif // meld_core_output_buffer_hpp
@@ -0,0 +1,206 @@
+#include "meld/core/perf_counters.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+#if __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  using meld::perf_event;
+
+  constexpr std::array software_events{
+    perf_event::task_clock, perf_event::context_switches, perf_event::page_faults};
+  constexpr std::array hardware_events{
+    perf_event::cycles, perf_event::instructions, perf_event::cache_misses};
+
+  constexpr std::size_t index(perf_event const event) { return static_cast<std::size_t>(event); }
+
+#if __linux__
+  std::pair<std::uint32_t, std::uint64_t> type_and_config(perf_event const event)
+  {
+    switch (event) {
+    case perf_event::task_clock:
+      return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK};
+    case perf_event::context_switches:
+      return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES};
+    case perf_event::page_faults:
+      return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+    case perf_event::cycles:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    case perf_event::instructions:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+    case perf_event::cache_misses:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+    }
+    return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_DUMMY};
+  }
+
+  // Opens a counter of the calling thread; returns -1 if the event is not available.
+  int open_counter(perf_event const event, int const group_fd)
+  {
+    auto const [type, config] = type_and_config(event);
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_hv = 1;
+    // Kernel events are excluded when the kernel does not permit counting them.
+    for (int const exclude_kernel : {0, 1}) {
+      attr.exclude_kernel = exclude_kernel;
+      auto const fd = syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+      if (fd >= 0) {
+        return static_cast<int>(fd);
+      }
+    }
+    return -1;
+  }
+#endif
+}
+
+namespace meld {
+  char const* to_string(perf_event const event) noexcept
+  {
+    switch (event) {
+    case perf_event::task_clock:
+      return "task_clock_ns";
+    case perf_event::context_switches:
+      return "context_switches";
+    case perf_event::page_faults:
+      return "page_faults";
+    case perf_event::cycles:
+      return "cycles";
+    case perf_event::instructions:
+      return "instructions";
+    case perf_event::cache_misses:
+      return "cache_misses";
+    }
+    return "";
+  }
+
+  perf_counters::group::group(std::vector<perf_event> const& events)
+  {
+#if __linux__
+    for (auto const event : events) {
+      auto const fd = open_counter(event, fds_.empty() ? -1 : fds_.front());
+      if (fd < 0) {
+        continue;
+      }
+      fds_.push_back(fd);
+      events_.push_back(event);
+    }
+#else
+    (void)events;
+#endif
+  }
+
+  perf_counters::group::~group()
+  {
+#if __linux__
+    // The group leader is closed last.
+    for (auto it = fds_.rbegin(); it != fds_.rend(); ++it) {
+      close(*it);
+    }
+#endif
+  }
+
+  perf_counters::group::group(group&& other) noexcept :
+    fds_{std::exchange(other.fds_, {})}, events_{std::exchange(other.events_, {})}
+  {
+  }
+
+  perf_counters::group& perf_counters::group::operator=(group&& other) noexcept
+  {
+    std::swap(fds_, other.fds_);
+    std::swap(events_, other.events_);
+    return *this;
+  }
+
+  bool perf_counters::group::counts(perf_event const event) const noexcept
+  {
+    return std::ranges::find(events_, event) != events_.end();
+  }
+
+  void perf_counters::group::read_into(perf_values& values) const noexcept
+  {
+#if __linux__
+    if (fds_.empty()) {
+      return;
+    }
+    // With PERF_FORMAT_GROUP, the leader reports the number of counters followed by the
+    // value of each counter, in the order in which they were opened.
+    std::array<std::uint64_t, 1 + n_perf_events> buffer{};
+    auto const bytes = ::read(fds_.front(), buffer.data(), sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(sizeof(std::uint64_t)) or buffer[0] != events_.size()) {
+      return;
+    }
+    for (std::size_t i = 0; i != events_.size(); ++i) {
+      values[index(events_[i])] = buffer[i + 1];
+    }
+#else
+    (void)values;
+#endif
+  }
+
+  perf_counters::perf_counters() :
+    software_events_{begin(software_events), end(software_events)},
+    hardware_events_{begin(hardware_events), end(hardware_events)}
+  {
+    // Events that cannot be opened on this thread are assumed to be unavailable on all
+    // threads.
+    auto probe = [this](std::vector<perf_event>& events) {
+      group const probed{events};
+      std::erase_if(events, [this, &probed](perf_event const event) {
+        return not(available_[index(event)] = probed.counts(event));
+      });
+    };
+    probe(software_events_);
+    probe(hardware_events_);
+
+    if (not any_available()) {
+      spdlog::warn("No performance counters are available (see perf_event_paranoid).");
+    }
+    else if (hardware_events_.empty()) {
+      spdlog::info("Hardware performance counters are unavailable; "
+                   "only software events will be counted.");
+    }
+  }
+
+  bool perf_counters::available(perf_event const event) const noexcept
+  {
+    return available_[index(event)];
+  }
+
+  bool perf_counters::any_available() const noexcept
+  {
+    return std::ranges::any_of(available_, [](bool const b) { return b; });
+  }
+
+  perf_values perf_counters::read() noexcept
+  {
+    perf_values result{};
+    if (not any_available()) {
+      return result;
+    }
+    try {
+      bool exists{};
+      auto& groups = groups_.local(exists);
+      if (not exists) {
+        groups = {group{software_events_}, group{hardware_events_}};
+      }
+      groups.software.read_into(result);
+      groups.hardware.read_into(result);
+    }
+    catch (...) {
+      // The counters of this thread could not be opened.
+    }
+    return result;
+  }
+}
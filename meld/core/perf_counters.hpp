@@ -0,0 +1,88 @@
+#ifndef meld_core_perf_counters_hpp
+#define meld_core_perf_counters_hpp
+
+// =======================================================================================
+// The perf_counters class reads, for the calling thread, the counters of the Linux
+// perf_event_open interface:
+//
+//   - software events: the task clock, context switches, and page faults, and
+//   - hardware events: CPU cycles, retired instructions, and cache misses.
+//
+// The counters of each thread are opened upon the thread's first read, and they count
+// only the events of that thread.  Each category of events forms a group, so that all
+// counters of the category are read with a single system call.  Events that cannot be
+// opened--hardware events in most virtual machines, or all events if the kernel's
+// perf_event_paranoid setting forbids them--are reported as unavailable, and the other
+// events are still counted.  On platforms other than Linux, no event is available.
+//
+// Per-node counters are enabled with framework_graph::enable_perf_counters (or the
+// 'perf_counters' configuration option).  The difference of the counters before and
+// after each node invocation is then accumulated per node and included in the timing
+// report (see node_statistics.hpp).
+// =======================================================================================
+
+#include "oneapi/tbb/enumerable_thread_specific.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace meld {
+  enum class perf_event : std::size_t {
+    task_clock,
+    context_switches,
+    page_faults,
+    cycles,
+    instructions,
+    cache_misses
+  };
+  inline constexpr std::size_t n_perf_events{6};
+  using perf_values = std::array<std::uint64_t, n_perf_events>;
+
+  char const* to_string(perf_event event) noexcept;
+
+  class perf_counters {
+  public:
+    // Determines (on the calling thread) which events are available
+    perf_counters();
+
+    perf_counters(perf_counters const&) = delete;
+    perf_counters& operator=(perf_counters const&) = delete;
+
+    bool available(perf_event event) const noexcept;
+    bool any_available() const noexcept;
+
+    // The current values of the calling thread's counters (zero for unavailable events)
+    perf_values read() noexcept;
+
+  private:
+    class group {
+    public:
+      group() = default;
+      explicit group(std::vector<perf_event> const& events);
+      ~group();
+      group(group&& other) noexcept;
+      group& operator=(group&& other) noexcept;
+
+      bool counts(perf_event event) const noexcept;
+      void read_into(perf_values& values) const noexcept;
+
+    private:
+      std::vector<int> fds_{};
+      std::vector<perf_event> events_{};
+    };
+
+    struct thread_groups {
+      group software;
+      group hardware;
+    };
+
+    std::vector<perf_event> software_events_{};
+    std::vector<perf_event> hardware_events_{};
+    std::array<bool, n_perf_events> available_{};
+    tbb::enumerable_thread_specific<thread_groups> groups_;
+  };
+}
+
+#endif // meld_core_perf_counters_hpp
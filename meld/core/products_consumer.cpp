@@ -2,8 +2,10 @@
 
 namespace meld {
 
-  products_consumer::products_consumer(algorithm_name name, std::vector<std::string> predicates) :
-    consumer{std::move(name), std::move(predicates)}
+  products_consumer::products_consumer(algorithm_name name,
+                                       std::size_t const concurrency,
+                                       std::vector<std::string> predicates) :
+    consumer{std::move(name), concurrency, std::move(predicates)}
   {
   }
 
@@ -12,12 +12,15 @@
 
 #include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace meld {
   class products_consumer : public consumer {
   public:
-    products_consumer(algorithm_name name, std::vector<std::string> predicates);
+    products_consumer(algorithm_name name,
+                      std::size_t concurrency,
+                      std::vector<std::string> predicates);
 
     virtual ~products_consumer();
 
@@ -26,7 +29,11 @@ namespace meld {
     tbb::flow::receiver<message>& port(specified_label const& product_label);
     virtual std::vector<tbb::flow::receiver<message>*> ports() = 0;
     virtual specified_labels input() const = 0;
-    virtual std::size_t num_calls() const = 0;
+    std::size_t num_calls() const noexcept { return statistics().calls(); }
+
+    // The number of entries in each of the node's internal maps (see backlog_monitor.hpp)
+    using backlog_t = std::vector<std::pair<char const*, std::size_t>>;
+    virtual backlog_t backlog() const { return {}; }
 
   private:
     virtual tbb::flow::receiver<message>& port_for(specified_label const& product_label) = 0;
@@ -0,0 +1,187 @@
+#include "meld/core/progress_reporter.hpp"
+#include "meld/utilities/escaped.hpp"
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+  using meld::escaped;
+
+  double rate(std::size_t const current, std::size_t const previous, double const seconds)
+  {
+    if (seconds <= 0. or current < previous) {
+      return 0.;
+    }
+    return (current - previous) / seconds;
+  }
+
+  std::size_t previous_count(std::map<std::string, std::size_t> const& counts,
+                             std::string const& name)
+  {
+    auto it = counts.find(name);
+    return it != counts.end() ? it->second : 0ull;
+  }
+
+  std::string to_prometheus(meld::progress_sample const& sample,
+                            std::map<std::string, std::size_t> const& previous_stores,
+                            std::map<std::string, std::size_t> const& previous_calls,
+                            double const elapsed,
+                            double const interval)
+  {
+    std::string result;
+    auto metric = [&result](char const* name, char const* type, char const* help) {
+      result += fmt::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    };
+
+    metric("meld_elapsed_seconds", "gauge", "Time since the job started processing");
+    result += fmt::format("meld_elapsed_seconds {:.3f}\n", elapsed);
+
+    metric("meld_processed_stores_total", "counter", "Number of stores processed per level");
+    for (auto const& [level, count] : sample.processed_stores) {
+      result +=
+        fmt::format("meld_processed_stores_total{{level=\"{}\"}} {}\n", escaped(level), count);
+    }
+    metric("meld_store_rate", "gauge", "Stores processed per second since the last report");
+    for (auto const& [level, count] : sample.processed_stores) {
+      result += fmt::format("meld_store_rate{{level=\"{}\"}} {:.3f}\n",
+                            escaped(level),
+                            rate(count, previous_count(previous_stores, level), interval));
+    }
+
+    metric("meld_in_flight_stores", "gauge", "Stores read from the source but not yet processed");
+    result += fmt::format("meld_in_flight_stores {}\n", sample.in_flight_stores);
+
+    metric("meld_node_calls_total", "counter", "Number of calls per node");
+    for (auto const& [name, kind, calls] : sample.nodes) {
+      result += fmt::format(
+        "meld_node_calls_total{{node=\"{}\",kind=\"{}\"}} {}\n", escaped(name), kind, calls);
+    }
+    metric("meld_node_call_rate", "gauge", "Calls per second since the last report");
+    for (auto const& [name, kind, calls] : sample.nodes) {
+      result += fmt::format("meld_node_call_rate{{node=\"{}\",kind=\"{}\"}} {:.3f}\n",
+                            escaped(name),
+                            kind,
+                            rate(calls, previous_count(previous_calls, name), interval));
+    }
+
+    metric("meld_queue_depth", "gauge", "Number of stores waiting in each queue");
+    for (auto const& [queue, depth] : sample.queue_depths) {
+      result += fmt::format("meld_queue_depth{{queue=\"{}\"}} {}\n", escaped(queue), depth);
+    }
+
+    metric("meld_resident_memory_bytes", "gauge", "Resident set size of the process");
+    result += fmt::format("meld_resident_memory_bytes {}\n", sample.rss_bytes);
+    return result;
+  }
+
+  std::string to_json(meld::progress_sample const& sample,
+                      std::map<std::string, std::size_t> const& previous_stores,
+                      std::map<std::string, std::size_t> const& previous_calls,
+                      double const elapsed,
+                      double const interval)
+  {
+    auto result = fmt::format("{{\n  \"elapsed_seconds\": {:.3f},\n  \"levels\": [", elapsed);
+    bool first = true;
+    for (auto const& [level, count] : sample.processed_stores) {
+      result += fmt::format(R"({}    {{"name": "{}", "processed": {}, "rate": {:.3f}}})",
+                            first ? "\n" : ",\n",
+                            escaped(level),
+                            count,
+                            rate(count, previous_count(previous_stores, level), interval));
+      first = false;
+    }
+    result += fmt::format("\n  ],\n  \"in_flight_stores\": {},\n  \"nodes\": [",
+                          sample.in_flight_stores);
+    first = true;
+    for (auto const& [name, kind, calls] : sample.nodes) {
+      result +=
+        fmt::format(R"({}    {{"name": "{}", "kind": "{}", "calls": {}, "rate": {:.3f}}})",
+                    first ? "\n" : ",\n",
+                    escaped(name),
+                    kind,
+                    calls,
+                    rate(calls, previous_count(previous_calls, name), interval));
+      first = false;
+    }
+    result += "\n  ],\n  \"queue_depths\": {";
+    first = true;
+    for (auto const& [queue, depth] : sample.queue_depths) {
+      result += fmt::format(R"({}"{}": {})", first ? "" : ", ", escaped(queue), depth);
+      first = false;
+    }
+    result += fmt::format("}},\n  \"rss_bytes\": {}\n}}\n", sample.rss_bytes);
+    return result;
+  }
+}
+
+namespace meld {
+  progress_reporter::progress_reporter(progress_options options, sample_t sample) :
+    options_{std::move(options)}, sample_{std::move(sample)}
+  {
+    if (options_.file.empty()) {
+      throw std::runtime_error("A progress file must be specified.");
+    }
+    if (options_.interval.count() <= 0) {
+      throw std::runtime_error("The progress-report interval must be positive.");
+    }
+    sampler_.emplace(options_.interval, [this] {
+      try {
+        report();
+      }
+      catch (std::exception const& e) {
+        spdlog::warn("Could not write a progress report: {}", e.what());
+      }
+    });
+  }
+
+  progress_reporter::~progress_reporter()
+  {
+    sampler_.reset();
+
+    try {
+      report();
+    }
+    catch (std::exception const& e) {
+      spdlog::warn("Could not write the final progress report: {}", e.what());
+    }
+  }
+
+  void progress_reporter::report()
+  {
+    auto sample = sample_();
+    auto const now = clock::now();
+    auto const elapsed = duration<double>(now - begin_).count();
+    auto const interval = duration<double>(now - last_time_).count();
+
+    std::map<std::string, std::size_t> previous_calls;
+    for (auto const& node : last_.nodes) {
+      previous_calls.emplace(node.name, node.calls);
+    }
+
+    std::filesystem::path const file{options_.file};
+    auto const contents =
+      file.extension() == ".json"
+        ? to_json(sample, last_.processed_stores, previous_calls, elapsed, interval)
+        : to_prometheus(sample, last_.processed_stores, previous_calls, elapsed, interval);
+
+    auto temporary = file;
+    temporary += ".tmp";
+    {
+      std::ofstream out{temporary};
+      if (!out) {
+        throw std::runtime_error("Cannot open progress file " + temporary.string());
+      }
+      out << contents;
+    }
+    std::filesystem::rename(temporary, file);
+
+    last_ = std::move(sample);
+    last_time_ = now;
+  }
+}
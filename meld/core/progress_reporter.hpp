@@ -0,0 +1,80 @@
+#ifndef meld_core_progress_reporter_hpp
+#define meld_core_progress_reporter_hpp
+
+// =======================================================================================
+// The progress_reporter periodically writes a snapshot of the state of a running job to
+// a local file, so that an external agent (e.g. the textfile collector of the Prometheus
+// node exporter) can monitor the job without meld providing any network service.  Each
+// snapshot contains:
+//
+//   - the number of stores processed per level, and the rate at which they have been
+//     processed since the previous snapshot,
+//   - the number of stores read from the source whose processing is not yet complete,
+//   - the number of calls per node, and the rate of calls since the previous snapshot,
+//   - the number of stores waiting in each queue (e.g. buffered outputs), and
+//   - the resident set size of the process.
+//
+// The snapshot is written in the JSON format if the file name ends with ".json", and in
+// the Prometheus text exposition format otherwise.  The file is replaced atomically (it
+// is written to a temporary file, which is then renamed), so that it is never read while
+// partially written.  A final snapshot is written when the reporter is destroyed.
+//
+// Progress reports are enabled with framework_graph::enable_progress_reports (or the
+// 'progress' configuration table).
+// =======================================================================================
+
+#include "meld/utilities/periodic_sampler.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace meld {
+  struct progress_options {
+    std::string file;
+    std::chrono::milliseconds interval{std::chrono::seconds{10}};
+  };
+
+  struct progress_sample {
+    struct node {
+      std::string name;
+      char const* kind;
+      std::size_t calls;
+    };
+
+    std::map<std::string, std::size_t> processed_stores; // Per level name
+    std::size_t in_flight_stores;
+    std::vector<node> nodes;
+    std::map<std::string, std::size_t> queue_depths;
+    std::size_t rss_bytes;
+  };
+
+  class progress_reporter {
+  public:
+    using sample_t = std::function<progress_sample()>;
+
+    progress_reporter(progress_options options, sample_t sample);
+    ~progress_reporter();
+
+    progress_reporter(progress_reporter const&) = delete;
+    progress_reporter& operator=(progress_reporter const&) = delete;
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    void report();
+
+    progress_options options_;
+    sample_t sample_;
+    clock::time_point const begin_{clock::now()};
+    clock::time_point last_time_{begin_};
+    progress_sample last_{};
+    std::optional<periodic_sampler> sampler_;
+  };
+}
+
+#endif // meld_core_progress_reporter_hpp
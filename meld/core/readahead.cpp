@@ -0,0 +1,84 @@
+#include "meld/core/readahead.hpp"
+
+#include <stdexcept>
+
+namespace meld {
+  readahead::readahead(next_t next, std::size_t const depth) : next_{std::move(next)}, depth_{depth}
+  {
+  }
+
+  readahead::~readahead() { tasks_.wait(); }
+
+  void readahead::add_decoder(std::string input_product, decoder_t decoder)
+  {
+    decoders_.emplace_back(std::move(input_product), std::move(decoder));
+  }
+
+  void readahead::set_depth(std::size_t const depth)
+  {
+    if (depth == 0ull) {
+      throw std::runtime_error("The readahead depth must be at least 1.");
+    }
+    depth_ = depth;
+  }
+
+  std::optional<product_store_ptr> readahead::operator()()
+  {
+    if (decoders_.empty()) {
+      return next_();
+    }
+
+    fill();
+    if (pending_.empty()) {
+      // The decoding tasks must be completed in the arena in which they were spawned.
+      tasks_.wait();
+      return std::nullopt;
+    }
+
+    auto e = std::move(pending_.front());
+    pending_.pop_front();
+
+    // If no worker has started decoding the store, it is decoded here instead of waiting
+    // for a worker to become available.
+    decode(*e);
+    e->done.wait(false);
+    if (e->error) {
+      tasks_.wait();
+      std::rethrow_exception(e->error);
+    }
+    return std::move(e->store);
+  }
+
+  void readahead::fill()
+  {
+    while (not exhausted_ and pending_.size() < depth_) {
+      auto store = next_();
+      if (not store) {
+        exhausted_ = true;
+        break;
+      }
+      auto e = std::make_shared<entry>(std::move(*store));
+      pending_.push_back(e);
+      tasks_.run([this, e] { decode(*e); });
+    }
+  }
+
+  void readahead::decode(entry& e) const
+  {
+    if (e.claimed.exchange(true)) {
+      return;
+    }
+    try {
+      for (auto const& [input_product, decoder] : decoders_) {
+        if (e.store->contains_product(input_product)) {
+          decoder(*e.store);
+        }
+      }
+    }
+    catch (...) {
+      e.error = std::current_exception();
+    }
+    e.done = true;
+    e.done.notify_all();
+  }
+}
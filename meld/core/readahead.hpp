@@ -0,0 +1,64 @@
+#ifndef meld_core_readahead_hpp
+#define meld_core_readahead_hpp
+
+#include "meld/model/fwd.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "oneapi/tbb/task_group.h"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace meld {
+
+  // The readahead stage sits between the source and the graph.  When decoders have been
+  // registered, it pulls up to 'depth' stores from the source ahead of the graph and
+  // decodes their products in parallel on the TBB pool.  Stores are nevertheless handed to
+  // the graph in the order in which the source yielded them, so the level hierarchy seen by
+  // the graph is the same as without the readahead stage.
+  //
+  // A decoder is invoked only for stores that contain its input product, and it may insert
+  // products into that store--no node can access the store until it has been decoded.
+  class readahead {
+  public:
+    using next_t = std::function<std::optional<product_store_ptr>()>;
+    using decoder_t = std::function<void(product_store&)>;
+
+    readahead(next_t next, std::size_t depth);
+    ~readahead();
+
+    void add_decoder(std::string input_product, decoder_t decoder);
+    void set_depth(std::size_t depth);
+
+    std::optional<product_store_ptr> operator()();
+
+  private:
+    struct entry {
+      explicit entry(product_store_ptr s) : store{std::move(s)} {}
+      product_store_ptr store;
+      std::atomic<bool> claimed{false};
+      std::atomic<bool> done{false};
+      std::exception_ptr error{};
+    };
+
+    void fill();
+    void decode(entry& e) const;
+
+    next_t next_;
+    std::size_t depth_;
+    std::vector<std::pair<std::string, decoder_t>> decoders_;
+    std::deque<std::shared_ptr<entry>> pending_;
+    bool exhausted_{false};
+    tbb::task_group tasks_;
+  };
+}
+
+#endif // meld_core_readahead_hpp
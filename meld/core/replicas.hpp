@@ -0,0 +1,133 @@
+#ifndef meld_core_replicas_hpp
+#define meld_core_replicas_hpp
+
+// =======================================================================================
+// Replicated modules
+//
+// Algorithms bound to a class that is not thread-safe must typically be registered with
+// serial concurrency.  Such an algorithm may instead be replicated:
+//
+//   g.make_replicable<MyModule>(args...)
+//     .with(&MyModule::transform, concurrency::serial)
+//     .replicated(4)
+//     .transform("input")
+//     .to("output");
+//
+// which uses the instance created by make_replicable as the first replica, constructs three
+// more instances of MyModule (using copies of the arguments provided to make_replicable),
+// and permits four concurrent invocations of the algorithm.  Each invocation uses an
+// instance that is not currently in use by any other invocation.
+//
+// All algorithms bound to one make_replicable object share its replicas: the pool grows to
+// the largest replication requested, and every algorithm of the object (replicated or not)
+// holds one token of a shared resource whose capacity is the size of the pool.  No instance
+// is therefore ever entered by two invocations at once, even of different algorithms.
+//
+// Only make_replicable retains copies of the constructor arguments; objects created with
+// make cannot be replicated.
+// =======================================================================================
+
+#include "fmt/format.h"
+#include "oneapi/tbb/concurrent_queue.h"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace meld {
+
+  template <typename T>
+  using replica_factory = std::function<std::shared_ptr<T>()>;
+
+  template <typename T, typename... Args>
+  concept replicable_from = (std::copy_constructible<std::decay_t<Args>> && ...) &&
+                            std::constructible_from<T, std::decay_t<Args> const&...>;
+
+  template <typename T, typename... Args>
+    requires replicable_from<T, Args...>
+  replica_factory<T> make_replica_factory(Args const&... args)
+  {
+    return [... args = std::decay_t<Args>(args)] { return std::make_shared<T>(args...); };
+  }
+
+  template <typename T>
+  class replicas {
+  public:
+    // The primary instance is the first replica.
+    replicas(std::shared_ptr<T> primary, replica_factory<T> make_replica) :
+      make_replica_{std::move(make_replica)},
+      resource_name_{fmt::format("replicas@{}", static_cast<void const*>(primary.get()))}
+    {
+      instances_.push_back(std::move(primary));
+      free_.push(0ull);
+    }
+
+    // Grows the pool to at least n instances; only called while registering algorithms.
+    void reserve(std::size_t const n)
+    {
+      while (instances_.size() < n) {
+        free_.push(instances_.size());
+        instances_.push_back(make_replica_());
+      }
+    }
+
+    std::size_t size() const noexcept { return instances_.size(); }
+
+    // Name of the shared resource that bounds the invocations of all algorithms bound to the
+    // replicas.
+    std::string const& resource_name() const noexcept { return resource_name_; }
+
+    template <typename FT, typename... Args>
+    decltype(auto) invoke(FT f, Args&&... args)
+    {
+      lease const l{free_};
+      return std::invoke(f, *instances_[l.index], std::forward<Args>(args)...);
+    }
+
+  private:
+    // The shared resource admits no more invocations than there are replicas, so an
+    // instance is always available.
+    struct lease {
+      explicit lease(tbb::concurrent_queue<std::size_t>& free) : free_{free}
+      {
+        if (not free_.try_pop(index)) {
+          throw std::runtime_error("No replica is available for the algorithm invocation.");
+        }
+      }
+      ~lease() { free_.push(index); }
+
+      tbb::concurrent_queue<std::size_t>& free_;
+      std::size_t index{};
+    };
+
+    replica_factory<T> make_replica_;
+    std::string resource_name_;
+    std::vector<std::shared_ptr<T>> instances_;
+    tbb::concurrent_queue<std::size_t> free_;
+  };
+
+  template <typename T>
+  using replicas_ptr = std::shared_ptr<replicas<T>>;
+
+  template <typename R, typename T, typename... Args>
+  auto delegate(replicas_ptr<T>& objs, R (T::*f)(Args...))
+  {
+    return std::function{
+      [t = objs, f](Args... args) mutable -> R { return t->invoke(f, args...); }};
+  }
+
+  template <typename R, typename T, typename... Args>
+  auto delegate(replicas_ptr<T>& objs, R (T::*f)(Args...) const)
+  {
+    return std::function{
+      [t = objs, f](Args... args) mutable -> R { return t->invoke(f, args...); }};
+  }
+}
+
+#endif // meld_core_replicas_hpp
@@ -31,6 +31,7 @@ namespace meld {
   protected:
     store_flag& flag_for(level_id::hash_type hash);
     bool done_with(product_store_const_ptr const& store);
+    std::size_t pending_flags() const { return flags_.size(); }
 
   private:
     using flags_t = tbb::concurrent_hash_map<level_id::hash_type, std::unique_ptr<store_flag>>;
@@ -66,6 +67,7 @@ namespace meld {
   protected:
     store_counter& counter_for(level_id::hash_type hash);
     std::unique_ptr<store_counter> done_with(level_id::hash_type hash);
+    std::size_t pending_counters() const { return counters_.size(); }
 
   private:
     using counters_t =
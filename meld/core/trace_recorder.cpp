@@ -0,0 +1,86 @@
+#include "meld/core/trace_recorder.hpp"
+#include "meld/model/level_id.hpp"
+#include "meld/utilities/escaped.hpp"
+
+#include "fmt/format.h"
+#include "oneapi/tbb/task_arena.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+  double to_microseconds(steady_clock::duration const d)
+  {
+    return duration_cast<nanoseconds>(d).count() / 1e3;
+  }
+}
+
+namespace meld {
+  trace_recorder::trace_recorder(std::size_t const events_per_thread) :
+    events_per_thread_{events_per_thread}
+  {
+    if (events_per_thread_ == 0ull) {
+      throw std::runtime_error("The trace buffer must hold at least one event per thread.");
+    }
+  }
+
+  void trace_recorder::record(std::string const& name,
+                              char const* kind,
+                              level_id_ptr const& id,
+                              clock::time_point const begin,
+                              clock::time_point const end)
+  {
+    auto& [events, recorded] = rings_.local();
+    if (events.empty()) {
+      events.resize(events_per_thread_);
+    }
+    events[recorded++ % events_per_thread_] = event{&name,
+                                                    kind,
+                                                    id ? id->hash() : 0ull,
+                                                    id ? id->number() : 0ull,
+                                                    begin,
+                                                    end,
+                                                    tbb::this_task_arena::current_thread_index()};
+  }
+
+  std::size_t trace_recorder::overwritten_events() const
+  {
+    std::size_t result{};
+    for (auto const& [events, recorded] : rings_) {
+      result += recorded - std::min(recorded, events.size());
+    }
+    return result;
+  }
+
+  void trace_recorder::write(std::string const& filename) const
+  {
+    std::ofstream file{filename};
+    if (!file) {
+      throw std::runtime_error("Cannot open trace file " + filename);
+    }
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (auto const& [events, recorded] : rings_) {
+      auto const n = std::min(recorded, events.size());
+      for (std::size_t i = recorded - n; i != recorded; ++i) {
+        auto const& e = events[i % events.size()];
+        file << (first ? "\n" : ",\n");
+        file << fmt::format(R"({{"name": "{}", "cat": "{}", "ph": "X", "ts": {:.3f}, )"
+                            R"("dur": {:.3f}, "pid": 0, "tid": {}, )"
+                            R"("args": {{"level": "{:016x}", "number": {}}}}})",
+                            escaped(*e.name),
+                            e.kind,
+                            to_microseconds(e.begin - origin_),
+                            to_microseconds(e.end - e.begin),
+                            e.thread_index,
+                            e.level_hash,
+                            e.level_number);
+        first = false;
+      }
+    }
+    file << "\n]}\n";
+  }
+}
@@ -0,0 +1,69 @@
+#ifndef meld_core_trace_recorder_hpp
+#define meld_core_trace_recorder_hpp
+
+// =======================================================================================
+// The trace_recorder records the beginning and end of each node invocation, together
+// with the hash and number of the level ID of the data being processed and the index of
+// the thread executing the invocation.  (The level ID itself is not kept, so that the
+// recorder neither touches its reference count nor keeps it alive.)  At the end of the
+// job, the events are written in the Chrome trace-event format, which can be viewed with
+// Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+//
+// Each thread records its events into its own fixed-size ring buffer, so that recording
+// requires neither locks nor allocations (beyond the creation of the buffer upon the
+// thread's first event).  Once a buffer is full, the oldest events of that thread are
+// overwritten.  Tracing is enabled with framework_graph::enable_tracing (or the 'meld'
+// option '--trace'); when it is disabled, nodes do not access the recorder at all.
+// =======================================================================================
+
+#include "meld/model/fwd.hpp"
+
+#include "oneapi/tbb/enumerable_thread_specific.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace meld {
+  class trace_recorder {
+  public:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::size_t default_events_per_thread{1ull << 16};
+
+    explicit trace_recorder(std::size_t events_per_thread = default_events_per_thread);
+
+    // The name and kind must outlive the recorder.
+    void record(std::string const& name,
+                char const* kind,
+                level_id_ptr const& id,
+                clock::time_point begin,
+                clock::time_point end);
+
+    // Must not be called while events are being recorded
+    void write(std::string const& filename) const;
+    std::size_t overwritten_events() const;
+
+  private:
+    struct event {
+      std::string const* name;
+      char const* kind;
+      std::size_t level_hash;
+      std::size_t level_number;
+      clock::time_point begin;
+      clock::time_point end;
+      int thread_index;
+    };
+
+    struct ring {
+      std::vector<event> events{};
+      std::size_t recorded{};
+    };
+
+    std::size_t events_per_thread_;
+    clock::time_point origin_{clock::now()};
+    tbb::enumerable_thread_specific<ring> rings_;
+  };
+}
+
+#endif // meld_core_trace_recorder_hpp
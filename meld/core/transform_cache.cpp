@@ -0,0 +1,131 @@
+#include "meld/core/transform_cache.hpp"
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+  // FNV-1a, evaluated with two different offset bases to form a 128-bit digest
+  constexpr std::uint64_t fnv_prime{0x100000001b3ull};
+
+  std::uint64_t fnv1a(std::uint64_t hash, std::string_view const bytes)
+  {
+    for (unsigned char const c : bytes) {
+      hash ^= c;
+      hash *= fnv_prime;
+    }
+    return hash;
+  }
+
+  std::uint64_t digest(std::uint64_t const basis,
+                       std::string_view const name,
+                       std::string_view const version,
+                       std::string_view const input_bytes)
+  {
+    auto hash = fnv1a(basis, name);
+    hash = fnv1a(hash, std::string_view{"\0", 1});
+    hash = fnv1a(hash, version);
+    hash = fnv1a(hash, std::string_view{"\0", 1});
+    return fnv1a(hash, input_bytes);
+  }
+}
+
+namespace meld {
+  void transform_cache::set_directory(std::filesystem::path directory)
+  {
+    std::filesystem::create_directories(directory);
+    directory_ = std::move(directory);
+  }
+
+  std::string transform_cache::make_key(algorithm_name const& name,
+                                        std::string_view const version,
+                                        std::string_view const input_bytes)
+  {
+    auto const full_name = name.full();
+    return fmt::format("{:016x}{:016x}",
+                       digest(0xcbf29ce484222325ull, full_name, version, input_bytes),
+                       digest(0x84222325cbf29ce4ull, full_name, version, input_bytes));
+  }
+
+  std::string transform_cache::make_identity(algorithm_name const& name,
+                                             std::string_view const version,
+                                             std::string_view const input_bytes)
+  {
+    auto const full_name = name.full();
+    std::string result;
+    for (std::string_view const part : {std::string_view{full_name}, version, input_bytes}) {
+      detail::append_length(result, part.size());
+      result += part;
+    }
+    return result;
+  }
+
+  std::optional<std::string> transform_cache::load(std::string const& key,
+                                                   std::string_view const identity) const
+  {
+    std::ifstream file{path_for(key), std::ios::binary};
+    if (not file) {
+      return std::nullopt;
+    }
+    std::string const entry{std::istreambuf_iterator<char>{file}, {}};
+
+    // An entry is the length of its identity, the identity, and the value.
+    std::uint64_t size{};
+    if (entry.size() < sizeof(size)) {
+      return std::nullopt;
+    }
+    std::memcpy(&size, entry.data(), sizeof(size));
+    std::string_view stored{entry};
+    stored.remove_prefix(sizeof(size));
+    if (size != identity.size() or not stored.starts_with(identity)) {
+      spdlog::debug("Transform-cache entry '{}' belongs to different inputs.", key);
+      return std::nullopt;
+    }
+    return entry.substr(sizeof(size) + size);
+  }
+
+  void transform_cache::store(std::string const& key,
+                              std::string_view const identity,
+                              std::string_view const value) const
+  {
+    // Entries are written to a temporary file (unique to the process and thread) and then
+    // renamed so that concurrent jobs never read a partially written entry.
+    auto const path = path_for(key);
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    auto tmp = path;
+    tmp += fmt::format(
+      ".{}.{}.tmp", ::getpid(), std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+      std::string header;
+      detail::append_length(header, identity.size());
+      std::ofstream file{tmp, std::ios::binary | std::ios::trunc};
+      file.write(header.data(), header.size());
+      file.write(identity.data(), identity.size());
+      file.write(value.data(), value.size());
+      if (not file.flush()) {
+        spdlog::warn("Could not write transform-cache entry '{}'.", tmp.string());
+        return;
+      }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+      spdlog::warn("Could not store transform-cache entry '{}': {}", path.string(), ec.message());
+      std::filesystem::remove(tmp, ec);
+    }
+  }
+
+  std::filesystem::path transform_cache::path_for(std::string const& key) const
+  {
+    // Entries are distributed over subdirectories to keep directory sizes manageable.
+    return directory_ / key.substr(0, 2) / key.substr(2);
+  }
+}
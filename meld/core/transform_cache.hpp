@@ -0,0 +1,188 @@
+#ifndef meld_core_transform_cache_hpp
+#define meld_core_transform_cache_hpp
+
+// =======================================================================================
+// The results of a transform can be cached on disk so that later jobs processing the
+// same inputs load the results instead of recomputing them.  Caching is enabled per
+// transform by specifying a version string for the transform's code:
+//
+//   g.with(calibrate).transform("hits").to("calibrated_hits").cached("v3");
+//
+// or, from a configuration file, with 'cache_version: "v3"'.  The directory of the cache
+// is specified with framework_graph::set_transform_cache (or the top-level configuration
+// key 'transform_cache').
+//
+// A cached result is identified by the transform's name, the version string, and the
+// contents of its input products.  The file name of an entry is a digest of these; the
+// entry itself also records them, and an entry whose record differs (i.e. a digest
+// collision) is treated as a miss.  The types of the inputs and outputs must therefore be
+// cacheable: a specialization of cache_traits is provided for arithmetic and enumeration
+// types, std::string, and std::vector and std::tuple of cacheable types; users may provide
+// specializations for their own types.  Requesting caching for a transform whose types are
+// not cacheable (including a transform that returns a future) is an error.
+//
+// The object representations of other trivially copyable classes may include padding or
+// pointers, which would make the keys unreliable.  Such a class is cached as its object
+// representation only if it is opted in explicitly:
+//
+//   template <>
+//   struct meld::cache_as_bytes<MyPod> : std::true_type {};
+// =======================================================================================
+
+#include "meld/model/algorithm_name.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace meld {
+
+  // Each specialization provides:
+  //
+  //   static void to_bytes(T const& t, std::string& out);  // Appends the bytes of t
+  //   static T from_bytes(std::string_view& bytes);        // Consumes the bytes of a T
+  template <typename T>
+  struct cache_traits;
+
+  template <typename T>
+  concept cacheable = requires(T const& t, std::string& out, std::string_view& bytes) {
+    cache_traits<T>::to_bytes(t, out);
+    { cache_traits<T>::from_bytes(bytes) } -> std::same_as<T>;
+  };
+
+  namespace detail {
+    inline std::string_view take_bytes(std::string_view& bytes, std::size_t const n)
+    {
+      if (bytes.size() < n) {
+        throw std::runtime_error("Cached value is truncated.");
+      }
+      auto const result = bytes.substr(0, n);
+      bytes.remove_prefix(n);
+      return result;
+    }
+
+    inline void append_length(std::string& out, std::uint64_t const n)
+    {
+      out.append(reinterpret_cast<char const*>(&n), sizeof(n));
+    }
+
+    inline std::uint64_t take_length(std::string_view& bytes)
+    {
+      std::uint64_t n{};
+      std::memcpy(&n, take_bytes(bytes, sizeof(n)).data(), sizeof(n));
+      return n;
+    }
+  }
+
+  template <typename T>
+  struct cache_as_bytes : std::bool_constant<std::is_arithmetic_v<T> or std::is_enum_v<T>> {};
+
+  template <typename T>
+    requires(cache_as_bytes<T>::value and std::is_trivially_copyable_v<T>)
+  struct cache_traits<T> {
+    static void to_bytes(T const& t, std::string& out)
+    {
+      out.append(reinterpret_cast<char const*>(&t), sizeof(T));
+    }
+    static T from_bytes(std::string_view& bytes)
+    {
+      std::array<std::byte, sizeof(T)> buffer;
+      std::memcpy(buffer.data(), detail::take_bytes(bytes, sizeof(T)).data(), sizeof(T));
+      return std::bit_cast<T>(buffer);
+    }
+  };
+
+  template <>
+  struct cache_traits<std::string> {
+    static void to_bytes(std::string const& s, std::string& out)
+    {
+      detail::append_length(out, s.size());
+      out += s;
+    }
+    static std::string from_bytes(std::string_view& bytes)
+    {
+      return std::string{detail::take_bytes(bytes, detail::take_length(bytes))};
+    }
+  };
+
+  template <cacheable T>
+  struct cache_traits<std::vector<T>> {
+    static void to_bytes(std::vector<T> const& v, std::string& out)
+    {
+      detail::append_length(out, v.size());
+      for (auto const& t : v) {
+        cache_traits<T>::to_bytes(t, out);
+      }
+    }
+    static std::vector<T> from_bytes(std::string_view& bytes)
+    {
+      std::vector<T> result;
+      auto const n = detail::take_length(bytes);
+      result.reserve(std::min<std::uint64_t>(n, bytes.size()));
+      for (std::uint64_t i = 0; i != n; ++i) {
+        result.push_back(cache_traits<T>::from_bytes(bytes));
+      }
+      return result;
+    }
+  };
+
+  template <cacheable... Ts>
+  struct cache_traits<std::tuple<Ts...>> {
+    static void to_bytes(std::tuple<Ts...> const& t, std::string& out)
+    {
+      std::apply([&out](auto const&... ts) { (cache_traits<Ts>::to_bytes(ts, out), ...); }, t);
+    }
+    static std::tuple<Ts...> from_bytes(std::string_view& bytes)
+    {
+      // Braced initialization guarantees left-to-right evaluation.
+      return std::tuple<Ts...>{cache_traits<Ts>::from_bytes(bytes)...};
+    }
+  };
+
+  // =====================================================================================
+
+  struct cache_counts {
+    std::size_t hits;
+    std::size_t misses;
+  };
+
+  class transform_cache {
+  public:
+    void set_directory(std::filesystem::path directory);
+    bool enabled() const noexcept { return not directory_.empty(); }
+
+    // The key is a digest of the algorithm name, the version string, and the input bytes.
+    static std::string make_key(algorithm_name const& name,
+                                std::string_view version,
+                                std::string_view input_bytes);
+
+    // The identity contains the algorithm name, the version string, and the input bytes
+    // themselves; it is stored with the value and compared upon loading.
+    static std::string make_identity(algorithm_name const& name,
+                                     std::string_view version,
+                                     std::string_view input_bytes);
+
+    // Returns the value only if the entry was stored with the same identity
+    std::optional<std::string> load(std::string const& key, std::string_view identity) const;
+    void store(std::string const& key, std::string_view identity, std::string_view value) const;
+
+  private:
+    std::filesystem::path path_for(std::string const& key) const;
+    std::filesystem::path directory_;
+  };
+}
+
+#endif // meld_core_transform_cache_hpp
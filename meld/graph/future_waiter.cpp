@@ -0,0 +1,87 @@
+#include "meld/graph/future_waiter.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+  constexpr std::chrono::microseconds min_poll_interval{50};
+  constexpr std::chrono::microseconds max_poll_interval{2000};
+}
+
+namespace meld {
+  future_waiter::future_waiter(tbb::flow::graph& g) :
+    async_{g,
+           tbb::flow::unlimited,
+           [this](pending_result const& result, async_t::gateway_type& gateway) {
+             // Balanced by the release_wait() call once the continuation has been handed
+             // back to the graph.
+             gateway.reserve_wait();
+             {
+               std::lock_guard lock{mutex_};
+               outstanding_.push_back(result);
+               if (not thread_.joinable()) {
+                 thread_ = std::thread{[this] { wait_for_results(); }};
+               }
+             }
+             cv_.notify_one();
+           }},
+    resume_{g, tbb::flow::unlimited, [](resume_t const& f) -> tbb::flow::continue_msg {
+              f();
+              return {};
+            }}
+  {
+    make_edge(async_, resume_);
+  }
+
+  future_waiter::~future_waiter()
+  {
+    {
+      std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void future_waiter::submit(ready_t ready, resume_t resume)
+  {
+    async_.try_put({std::move(ready), std::move(resume)});
+  }
+
+  void future_waiter::wait_for_results()
+  {
+    // Results polled by this thread only
+    std::vector<pending_result> pending;
+    auto interval = min_poll_interval;
+    while (true) {
+      {
+        std::unique_lock lock{mutex_};
+        if (pending.empty()) {
+          cv_.wait(lock, [this] { return stop_ or not outstanding_.empty(); });
+          if (outstanding_.empty()) {
+            return;
+          }
+        }
+        else {
+          cv_.wait_for(lock, interval, [this] { return not outstanding_.empty(); });
+        }
+        std::ranges::move(outstanding_, std::back_inserter(pending));
+        outstanding_.clear();
+      }
+
+      // The ready results are resumed in the order of submission.
+      auto const waiting = std::stable_partition(
+        begin(pending), end(pending), [](pending_result const& result) { return result.ready(); });
+      auto& gateway = async_.gateway();
+      for (auto it = begin(pending); it != waiting; ++it) {
+        gateway.try_put(std::move(it->resume));
+        gateway.release_wait();
+      }
+      interval =
+        waiting == begin(pending) ? std::min(2 * interval, max_poll_interval) : min_poll_interval;
+      pending.erase(begin(pending), waiting);
+    }
+  }
+}
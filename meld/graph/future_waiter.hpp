@@ -0,0 +1,74 @@
+#ifndef meld_graph_future_waiter_hpp
+#define meld_graph_future_waiter_hpp
+
+#include "oneapi/tbb/flow_graph.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace meld {
+
+  // The future_waiter supports algorithms that return futures.  Instead of blocking a TBB
+  // worker thread until the result is available, the worker submits the pending result to
+  // the waiter and returns to the scheduler.  The submitted results enter an async_node,
+  // whose gateway keeps the graph alive (so that graph::wait_for_all() does not return
+  // early) until the waiter thread hands each continuation back to the graph, where it is
+  // executed as a task.  The waiter thread polls the outstanding results, so that each
+  // continuation is handed back as soon as its result is ready, regardless of the order of
+  // submission; the polling interval grows while no result becomes ready.
+  //
+  // Results that are already available are resumed immediately by the submitting thread,
+  // as are deferred futures (std::launch::deferred), which are only evaluated when their
+  // value is retrieved and would otherwise never become ready.
+  class future_waiter {
+  public:
+    // The 'ready' function returns whether the result is available, without blocking.
+    using ready_t = std::function<bool()>;
+    using resume_t = std::function<void()>;
+
+    explicit future_waiter(tbb::flow::graph& g);
+    ~future_waiter();
+
+    void submit(ready_t ready, resume_t resume);
+
+    // The future must remain valid until the continuation has been invoked.
+    template <typename Future>
+    void submit(Future& future, resume_t resume)
+    {
+      if (future.wait_for(std::chrono::seconds::zero()) != std::future_status::timeout) {
+        resume();
+        return;
+      }
+      submit(
+        [&future] {
+          return future.wait_for(std::chrono::seconds::zero()) != std::future_status::timeout;
+        },
+        std::move(resume));
+    }
+
+  private:
+    struct pending_result {
+      ready_t ready;
+      resume_t resume;
+    };
+    using async_t = tbb::flow::async_node<pending_result, resume_t>;
+
+    void wait_for_results();
+
+    async_t async_;
+    tbb::flow::function_node<resume_t> resume_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<pending_result> outstanding_;
+    bool stop_{false};
+    std::thread thread_;
+  };
+}
+
+#endif // meld_graph_future_waiter_hpp
@@ -0,0 +1,181 @@
+#ifndef meld_graph_resource_gate_hpp
+#define meld_graph_resource_gate_hpp
+
+#include "meld/graph/serializer_node.hpp"
+
+#include "oneapi/tbb/flow_graph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace meld {
+
+  // A resource_gate is placed in front of a node whose function requires one or more
+  // shared resources.  A message passes through the gate only once a token has been
+  // acquired from the serializer of each resource--the tokens are acquired one resource
+  // at a time, in order of resource name, so that nodes sharing more than one resource
+  // cannot deadlock.  The node must return the tokens (see 'release') once its function
+  // has been invoked for the message.
+  //
+  // Tokens are held only by messages that the node is ready to execute: if the node's
+  // concurrency is limited, the gate first admits no more messages than the node may
+  // process at once, and the node itself is then constructed with unlimited concurrency.
+  // Messages for which the node does not invoke its function (e.g. flush messages) bypass
+  // the gate without acquiring any tokens.
+  class resource_gate_base {
+  public:
+    explicit resource_gate_base(std::vector<serializer_node*> resources) :
+      resources_{std::move(resources)}
+    {
+      std::ranges::sort(resources_, {}, &serializer_node::name);
+      auto const [b, e] = std::ranges::unique(resources_);
+      resources_.erase(b, e);
+    }
+
+    void release()
+    {
+      for (auto* resource : resources_) {
+        resource->try_put(1);
+      }
+      if (admitted_) {
+        admitted_->try_put(tbb::flow::continue_msg{});
+      }
+    }
+
+  protected:
+    std::vector<serializer_node*> resources_;
+    tbb::flow::receiver<tbb::flow::continue_msg>* admitted_{nullptr};
+  };
+
+  template <typename T>
+  class resource_gate : public resource_gate_base {
+    using bypass_t = std::function<bool(T const&)>;
+    using route_t = tbb::flow::multifunction_node<T, std::tuple<T, T>>;
+
+    struct stage {
+      stage(tbb::flow::graph& g, serializer_node& resource) :
+        buffer{g},
+        join{g},
+        acquire{g, tbb::flow::unlimited, [](std::tuple<T, token_t> const& held) {
+                  return std::get<0>(held);
+                }}
+      {
+        make_edge(buffer, input_port<0>(join));
+        make_edge(resource, input_port<1>(join));
+        make_edge(join, acquire);
+      }
+
+      tbb::flow::buffer_node<T> buffer;
+      tbb::flow::join_node<std::tuple<T, token_t>, tbb::flow::reserving> join;
+      tbb::flow::function_node<std::tuple<T, token_t>, T> acquire;
+    };
+
+  public:
+    resource_gate(tbb::flow::graph& g,
+                  std::size_t const concurrency,
+                  std::vector<serializer_node*> resources,
+                  bypass_t bypass) :
+      resource_gate_base{std::move(resources)},
+      route_{g,
+             tbb::flow::unlimited,
+             [bypass = std::move(bypass)](T const& msg, auto& outputs) {
+               if (bypass(msg)) {
+                 std::get<0>(outputs).try_put(msg);
+               }
+               else {
+                 std::get<1>(outputs).try_put(msg);
+               }
+             }},
+      output_{g}
+    {
+      for (auto* resource : resources_) {
+        stages_.push_back(std::make_unique<stage>(g, *resource));
+      }
+      for (std::size_t i = 1; i < stages_.size(); ++i) {
+        make_edge(stages_[i - 1]->acquire, stages_[i]->buffer);
+      }
+      make_edge(output_port<0>(route_), output_);
+      make_edge(stages_.back()->acquire, output_);
+
+      if (concurrency == tbb::flow::unlimited) {
+        make_edge(output_port<1>(route_), stages_.front()->buffer);
+        return;
+      }
+      pending_ = std::make_unique<tbb::flow::buffer_node<T>>(g);
+      limiter_ = std::make_unique<tbb::flow::limiter_node<T>>(g, concurrency);
+      admitted_ = &limiter_->decrementer();
+      make_edge(output_port<1>(route_), *pending_);
+      make_edge(*pending_, *limiter_);
+      make_edge(*limiter_, stages_.front()->buffer);
+    }
+
+    tbb::flow::receiver<T>& input() { return route_; }
+    tbb::flow::sender<T>& output() { return output_; }
+
+  private:
+    route_t route_;
+    tbb::flow::broadcast_node<T> output_;
+    std::vector<std::unique_ptr<stage>> stages_;
+    std::unique_ptr<tbb::flow::buffer_node<T>> pending_;
+    std::unique_ptr<tbb::flow::limiter_node<T>> limiter_;
+  };
+
+  // Returns a null pointer if the node requires no resources.
+  template <typename T>
+  std::unique_ptr<resource_gate<T>> make_resource_gate(tbb::flow::graph& g,
+                                                       std::size_t const concurrency,
+                                                       std::vector<serializer_node*> resources,
+                                                       std::function<bool(T const&)> bypass)
+  {
+    if (resources.empty()) {
+      return nullptr;
+    }
+    return std::make_unique<resource_gate<T>>(
+      g, concurrency, std::move(resources), std::move(bypass));
+  }
+
+  // The concurrency with which a node must be constructed
+  template <typename T>
+  std::size_t concurrency_behind(std::unique_ptr<resource_gate<T>> const& gate,
+                                 std::size_t const concurrency)
+  {
+    return gate ? tbb::flow::unlimited : concurrency;
+  }
+
+  // Connects the sender to the receiver, through the gate if one is present.
+  template <typename T>
+  void make_edges_through(tbb::flow::sender<T>& sender,
+                          std::unique_ptr<resource_gate<T>> const& gate,
+                          tbb::flow::receiver<T>& receiver)
+  {
+    if (not gate) {
+      make_edge(sender, receiver);
+      return;
+    }
+    make_edge(sender, gate->input());
+    make_edge(gate->output(), receiver);
+  }
+
+  // Returns the tokens held for a message when it goes out of scope.
+  class held_resources {
+  public:
+    explicit held_resources(resource_gate_base* gate) : gate_{gate} {}
+    held_resources(held_resources const&) = delete;
+    held_resources& operator=(held_resources const&) = delete;
+    ~held_resources()
+    {
+      if (gate_) {
+        gate_->release();
+      }
+    }
+
+  private:
+    resource_gate_base* gate_;
+  };
+}
+
+#endif // meld_graph_resource_gate_hpp
@@ -5,6 +5,7 @@
 
 #include "oneapi/tbb/flow_graph.h"
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <tuple>
@@ -15,24 +16,34 @@ namespace meld {
   using base_impl = tbb::flow::buffer_node<token_t>;
   class serializer_node : public base_impl {
   public:
-    explicit serializer_node(tbb::flow::graph& g, std::string const& name) :
-      base_impl{g}, name_{name}
+    explicit serializer_node(tbb::flow::graph& g,
+                             std::string const& name,
+                             std::size_t const capacity = 1ull) :
+      base_impl{g}, name_{name}, capacity_{capacity}
     {
     }
 
+    // The capacity is the number of tokens (i.e. the number of simultaneous holders of the
+    // resource) made available upon activation.
+    void set_capacity(std::size_t const capacity) { capacity_ = capacity; }
+
     void activate()
     {
       // The serializer must not be activated until it resides in its final resting spot.
       // IOW, if a container of serializers grows, the locations of the serializers can
       // move around, introducing memory errors if try_put(...) has been attempted in a
       // different location than when it's used during the graph execution.
-      try_put(1);
+      for (std::size_t i = 0; i != capacity_; ++i) {
+        try_put(1);
+      }
     }
 
     auto const& name() const { return name_; }
+    auto capacity() const { return capacity_; }
 
   private:
     std::string name_;
+    std::size_t capacity_;
   };
 
   class serializers {
@@ -0,0 +1,91 @@
+#include "meld/io/codec.hpp"
+
+#include <stdexcept>
+
+#ifdef MELD_HAVE_ZLIB
+#include "zlib.h"
+#endif
+
+using namespace std::string_literals;
+
+namespace meld {
+  codec default_codec() noexcept
+  {
+#ifdef MELD_HAVE_ZLIB
+    return codec::zlib;
+#else
+    return codec::none;
+#endif
+  }
+
+  codec codec_from(std::string_view const name)
+  {
+    if (name == "none") {
+      return codec::none;
+    }
+    if (name == "zlib") {
+#ifdef MELD_HAVE_ZLIB
+      return codec::zlib;
+#else
+      throw std::runtime_error("The zlib codec is not available in this build of meld.");
+#endif
+    }
+    throw std::runtime_error("Unknown codec '"s + std::string(name) + "'.");
+  }
+
+  std::string_view to_string(codec const c) noexcept
+  {
+    switch (c) {
+    case codec::none:
+      return "none";
+    case codec::zlib:
+      return "zlib";
+    }
+    return "unknown";
+  }
+
+  std::string compress(codec const c, std::string_view const raw)
+  {
+    if (c == codec::none) {
+      return std::string(raw);
+    }
+#ifdef MELD_HAVE_ZLIB
+    std::string result(compressBound(raw.size()), '\0');
+    auto size = static_cast<uLongf>(result.size());
+    if (compress2(reinterpret_cast<Bytef*>(result.data()),
+                  &size,
+                  reinterpret_cast<Bytef const*>(raw.data()),
+                  raw.size(),
+                  Z_BEST_SPEED) != Z_OK) {
+      throw std::runtime_error("Failed to compress columnar chunk.");
+    }
+    result.resize(size);
+    return result;
+#else
+    throw std::runtime_error("The zlib codec is not available in this build of meld.");
+#endif
+  }
+
+  std::string decompress(codec const c,
+                         std::string_view const compressed,
+                         [[maybe_unused]] std::size_t const raw_size)
+  {
+    if (c == codec::none) {
+      return std::string(compressed);
+    }
+#ifdef MELD_HAVE_ZLIB
+    std::string result(raw_size, '\0');
+    auto size = static_cast<uLongf>(raw_size);
+    if (uncompress(reinterpret_cast<Bytef*>(result.data()),
+                   &size,
+                   reinterpret_cast<Bytef const*>(compressed.data()),
+                   compressed.size()) != Z_OK or
+        size != raw_size) {
+      throw std::runtime_error("Failed to decompress columnar chunk.");
+    }
+    return result;
+#else
+    throw std::runtime_error("The zlib codec is not available in this build of meld.");
+#endif
+  }
+}
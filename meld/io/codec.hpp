@@ -0,0 +1,21 @@
+#ifndef meld_io_codec_hpp
+#define meld_io_codec_hpp
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace meld {
+  // Compression codecs for the chunks of a columnar file.  The zlib codec is available
+  // only if zlib was found when meld was built.
+  enum class codec { none, zlib };
+
+  codec default_codec() noexcept;
+  codec codec_from(std::string_view name);
+  std::string_view to_string(codec c) noexcept;
+
+  std::string compress(codec c, std::string_view raw);
+  std::string decompress(codec c, std::string_view compressed, std::size_t raw_size);
+}
+
+#endif // meld_io_codec_hpp
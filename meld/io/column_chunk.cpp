@@ -0,0 +1,110 @@
+#include "meld/io/column_chunk.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+  std::atomic<std::uint64_t> decompressed_value_blocks_{};
+
+  void require(bool const condition)
+  {
+    if (not condition) {
+      throw std::runtime_error("A chunk of the columnar file is corrupt.");
+    }
+  }
+
+  std::uint64_t checked_product(std::uint64_t const a, std::uint64_t const b)
+  {
+    require(b == 0ull or a <= std::numeric_limits<std::uint64_t>::max() / b);
+    return a * b;
+  }
+}
+
+namespace meld {
+  column_chunk::column_chunk(std::shared_ptr<mapped_file const> file,
+                             column_info const& column,
+                             chunk_info const& chunk) :
+    file_{std::move(file)},
+    rows_{chunk.rows},
+    depth_{column.depth()},
+    width_{column.width},
+    compression_{chunk.compression},
+    index_{file_->view(chunk.index_offset, chunk.index_size),
+           checked_product(chunk.rows, checked_product(column.depth(), sizeof(std::uint64_t)))},
+    values_{file_->view(chunk.offset, chunk.size), chunk.raw_size}
+  {
+    // The sizes are checked once, so that rows can be accessed without further checks.
+    if (width_ != 0ull) {
+      require(values_.raw_size == checked_product(rows_, width_));
+    }
+    else {
+      require(rows_ < std::numeric_limits<std::uint64_t>::max() and
+              values_.raw_size >= checked_product(rows_ + 1, sizeof(std::uint64_t)));
+    }
+
+    if (compression_ == codec::none) {
+      require(index_.stored.size() == index_.raw_size);
+      require(values_.stored.size() == values_.raw_size);
+      check_offsets(values_.stored);
+    }
+  }
+
+  void column_chunk::check_offsets(std::string_view const values) const
+  {
+    if (width_ != 0ull) {
+      return;
+    }
+    // Each value is bounded by consecutive offsets (checked upon access), the last of
+    // which is the size of the serialized values.
+    auto const offsets_size = (rows_ + 1) * sizeof(std::uint64_t);
+    std::uint64_t last{};
+    std::memcpy(&last, values.data() + rows_ * sizeof(std::uint64_t), sizeof(last));
+    require(last <= values.size() - offsets_size);
+  }
+
+  std::uint64_t column_chunk::decompressed_value_blocks() noexcept
+  {
+    return decompressed_value_blocks_.load();
+  }
+
+  std::string_view column_chunk::data(block const& b) const
+  {
+    if (compression_ == codec::none) {
+      return b.stored;
+    }
+    std::call_once(b.decompressed_flag, [this, &b] {
+      b.decompressed = decompress(compression_, b.stored, b.raw_size);
+      require(b.decompressed.size() == b.raw_size);
+      if (&b == &values_) {
+        check_offsets(b.decompressed);
+        ++decompressed_value_blocks_;
+      }
+    });
+    return b.decompressed;
+  }
+
+  std::uint64_t column_chunk::level_number(std::size_t const row, std::size_t const depth) const
+  {
+    std::uint64_t result{};
+    std::memcpy(&result,
+                data(index_).data() + (row * depth_ + depth) * sizeof(std::uint64_t),
+                sizeof(result));
+    return result;
+  }
+
+  std::string_view column_chunk::value(std::size_t const row) const
+  {
+    auto const values = data(values_);
+    if (width_ != 0ull) {
+      return values.substr(row * width_, width_);
+    }
+
+    std::uint64_t offsets[2];
+    std::memcpy(offsets, values.data() + row * sizeof(std::uint64_t), sizeof(offsets));
+    auto const serialized = values.substr((rows_ + 1) * sizeof(std::uint64_t));
+    require(offsets[0] <= offsets[1] and offsets[1] <= serialized.size());
+    return serialized.substr(offsets[0], offsets[1] - offsets[0]);
+  }
+}
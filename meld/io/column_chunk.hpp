@@ -0,0 +1,60 @@
+#ifndef meld_io_column_chunk_hpp
+#define meld_io_column_chunk_hpp
+
+#include "meld/io/columnar_format.hpp"
+#include "meld/io/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace meld {
+  // One chunk of a column of a memory-mapped columnar file.  Uncompressed chunks are
+  // viewed directly in the mapping.  Each block of a compressed chunk is decompressed the
+  // first time its contents are accessed: retrieving level numbers does not decompress
+  // the values.  The sizes of the blocks are checked against the numbers of rows and
+  // levels when the chunk is created (or when a block is decompressed); a chunk that is
+  // inconsistent with them results in an exception rather than an out-of-bounds read.
+  class column_chunk {
+  public:
+    column_chunk(std::shared_ptr<mapped_file const> file,
+                 column_info const& column,
+                 chunk_info const& chunk);
+
+    std::uint64_t rows() const noexcept { return rows_; }
+    std::size_t width() const noexcept { return width_; }
+
+    // The level number at the specified depth (0 is the top of the hierarchy) of the store
+    // to which the row belongs
+    std::uint64_t level_number(std::size_t row, std::size_t depth) const;
+
+    // The bytes of the value for the row
+    std::string_view value(std::size_t row) const;
+
+    // The number of value blocks decompressed by all chunks of the process
+    static std::uint64_t decompressed_value_blocks() noexcept;
+
+  private:
+    struct block {
+      std::string_view stored;
+      std::uint64_t raw_size;
+      mutable std::once_flag decompressed_flag{};
+      mutable std::string decompressed{};
+    };
+    std::string_view data(block const& b) const;
+    void check_offsets(std::string_view values) const;
+
+    std::shared_ptr<mapped_file const> file_;
+    std::uint64_t rows_;
+    std::size_t depth_;
+    std::size_t width_;
+    codec compression_;
+    block index_;
+    block values_;
+  };
+}
+
+#endif // meld_io_column_chunk_hpp
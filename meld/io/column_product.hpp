@@ -0,0 +1,62 @@
+#ifndef meld_io_column_product_hpp
+#define meld_io_column_product_hpp
+
+#include "meld/io/column_chunk.hpp"
+#include "meld/model/products.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace meld {
+  // A product whose value resides in a column of a memory-mapped columnar file.  Nothing
+  // is read from the file until the product is first retrieved (see products::get).  For
+  // types with portable bytes stored in uncompressed chunks, the product is a view into the
+  // mapping itself; otherwise, the value is copied or deserialized at that point.
+  template <typename T>
+  class column_product : public lazy_product<T> {
+  public:
+    using from_bytes_t = std::function<T(std::string_view)>;
+
+    column_product(std::shared_ptr<column_chunk const> chunk,
+                   std::size_t const row,
+                   from_bytes_t const& from_bytes) :
+      chunk_{std::move(chunk)}, row_{row}, from_bytes_{from_bytes}
+    {
+    }
+
+    // The column data are owned by the (shared) chunk, not by the product.
+    std::size_t memory_size() const final { return sizeof(*this); }
+
+  private:
+    void const* materialize() const final
+    {
+      auto const value = chunk_->value(row_);
+      if constexpr (has_portable_bytes_v<T>) {
+        if (chunk_->width() == sizeof(T)) {
+          if (reinterpret_cast<std::uintptr_t>(value.data()) % alignof(T) == 0) {
+            return value.data();
+          }
+          return std::memcpy(copy_.emplace().bytes, value.data(), sizeof(T));
+        }
+      }
+      return &deserialized_.emplace(from_bytes_(value));
+    }
+
+    struct aligned_copy {
+      alignas(T) std::byte bytes[sizeof(T)];
+    };
+
+    std::shared_ptr<column_chunk const> chunk_;
+    std::size_t row_;
+    from_bytes_t const& from_bytes_;
+    mutable std::optional<aligned_copy> copy_;
+    mutable std::optional<T> deserialized_;
+  };
+}
+
+#endif // meld_io_column_product_hpp
@@ -0,0 +1,76 @@
+#include "meld/io/column_types.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace {
+  class column_serializers {
+  public:
+    column_serializers()
+    {
+      add<bool,
+          char,
+          signed char,
+          unsigned char,
+          short,
+          unsigned short,
+          int,
+          unsigned int,
+          long,
+          unsigned long,
+          long long,
+          unsigned long long,
+          float,
+          double,
+          long double>();
+      add(typeid(std::string).name(),
+          std::make_unique<meld::column_serializer<std::string>>(
+            [](std::string const& str, std::string& out) { out += str; },
+            [](std::string_view bytes) { return std::string(bytes); }));
+    }
+
+    template <typename... Ts>
+    void add()
+    {
+      (add(typeid(Ts).name(), std::make_unique<meld::column_serializer<Ts>>(nullptr, nullptr)),
+       ...);
+    }
+
+    void add(char const* type_name, std::unique_ptr<meld::column_serializer_base> serializer)
+    {
+      std::lock_guard lock{mutex_};
+      // The first registration wins; pointers to registered serializers must remain valid.
+      serializers_.try_emplace(type_name, std::move(serializer));
+    }
+
+    meld::column_serializer_base const* find(char const* type_name) const
+    {
+      std::lock_guard lock{mutex_};
+      auto it = serializers_.find(type_name);
+      return it != serializers_.end() ? it->second.get() : nullptr;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<meld::column_serializer_base>> serializers_;
+  };
+
+  column_serializers& serializers()
+  {
+    static column_serializers result;
+    return result;
+  }
+}
+
+namespace meld::detail {
+  void register_column_serializer(char const* type_name,
+                                  std::unique_ptr<column_serializer_base> serializer)
+  {
+    serializers().add(type_name, std::move(serializer));
+  }
+
+  column_serializer_base const* find_column_serializer(char const* type_name)
+  {
+    return serializers().find(type_name);
+  }
+}
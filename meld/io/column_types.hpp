@@ -0,0 +1,107 @@
+#ifndef meld_io_column_types_hpp
+#define meld_io_column_types_hpp
+
+// =======================================================================================
+// Products are written to columnar files either as their object representations (for
+// types with portable bytes--see has_portable_bytes in meld/model/products.hpp) or through
+// serializers registered by the user:
+//
+//   meld::register_column_type<std::vector<int>>(
+//     [](std::vector<int> const& v, std::string& out) { ... append bytes to out ... },
+//     [](std::string_view bytes) { ... return std::vector<int>{...}; });
+//
+// Reading products from a columnar file (see columnar_source) additionally requires that
+// types with portable bytes other than the arithmetic types be registered:
+//
+//   meld::register_column_type<MyPod>();
+//
+// The arithmetic types and std::string are registered by default.
+// =======================================================================================
+
+#include "meld/io/column_product.hpp"
+
+#include "boost/core/demangle.hpp"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+
+namespace meld {
+  struct column_serializer_base {
+    virtual ~column_serializer_base() = default;
+    virtual void serialize(void const* obj, std::string& out) const = 0;
+    virtual std::unique_ptr<product_base> make_product(std::shared_ptr<column_chunk const> chunk,
+                                                       std::size_t row) const = 0;
+  };
+
+  template <typename T>
+  struct column_serializer : column_serializer_base {
+    using to_bytes_t = std::function<void(T const&, std::string&)>;
+    using from_bytes_t = std::function<T(std::string_view)>;
+
+    column_serializer(to_bytes_t to, from_bytes_t from) :
+      to_bytes{std::move(to)}, from_bytes{std::move(from)}
+    {
+    }
+
+    void serialize(void const* obj, std::string& out) const final
+    {
+      to_bytes(*static_cast<T const*>(obj), out);
+    }
+
+    std::unique_ptr<product_base> make_product(std::shared_ptr<column_chunk const> chunk,
+                                               std::size_t const row) const final
+    {
+      return std::make_unique<column_product<T>>(std::move(chunk), row, from_bytes);
+    }
+
+    to_bytes_t to_bytes;
+    from_bytes_t from_bytes;
+  };
+
+  namespace detail {
+    // As with products::get, types are matched by name so that serializers may be
+    // registered from other shared libraries.
+    void register_column_serializer(char const* type_name,
+                                    std::unique_ptr<column_serializer_base> serializer);
+    column_serializer_base const* find_column_serializer(char const* type_name);
+  }
+
+  template <typename T>
+  void register_column_type(typename column_serializer<T>::to_bytes_t to_bytes,
+                            typename column_serializer<T>::from_bytes_t from_bytes)
+  {
+    detail::register_column_serializer(
+      typeid(T).name(),
+      std::make_unique<column_serializer<T>>(std::move(to_bytes), std::move(from_bytes)));
+  }
+
+  template <typename T>
+    requires has_portable_bytes_v<T>
+  void register_column_type()
+  {
+    register_column_type<T>(nullptr, nullptr);
+  }
+
+  inline column_serializer_base const* find_column_serializer(std::type_index const type)
+  {
+    return detail::find_column_serializer(type.name());
+  }
+
+  template <typename T>
+  column_serializer<T> const& column_serializer_for()
+  {
+    if (auto const* serializer = detail::find_column_serializer(typeid(T).name())) {
+      return *static_cast<column_serializer<T> const*>(serializer);
+    }
+    throw std::runtime_error("No column serializer has been registered for type '" +
+                             boost::core::demangle(typeid(T).name()) + "'.");
+  }
+}
+
+#endif // meld_io_column_types_hpp
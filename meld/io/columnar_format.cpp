@@ -0,0 +1,154 @@
+#include "meld/io/columnar_format.hpp"
+
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+  class footer_writer {
+  public:
+    void put(std::uint64_t const value)
+    {
+      footer_.append(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+    void put(std::string_view const str)
+    {
+      put(str.size());
+      footer_ += str;
+    }
+    std::string release() { return std::move(footer_); }
+
+  private:
+    std::string footer_;
+  };
+
+  class footer_reader {
+  public:
+    explicit footer_reader(std::string_view const footer) : footer_{footer} {}
+
+    std::uint64_t number()
+    {
+      std::uint64_t result{};
+      std::memcpy(&result, take(sizeof(result)).data(), sizeof(result));
+      return result;
+    }
+    std::string string() { return std::string(take(number())); }
+
+    // A number of entries, each of which occupies at least 'min_entry_size' bytes of the
+    // remainder of the footer
+    std::uint64_t count(std::size_t const min_entry_size)
+    {
+      auto const result = number();
+      if (result > footer_.size() / min_entry_size) {
+        throw std::runtime_error("The footer of the columnar file is corrupt.");
+      }
+      return result;
+    }
+
+  private:
+    std::string_view take(std::size_t const n)
+    {
+      if (n > footer_.size()) {
+        throw std::runtime_error("The footer of the columnar file is corrupt.");
+      }
+      auto result = footer_.substr(0, n);
+      footer_.remove_prefix(n);
+      return result;
+    }
+
+    std::string_view footer_;
+  };
+}
+
+namespace meld {
+  std::string column_info::level_path() const
+  {
+    std::string result;
+    for (auto const& name : levels) {
+      if (not result.empty()) {
+        result += '/';
+      }
+      result += name;
+    }
+    return result;
+  }
+
+  std::uint64_t column_info::rows() const noexcept
+  {
+    return std::accumulate(
+      begin(chunks), end(chunks), std::uint64_t{}, [](auto sum, auto const& c) {
+        return sum + c.rows;
+      });
+  }
+
+  std::string columnar_footer(std::vector<column_info> const& columns)
+  {
+    footer_writer footer;
+    footer.put(columns.size());
+    for (auto const& column : columns) {
+      footer.put(column.level);
+      footer.put(column.product);
+      footer.put(column.type);
+      footer.put(column.type_id);
+      footer.put(column.width);
+      footer.put(column.levels.size());
+      for (auto const& level : column.levels) {
+        footer.put(level);
+      }
+      footer.put(column.chunks.size());
+      for (auto const& chunk : column.chunks) {
+        footer.put(chunk.index_offset);
+        footer.put(chunk.index_size);
+        footer.put(chunk.offset);
+        footer.put(chunk.size);
+        footer.put(chunk.raw_size);
+        footer.put(chunk.rows);
+        footer.put(to_string(chunk.compression));
+      }
+    }
+    return footer.release();
+  }
+
+  std::vector<column_info> columns_from_footer(std::string_view const raw_footer,
+                                              std::uint64_t const data_size)
+  {
+    // Minimum sizes of the entries: every number and string length takes 8 bytes.
+    constexpr std::size_t number_size{sizeof(std::uint64_t)};
+    constexpr std::size_t min_column_size{7 * number_size};
+    constexpr std::size_t min_level_size{number_size};
+    constexpr std::size_t min_chunk_size{7 * number_size};
+
+    auto within_data = [data_size](std::uint64_t const offset, std::uint64_t const size) {
+      return offset <= data_size and size <= data_size - offset;
+    };
+
+    footer_reader footer{raw_footer};
+    std::vector<column_info> result(footer.count(min_column_size));
+    for (auto& column : result) {
+      column.level = footer.string();
+      column.product = footer.string();
+      column.type = footer.string();
+      column.type_id = footer.string();
+      column.width = footer.number();
+      column.levels.resize(footer.count(min_level_size));
+      for (auto& level : column.levels) {
+        level = footer.string();
+      }
+      column.chunks.resize(footer.count(min_chunk_size));
+      for (auto& chunk : column.chunks) {
+        chunk.index_offset = footer.number();
+        chunk.index_size = footer.number();
+        chunk.offset = footer.number();
+        chunk.size = footer.number();
+        chunk.raw_size = footer.number();
+        chunk.rows = footer.number();
+        chunk.compression = codec_from(footer.string());
+        if (not within_data(chunk.index_offset, chunk.index_size) or
+            not within_data(chunk.offset, chunk.size)) {
+          throw std::runtime_error("The footer of the columnar file is corrupt.");
+        }
+      }
+    }
+    return result;
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef meld_io_columnar_format_hpp
+#define meld_io_columnar_format_hpp
+
+// =======================================================================================
+// Layout of a meld columnar file
+//
+//   magic                  8 bytes ("MELDCOL2")
+//   chunk 0 of column a    index block, value block (each block begins at a multiple of
+//   chunk 0 of column b    ...                       'columnar_alignment')
+//   chunk 1 of column a    ...
+//   ...
+//   footer                 description of all columns and chunks (see columnar_footer)
+//   footer size            8 bytes
+//   magic                  8 bytes
+//
+// A column holds the values of one product for all stores with the same level path (e.g.
+// the "hits" product of the "run/event" stores).  The two blocks of each chunk are
+// compressed independently, so that the stores to which the rows belong can be determined
+// without decompressing any values.  The uncompressed index block is:
+//
+//   rows x depth       level numbers (std::uint64_t) of the store to which each row belongs
+//
+// and the uncompressed value block is:
+//
+//   rows x width       values, if the column has a fixed width (types with portable bytes)
+//   or
+//   (rows + 1)         value offsets (std::uint64_t), followed by the serialized values
+//
+// All integers are written in the byte order of the host.
+// =======================================================================================
+
+#include "meld/io/codec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace meld {
+  inline constexpr std::string_view columnar_magic{"MELDCOL2"};
+  inline constexpr std::size_t columnar_alignment{16};
+
+  struct chunk_info {
+    std::uint64_t index_offset;
+    std::uint64_t index_size; // Stored size of the index block
+    std::uint64_t offset;     // Offset of the value block
+    std::uint64_t size;       // Stored size of the value block
+    std::uint64_t raw_size;   // Uncompressed size of the value block
+    std::uint64_t rows;
+    codec compression;
+  };
+
+  struct column_info {
+    std::string level;
+    std::string product;
+    std::string type;                // Demangled name of the product type
+    std::string type_id;             // Name of the product type as given by std::type_info
+    std::size_t width;               // Size of each value, or 0 for serialized values
+    std::vector<std::string> levels; // Level names from the top of the hierarchy to 'level'
+    std::vector<chunk_info> chunks;
+
+    std::size_t depth() const noexcept { return levels.size(); }
+    std::string level_path() const; // E.g. "run/event"
+    std::uint64_t rows() const noexcept;
+  };
+
+  // The footer is a sequence of unsigned integers (std::uint64_t) and strings (each
+  // preceded by its length): the number of columns, followed by each column's level,
+  // product, type, type ID, width, number of levels, level names, number of chunks, and the
+  // index offset, index size, offset, size, raw size, number of rows, and codec of each
+  // chunk.
+  std::string columnar_footer(std::vector<column_info> const& columns);
+
+  // The blocks of all chunks must lie within the first 'data_size' bytes of the file
+  // (i.e. before the footer); otherwise, or if the footer is truncated, an exception is
+  // thrown.
+  std::vector<column_info> columns_from_footer(std::string_view footer,
+                                               std::uint64_t data_size);
+}
+
+#endif // meld_io_columnar_format_hpp
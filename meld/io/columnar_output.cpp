@@ -0,0 +1,356 @@
+#include "meld/io/columnar_output.hpp"
+#include "meld/utilities/sync_file.hpp"
+
+#include "boost/core/demangle.hpp"
+#include "spdlog/spdlog.h"
+
+#include <cstring>
+#include <filesystem>
+#include <ranges>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+  template <typename T>
+  void append(std::string& out, T const& t)
+  {
+    out.append(reinterpret_cast<char const*>(&t), sizeof(T));
+  }
+
+  void append_bytes(std::string& out, std::string_view const bytes)
+  {
+    append(out, static_cast<std::uint64_t>(bytes.size()));
+    out += bytes;
+  }
+
+  // Reads the entries of a saved state in the order they were appended
+  class state_reader {
+  public:
+    state_reader(std::string_view const state, std::string const& filename) :
+      state_{state}, filename_{filename}
+    {
+    }
+
+    std::uint64_t number()
+    {
+      std::uint64_t result{};
+      std::memcpy(&result, take(sizeof(result)).data(), sizeof(result));
+      return result;
+    }
+    std::string_view bytes() { return take(number()); }
+
+  private:
+    std::string_view take(std::size_t const n)
+    {
+      if (n > state_.size()) {
+        throw std::runtime_error("The saved state of columnar file '" + filename_ +
+                                 "' is corrupt.");
+      }
+      auto result = state_.substr(0, n);
+      state_.remove_prefix(n);
+      return result;
+    }
+
+    std::string_view state_;
+    std::string const& filename_;
+  };
+
+  void append_index(std::string& out, meld::level_id const& id)
+  {
+    std::vector<std::uint64_t> numbers(id.depth());
+    auto const* current = &id;
+    for (std::size_t i = id.depth(); i > 0; --i) {
+      numbers[i - 1] = current->number();
+      current = current->parent().get();
+    }
+    out.append(reinterpret_cast<char const*>(numbers.data()),
+               numbers.size() * sizeof(std::uint64_t));
+  }
+
+  std::vector<std::string> level_names(meld::level_id const& id)
+  {
+    std::vector<std::string> result(id.depth());
+    auto const* current = &id;
+    for (std::size_t i = id.depth(); i > 0; --i) {
+      result[i - 1] = current->level_name();
+      current = current->parent().get();
+    }
+    return result;
+  }
+
+  std::size_t level_hash(std::vector<std::string> const& levels)
+  {
+    auto id = meld::level_id::base_ptr();
+    for (auto const& name : levels) {
+      id = id->make_child(0, name);
+    }
+    return id->level_hash();
+  }
+}
+
+namespace meld {
+  columnar_output::columnar_output(std::string const& filename, columnar_output_options options) :
+    filename_{filename},
+    options_{std::move(options)},
+    selected_(options_.products.begin(), options_.products.end())
+  {
+    // The file is not truncated until the first write so that a resumed job (see
+    // restore()) can continue writing the file of the failed job.
+    if (not std::ofstream{filename, std::ios::binary | std::ios::app}) {
+      throw std::runtime_error("Could not open columnar file '" + filename + "' for writing.");
+    }
+    if (options_.chunk_rows == 0ull) {
+      throw std::runtime_error("The number of rows per columnar chunk must be at least 1.");
+    }
+  }
+
+  columnar_output::~columnar_output()
+  {
+    try {
+      close();
+    }
+    catch (std::exception const& e) {
+      spdlog::error("Could not complete columnar file: {}", e.what());
+    }
+  }
+
+  void columnar_output::write(product_store const& store)
+  {
+    std::lock_guard lock{mutex_};
+    if (closed_) {
+      throw std::runtime_error("Cannot write to a columnar file that has been closed.");
+    }
+    open_if_needed();
+    for (auto const& [product_name, product] : store) {
+      if (not selected_.empty() and not selected_.contains(product_name)) {
+        continue;
+      }
+      auto* column = column_for(store, product_name, *product);
+      if (not column) {
+        continue;
+      }
+
+      append_index(column->index, *store.id());
+      if (column->serializer) {
+        column->offsets.push_back(column->values.size());
+        column->serializer->serialize(product->address(), column->values);
+      }
+      else {
+        auto const bytes = product->bytes();
+        column->values.append(reinterpret_cast<char const*>(bytes.data()), bytes.size());
+      }
+      if (++column->rows == options_.chunk_rows) {
+        flush(*column);
+      }
+    }
+  }
+
+  void columnar_output::close()
+  {
+    std::lock_guard lock{mutex_};
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    open_if_needed();
+
+    std::vector<column_info> columns;
+    for (auto& column : columns_ | std::views::values) {
+      flush(column);
+      columns.push_back(std::move(column.info));
+    }
+    columns_.clear();
+
+    auto const footer = columnar_footer(columns);
+    std::string tail;
+    append(tail, static_cast<std::uint64_t>(footer.size()));
+    tail += columnar_magic;
+    file_.write(footer.data(), footer.size());
+    file_.write(tail.data(), tail.size());
+    file_.close();
+    if (not file_) {
+      throw std::runtime_error("Failed to write columnar file.");
+    }
+  }
+
+  std::string columnar_output::checkpoint()
+  {
+    std::lock_guard lock{mutex_};
+    open_if_needed();
+    if (not file_.flush()) {
+      throw std::runtime_error("Failed to write columnar file '" + filename_ + "'.");
+    }
+    // The chunks must be on disk before a checkpoint that refers to them is saved.
+    sync_file(filename_);
+
+    // The rows that do not yet fill a chunk are saved with the state instead of being
+    // written as a (small) chunk at each checkpoint.
+    std::vector<column_info> columns;
+    std::string buffered_rows;
+    for (auto const& column : columns_ | std::views::values) {
+      columns.push_back(column.info);
+      append(buffered_rows, column.rows);
+      append_bytes(buffered_rows, column.index);
+      append_bytes(buffered_rows, column.values);
+      append_bytes(buffered_rows,
+                   {reinterpret_cast<char const*>(column.offsets.data()),
+                    column.offsets.size() * sizeof(std::uint64_t)});
+    }
+
+    std::string result;
+    append(result, offset_);
+    append_bytes(result, columnar_footer(columns));
+    result += buffered_rows;
+    return result;
+  }
+
+  void columnar_output::restore(std::string_view const state)
+  {
+    std::lock_guard lock{mutex_};
+    state_reader reader{state, filename_};
+    auto const offset = reader.number();
+    auto columns = columns_from_footer(reader.bytes(), offset);
+
+    // A file shorter than the checkpoint has lost chunks that the saved footer refers to;
+    // resize_file would silently pad it with zeros.
+    std::error_code ec;
+    auto const size = std::filesystem::file_size(filename_, ec);
+    if (ec or size < offset) {
+      throw std::runtime_error("Cannot resume writing columnar file '" + filename_ +
+                               "': it is shorter than when the checkpoint was saved.");
+    }
+
+    // Anything written after the checkpoint is discarded.
+    if (file_.is_open()) {
+      file_.close();
+    }
+    std::filesystem::resize_file(filename_, offset);
+    file_.open(filename_, std::ios::binary | std::ios::in | std::ios::out);
+    file_.seekp(static_cast<std::streamoff>(offset));
+    if (not file_) {
+      throw std::runtime_error("Could not reopen columnar file '" + filename_ + "'.");
+    }
+    offset_ = offset;
+
+    columns_.clear();
+    for (auto& info : columns) {
+      auto const* serializer =
+        info.width == 0ull ? detail::find_column_serializer(info.type_id.c_str()) : nullptr;
+      if (info.width == 0ull and not serializer) {
+        throw std::runtime_error("Cannot resume writing column '" + info.product +
+                                 "': type '" + info.type + "' has not been registered.");
+      }
+      column_key key{level_hash(info.levels), info.product};
+      auto& column = columns_.try_emplace(std::move(key), std::move(info), serializer)
+                       .first->second;
+      column.rows = reader.number();
+      column.index = reader.bytes();
+      column.values = reader.bytes();
+      auto const offsets = reader.bytes();
+      column.offsets.resize(offsets.size() / sizeof(std::uint64_t));
+      std::memcpy(column.offsets.data(), offsets.data(), offsets.size());
+    }
+  }
+
+  void columnar_output::open_if_needed()
+  {
+    if (file_.is_open()) {
+      return;
+    }
+    file_.open(filename_, std::ios::binary | std::ios::trunc);
+    if (not file_) {
+      throw std::runtime_error("Could not open columnar file '" + filename_ + "' for writing.");
+    }
+    file_.write(columnar_magic.data(), columnar_magic.size());
+    offset_ = columnar_magic.size();
+  }
+
+  auto columnar_output::column_for(product_store const& store,
+                                   std::string const& product_name,
+                                   product_base const& product) -> column_buffer*
+  {
+    column_key key{store.id()->level_hash(), product_name};
+    auto const type_name = boost::core::demangle(product.type().name());
+    if (auto it = columns_.find(key); it != columns_.end()) {
+      if (it->second.info.type != type_name) {
+        throw std::runtime_error("Product '" + product_name + "' of level '" +
+                                 it->second.info.level_path() + "' has type '" + type_name +
+                                 "', but type '" + it->second.info.type +
+                                 "' was previously written.");
+      }
+      return &it->second;
+    }
+    if (skipped_.contains(key)) {
+      return nullptr;
+    }
+
+    auto const width = product.bytes().size();
+    auto const* serializer = width == 0ull ? find_column_serializer(product.type()) : nullptr;
+    if (width == 0ull and not serializer) {
+      spdlog::warn("Product '{}' of level '{}' is not written: type '{}' has no portable "
+                   "object representation and no registered column serializer.",
+                   product_name,
+                   store.level_name(),
+                   type_name);
+      skipped_.insert(std::move(key));
+      return nullptr;
+    }
+
+    column_info info{.level = store.level_name(),
+                     .product = product_name,
+                     .type = type_name,
+                     .type_id = product.type().name(),
+                     .width = width,
+                     .levels = level_names(*store.id()),
+                     .chunks = {}};
+    auto [it, _] = columns_.try_emplace(std::move(key), std::move(info), serializer);
+    return &it->second;
+  }
+
+  void columnar_output::flush(column_buffer& column)
+  {
+    if (column.rows == 0ull) {
+      return;
+    }
+
+    auto const [index_offset, index_size] = write_block(column.index);
+
+    std::string raw;
+    if (column.serializer) {
+      column.offsets.push_back(column.values.size());
+      raw.append(reinterpret_cast<char const*>(column.offsets.data()),
+                 column.offsets.size() * sizeof(std::uint64_t));
+    }
+    raw += column.values;
+    auto const [offset, size] = write_block(raw);
+
+    column.info.chunks.push_back({.index_offset = index_offset,
+                                  .index_size = index_size,
+                                  .offset = offset,
+                                  .size = size,
+                                  .raw_size = raw.size(),
+                                  .rows = column.rows,
+                                  .compression = options_.compression});
+
+    column.index.clear();
+    column.values.clear();
+    column.offsets.clear();
+    column.rows = 0;
+  }
+
+  std::pair<std::uint64_t, std::uint64_t> columnar_output::write_block(std::string_view const raw)
+  {
+    // Aligning the blocks permits readers to use uncompressed values in place.
+    if (auto const misalignment = offset_ % columnar_alignment) {
+      std::string const padding(columnar_alignment - misalignment, '\0');
+      file_.write(padding.data(), padding.size());
+      offset_ += padding.size();
+    }
+
+    auto const compressed = compress(options_.compression, raw);
+    file_.write(compressed.data(), compressed.size());
+    std::pair<std::uint64_t, std::uint64_t> const result{offset_, compressed.size()};
+    offset_ += compressed.size();
+    return result;
+  }
+}
@@ -0,0 +1,98 @@
+#ifndef meld_io_columnar_output_hpp
+#define meld_io_columnar_output_hpp
+
+// =======================================================================================
+// The columnar_output class writes product stores to a columnar file (see
+// columnar_format.hpp).  It is registered as an output like any other:
+//
+//   g.make<columnar_output>("products.mcol").output_with(&columnar_output::write);
+//
+// or, from a configuration file, through the 'columnar_output' plugin:
+//
+//   output: {
+//     plugin: 'columnar_output',
+//     file: 'products.mcol',
+//     chunk_rows: 4096,          // optional
+//     codec: 'zlib',             // optional ('none' or 'zlib')
+//     products: ['hits', ...],   // optional (default is all products)
+//   }
+//
+// Products whose types neither have portable bytes (see has_portable_bytes) nor are
+// registered with register_column_type are skipped.  The file is complete once the
+// columnar_output object has been destroyed (or close() has been called).
+//
+// When the job saves checkpoints (see meld/core/checkpoint.hpp), the file offset, the
+// column descriptions, and the rows that do not yet fill a chunk are saved.  Upon
+// resuming, the file is truncated to the saved offset, the saved rows are buffered again,
+// and writing continues.  Checkpoints therefore do not change the chunking of the file.
+// =======================================================================================
+
+#include "meld/io/codec.hpp"
+#include "meld/io/column_types.hpp"
+#include "meld/io/columnar_format.hpp"
+#include "meld/model/product_store.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace meld {
+  struct columnar_output_options {
+    std::size_t chunk_rows{4096};
+    codec compression{default_codec()};
+    std::vector<std::string> products{}; // Empty means all products
+  };
+
+  class columnar_output {
+  public:
+    explicit columnar_output(std::string const& filename, columnar_output_options options = {});
+    ~columnar_output();
+
+    void write(product_store const& store);
+    void close();
+
+    std::string checkpoint();
+    void restore(std::string_view state);
+
+  private:
+    struct column_buffer {
+      column_info info;
+      column_serializer_base const* serializer; // Null for fixed-width columns
+      std::string index{};
+      std::string values{};
+      std::vector<std::uint64_t> offsets{};
+      std::uint64_t rows{};
+    };
+
+    column_buffer* column_for(product_store const& store,
+                              std::string const& product_name,
+                              product_base const& product);
+    void open_if_needed();
+    void flush(column_buffer& column);
+
+    // Returns the offset and stored size of the block
+    std::pair<std::uint64_t, std::uint64_t> write_block(std::string_view raw);
+
+    std::string filename_;
+    columnar_output_options options_;
+    std::set<std::string> selected_;
+    std::mutex mutex_;
+    std::ofstream file_;
+    bool closed_{false};
+    std::uint64_t offset_{};
+    // Columns are keyed by the level hash of their stores (see level_id::level_hash) and
+    // the product name.
+    using column_key = std::pair<std::size_t, std::string>;
+    std::map<column_key, column_buffer> columns_;
+    std::set<column_key> skipped_;
+  };
+}
+
+#endif // meld_io_columnar_output_hpp
@@ -0,0 +1,21 @@
+#include "meld/io/columnar_output.hpp"
+#include "meld/module.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+DEFINE_MODULE(m, config)
+{
+  meld::columnar_output_options options;
+  options.chunk_rows =
+    config.get_if_present<std::size_t>("chunk_rows").value_or(options.chunk_rows);
+  if (auto codec_name = config.get_if_present<std::string>("codec")) {
+    options.compression = meld::codec_from(*codec_name);
+  }
+  options.products =
+    config.get_if_present<std::vector<std::string>>("products").value_or(options.products);
+
+  m.make<meld::columnar_output>(config.get<std::string>("file"), std::move(options))
+    .output_with(&meld::columnar_output::write);
+}
@@ -0,0 +1,70 @@
+#include "meld/io/columnar_reader.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace meld {
+  columnar_reader::columnar_reader(std::string const& filename) :
+    file_{std::make_shared<mapped_file const>(filename)}
+  {
+    auto const tail_size = sizeof(std::uint64_t) + columnar_magic.size();
+    auto const file_size = file_->size();
+    if (file_size < columnar_magic.size() + tail_size or
+        file_->view(file_size - columnar_magic.size(), columnar_magic.size()) != columnar_magic) {
+      throw std::runtime_error("File '" + filename + "' is not a complete columnar file.");
+    }
+
+    std::uint64_t footer_size{};
+    std::memcpy(&footer_size, file_->view(file_size - tail_size, sizeof(footer_size)).data(),
+                sizeof(footer_size));
+    if (footer_size > file_size - tail_size) {
+      throw std::runtime_error("The footer of columnar file '" + filename + "' is corrupt.");
+    }
+    auto const data_size = file_size - tail_size - footer_size;
+    columns_ = columns_from_footer(file_->view(data_size, footer_size), data_size);
+  }
+
+  column_info const& columnar_reader::column(std::string const& level,
+                                             std::string const& product) const
+  {
+    auto matches = [&level, &product](column_info const& info) {
+      return info.product == product and (info.level == level or info.level_path() == level);
+    };
+    auto it = std::ranges::find_if(columns_, matches);
+    if (it == columns_.end()) {
+      throw std::runtime_error("File '" + file_->filename() + "' has no column '" + product +
+                               "' for level '" + level + "'.");
+    }
+    if (std::any_of(std::next(it), columns_.end(), matches)) {
+      throw std::runtime_error("File '" + file_->filename() + "' has more than one column '" +
+                               product + "' for level '" + level +
+                               "'--the level path (e.g. 'run/event') must be specified.");
+    }
+    return *it;
+  }
+
+  std::shared_ptr<column_chunk const> columnar_reader::chunk(column_info const& column,
+                                                             std::size_t const i) const
+  {
+    return std::make_shared<column_chunk const>(file_, column, column.chunks.at(i));
+  }
+
+  std::vector<level_id_ptr> columnar_reader::read_index(std::string const& level,
+                                                        std::string const& product) const
+  {
+    auto const& info = column(level, product);
+    std::vector<level_id_ptr> result;
+    result.reserve(info.rows());
+    for (std::size_t i = 0; i != info.chunks.size(); ++i) {
+      auto const c = chunk(info, i);
+      for (std::size_t row = 0; row != c->rows(); ++row) {
+        auto id = level_id::base_ptr();
+        for (std::size_t depth = 0; depth != info.depth(); ++depth) {
+          id = id->make_child(c->level_number(row, depth), info.levels[depth]);
+        }
+        result.push_back(std::move(id));
+      }
+    }
+    return result;
+  }
+}
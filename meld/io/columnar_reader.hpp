@@ -0,0 +1,75 @@
+#ifndef meld_io_columnar_reader_hpp
+#define meld_io_columnar_reader_hpp
+
+#include "meld/io/column_chunk.hpp"
+#include "meld/io/column_types.hpp"
+#include "meld/io/columnar_format.hpp"
+#include "meld/io/mapped_file.hpp"
+#include "meld/model/level_id.hpp"
+
+#include "boost/core/demangle.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace meld {
+  // The columnar_reader reads individual columns of a memory-mapped columnar file; only
+  // the pages of the requested columns are read from disk.  A column is identified by its
+  // product name and either its level name or, if several columns of the product have the
+  // same level name, its level path (e.g. "run/event").
+  class columnar_reader {
+  public:
+    explicit columnar_reader(std::string const& filename);
+
+    std::vector<column_info> const& columns() const noexcept { return columns_; }
+    column_info const& column(std::string const& level, std::string const& product) const;
+    std::shared_ptr<column_chunk const> chunk(column_info const& column, std::size_t i) const;
+
+    // The level IDs of the stores to which the rows of the column belong
+    std::vector<level_id_ptr> read_index(std::string const& level,
+                                         std::string const& product) const;
+
+    template <typename T>
+    std::vector<T> read(std::string const& level, std::string const& product) const;
+
+  private:
+    std::shared_ptr<mapped_file const> file_;
+    std::vector<column_info> columns_;
+  };
+
+  // Implementation details
+  template <typename T>
+  std::vector<T> columnar_reader::read(std::string const& level, std::string const& product) const
+  {
+    auto const& info = column(level, product);
+    if (info.type != boost::core::demangle(typeid(T).name())) {
+      throw std::runtime_error("Cannot read column '" + product + "' of level '" + level +
+                               "' as type '" + boost::core::demangle(typeid(T).name()) +
+                               "' -- must specify type '" + info.type + "'.");
+    }
+
+    std::vector<T> result;
+    result.reserve(info.rows());
+    for (std::size_t i = 0; i != info.chunks.size(); ++i) {
+      auto const c = chunk(info, i);
+      for (std::size_t row = 0; row != c->rows(); ++row) {
+        auto const bytes = c->value(row);
+        if constexpr (has_portable_bytes_v<T>) {
+          if (info.width == sizeof(T)) {
+            std::memcpy(&result.emplace_back(), bytes.data(), sizeof(T));
+            continue;
+          }
+        }
+        result.push_back(column_serializer_for<T>().from_bytes(bytes));
+      }
+    }
+    return result;
+  }
+}
+
+#endif // meld_io_columnar_reader_hpp
@@ -0,0 +1,116 @@
+#include "meld/io/columnar_source.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+  // Identifies a store by the level numbers and names from the top of the hierarchy.  The
+  // key of a parent store sorts before the keys of its children.
+  using store_key = std::vector<std::pair<std::uint64_t, std::string>>;
+
+  // A row of a column chunk
+  struct row_ref {
+    std::size_t column;
+    std::size_t chunk;
+    std::size_t row;
+  };
+}
+
+namespace meld {
+  columnar_source::columnar_source(std::string const& filename, std::vector<std::string> products) :
+    reader_{filename}, products_{std::move(products)}
+  {
+  }
+
+  columnar_source::columnar_source(configuration const& config) :
+    columnar_source{config.get<std::string>("file"),
+                    config.get_if_present<std::vector<std::string>>("products").value_or(
+                      std::vector<std::string>{})}
+  {
+  }
+
+  void columnar_source::next(framework_driver& driver)
+  {
+    auto const& columns = reader_.columns();
+
+    // Only the index blocks of the chunks are read here: the rows are grouped by the
+    // top-level store to which they belong.  The chunks are kept (with their decoded
+    // indexes) until all of their rows have been placed in stores.
+    auto job_store = product_store::base();
+    std::vector<column_serializer_base const*> serializers(columns.size());
+    std::vector<std::vector<std::shared_ptr<column_chunk const>>> chunks(columns.size());
+    std::vector<std::vector<std::uint64_t>> pending_rows(columns.size());
+    std::map<std::pair<std::uint64_t, std::string>, std::vector<row_ref>> top_level_rows;
+    for (std::size_t c = 0; c != columns.size(); ++c) {
+      auto const& column = columns[c];
+      if (not products_.empty() and
+          std::ranges::find(products_, column.product) == products_.end()) {
+        continue;
+      }
+      serializers[c] = detail::find_column_serializer(column.type_id.c_str());
+      if (not serializers[c]) {
+        spdlog::warn("Product '{}' of level '{}' is not read: type '{}' has not been registered "
+                     "with register_column_type.",
+                     column.product,
+                     column.level_path(),
+                     column.type);
+        continue;
+      }
+
+      for (std::size_t i = 0; i != column.chunks.size(); ++i) {
+        auto const chunk = reader_.chunk(column, i);
+        if (column.depth() != 0ull) {
+          chunks[c].push_back(chunk);
+          pending_rows[c].push_back(chunk->rows());
+        }
+        for (std::size_t row = 0; row != chunk->rows(); ++row) {
+          if (column.depth() == 0ull) {
+            job_store->add_product(column.product, serializers[c]->make_product(chunk, row));
+            continue;
+          }
+          top_level_rows[{chunk->level_number(row, 0), column.levels[0]}].push_back({c, i, row});
+        }
+      }
+    }
+    driver.yield(job_store);
+
+    // The stores are then created one top-level store (and its descendants) at a time.  A
+    // chunk is released once its last row has been placed; the products that refer to it
+    // keep it alive for as long as they need it.
+    while (not top_level_rows.empty()) {
+      auto const rows = std::move(top_level_rows.extract(top_level_rows.begin()).mapped());
+      std::map<store_key, products> stores;
+      for (auto const& [c, i, row] : rows) {
+        auto const& column = columns[c];
+        auto const chunk = chunks[c][i];
+        if (--pending_rows[c][i] == 0ull) {
+          chunks[c][i].reset();
+        }
+
+        // Stores without products of their own must still be created for their children.
+        store_key key;
+        for (std::size_t depth = 0; depth != column.depth(); ++depth) {
+          key.emplace_back(chunk->level_number(row, depth), column.levels[depth]);
+          stores.try_emplace(key);
+        }
+        stores[key].add(column.product, serializers[c]->make_product(chunk, row));
+      }
+
+      std::vector<product_store_ptr> parents{job_store};
+      for (auto& [key, store_products] : stores) {
+        parents.resize(key.size());
+        auto const& [number, level_name] = key.back();
+        auto store = parents.back()->make_child(number, level_name, {}, std::move(store_products));
+        parents.push_back(store);
+        driver.yield(store);
+      }
+    }
+  }
+}
@@ -0,0 +1,44 @@
+#ifndef meld_io_columnar_source_hpp
+#define meld_io_columnar_source_hpp
+
+// =======================================================================================
+// The columnar_source reads the product stores written by columnar_output:
+//
+//   source: {
+//     plugin: 'columnar_source',
+//     file: 'products.mcol',
+//     products: ['hits', ...],   // optional (default is all products)
+//   }
+//
+// The level hierarchy is reconstructed from the index blocks of the chunks, and each store
+// is yielded after its parent.  The stores are created one top-level store (and its
+// descendants) at a time.  Each index block is decoded once, and a chunk is released as
+// soon as all of its rows have been placed in stores.  The file is memory-mapped, and the
+// products inserted into the stores refer to their values in the mapping--a value is read
+// (and, if necessary, decompressed or deserialized) only when a node retrieves the product.  Values of types with portable
+// bytes in uncompressed files are not copied at all; such files can be written by
+// specifying 'codec: "none"' for the columnar_output.
+// =======================================================================================
+
+#include "meld/configuration.hpp"
+#include "meld/io/columnar_reader.hpp"
+#include "meld/source.hpp"
+
+#include <string>
+#include <vector>
+
+namespace meld {
+  class columnar_source {
+  public:
+    explicit columnar_source(std::string const& filename, std::vector<std::string> products = {});
+    explicit columnar_source(configuration const& config);
+
+    void next(framework_driver& driver);
+
+  private:
+    columnar_reader reader_;
+    std::vector<std::string> products_;
+  };
+}
+
+#endif // meld_io_columnar_source_hpp
@@ -0,0 +1,4 @@
+#include "meld/io/columnar_source.hpp"
+#include "meld/source.hpp"
+
+DEFINE_SOURCE(meld::columnar_source)
@@ -0,0 +1,65 @@
+#include "meld/io/mapped_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+  std::runtime_error mapping_error(std::string const& filename)
+  {
+    return std::runtime_error("Could not map file '" + filename + "': " + std::strerror(errno));
+  }
+}
+
+namespace meld {
+  mapped_file::mapped_file(std::string const& filename) : filename_{filename}
+  {
+    int const fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw mapping_error(filename);
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) == -1) {
+      auto error = mapping_error(filename);
+      ::close(fd);
+      throw error;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    // An empty file cannot be mapped, but it is still a (malformed) file to be reported
+    // by the caller.
+    if (size_ != 0ull) {
+      void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        auto error = mapping_error(filename);
+        ::close(fd);
+        throw error;
+      }
+      data_ = static_cast<char const*>(data);
+    }
+
+    // The mapping remains valid after the file descriptor is closed.
+    ::close(fd);
+  }
+
+  mapped_file::~mapped_file()
+  {
+    if (data_) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  std::string_view mapped_file::view(std::size_t const offset, std::size_t const size) const
+  {
+    if (offset > size_ or size > size_ - offset) {
+      throw std::runtime_error("Requested bytes lie beyond the end of file '" + filename_ + "'.");
+    }
+    return {data_ + offset, size};
+  }
+}
@@ -0,0 +1,30 @@
+#ifndef meld_io_mapped_file_hpp
+#define meld_io_mapped_file_hpp
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace meld {
+  // A read-only memory mapping of an entire file.  Pages of the file are read from disk
+  // only when they are first accessed.
+  class mapped_file {
+  public:
+    explicit mapped_file(std::string const& filename);
+    ~mapped_file();
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    std::string const& filename() const noexcept { return filename_; }
+    std::size_t size() const noexcept { return size_; }
+    std::string_view view(std::size_t offset, std::size_t size) const;
+
+  private:
+    std::string filename_;
+    char const* data_{nullptr};
+    std::size_t size_{};
+  };
+}
+
+#endif // meld_io_mapped_file_hpp
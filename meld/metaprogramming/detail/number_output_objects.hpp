@@ -4,6 +4,7 @@
 #include "meld/metaprogramming/detail/basic_concepts.hpp"
 
 #include <cstddef>
+#include <future>
 #include <tuple>
 
 namespace meld::detail {
@@ -13,6 +14,19 @@ namespace meld::detail {
   template <typename... Args>
   constexpr std::size_t number_types<std::tuple<Args...>> = sizeof...(Args);
 
+  // An asynchronous function provides the objects held by the future it returns.
+  template <typename T>
+  constexpr std::size_t number_types<std::future<T>> = number_types<T>;
+
+  template <typename T>
+  constexpr std::size_t number_types<std::shared_future<T>> = number_types<T>;
+
+  template <>
+  constexpr std::size_t number_types<std::future<void>> = 0ull;
+
+  template <>
+  constexpr std::size_t number_types<std::shared_future<void>> = 0ull;
+
   template <typename R>
   constexpr std::size_t number_types_not_void()
   {
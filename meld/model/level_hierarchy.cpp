@@ -4,6 +4,8 @@
 #include "fmt/format.h"
 #include "spdlog/spdlog.h"
 
+#include <ranges>
+
 namespace {
   std::string const unnamed{"(unnamed)"};
   std::string const& maybe_name(std::string const& name) { return empty(name) ? unnamed : name; }
@@ -38,6 +40,15 @@ namespace meld {
     return it != cend(levels_) ? it->second->count.load() : 0;
   }
 
+  std::map<std::string, std::size_t> level_hierarchy::counts() const
+  {
+    std::map<std::string, std::size_t> result;
+    for (auto const& entry : levels_ | std::views::values) {
+      result[entry->name] += entry->count.load();
+    }
+    return result;
+  }
+
   void level_hierarchy::print() const { spdlog::info("{}", graph_layout()); }
 
   std::string level_hierarchy::pretty_recurse(std::map<std::string, hash_name_pairs> const& tree,
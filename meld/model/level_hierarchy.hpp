@@ -18,6 +18,9 @@ namespace meld {
     void increment_count(level_id_ptr const& id);
     std::size_t count_for(std::string const& level_name) const;
 
+    // The number of processed stores per level name
+    std::map<std::string, std::size_t> counts() const;
+
     void print() const;
 
   private:
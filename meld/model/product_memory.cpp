@@ -0,0 +1,59 @@
+#include "meld/model/product_memory.hpp"
+
+#include <tuple>
+#include <utility>
+
+namespace meld {
+  void memory_counter::add(std::size_t const bytes) noexcept
+  {
+    total_ += static_cast<std::int64_t>(bytes);
+    auto const live = live_ += static_cast<std::int64_t>(bytes);
+    auto peak = peak_.load();
+    while (live > peak and not peak_.compare_exchange_weak(peak, live)) {}
+  }
+
+  void memory_counter::remove(std::size_t const bytes) noexcept
+  {
+    live_ -= static_cast<std::int64_t>(bytes);
+  }
+
+  memory_counter& product_memory::counter_for(counters_t& counters, std::string const& name)
+  {
+    if (auto it = counters.find(name); it != counters.end()) {
+      return it->second;
+    }
+    return counters
+      .emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple())
+      .first->second;
+  }
+
+  memory_counter& product_memory::for_node(std::string_view const node_name)
+  {
+    // Stores provided by the source have no producing node.
+    return counter_for(nodes_, node_name.empty() ? "[source]" : std::string{node_name});
+  }
+
+  memory_counter& product_memory::for_level(std::string const& level_name)
+  {
+    return counter_for(levels_, level_name);
+  }
+
+  std::map<std::string, memory_usage> product_memory::usage_of(counters_t const& counters)
+  {
+    std::map<std::string, memory_usage> result;
+    for (auto const& [name, counter] : counters) {
+      result.try_emplace(name, counter.usage());
+    }
+    return result;
+  }
+
+  std::map<std::string, memory_usage> product_memory::node_usage() const
+  {
+    return usage_of(nodes_);
+  }
+
+  std::map<std::string, memory_usage> product_memory::level_usage() const
+  {
+    return usage_of(levels_);
+  }
+}
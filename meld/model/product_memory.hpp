@@ -0,0 +1,63 @@
+#ifndef meld_model_product_memory_hpp
+#define meld_model_product_memory_hpp
+
+// =======================================================================================
+// When product-memory accounting is enabled, each product store reports the sizes of its
+// products (see size_of.hpp) when they are added, and releases them when the store is
+// destroyed.  The live and peak number of bytes are aggregated per producing node (the
+// source of the store) and per level name.
+//
+// Each framework_graph for which framework_graph::enable_memory_accounting has been called
+// owns a product_memory object, which it assigns to every top-level store it reads.  All
+// stores derived from such a store report to the same object, which they keep alive.
+// Stores derived from a store without a product_memory object--in particular, all stores
+// created before accounting was enabled--are never accounted for.
+// =======================================================================================
+
+#include "oneapi/tbb/concurrent_unordered_map.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace meld {
+  struct memory_usage {
+    std::int64_t live;
+    std::int64_t peak;
+    std::int64_t total; // Bytes of all products added, including those since released
+  };
+
+  class memory_counter {
+  public:
+    void add(std::size_t bytes) noexcept;
+    void remove(std::size_t bytes) noexcept;
+    memory_usage usage() const noexcept { return {live_.load(), peak_.load(), total_.load()}; }
+
+  private:
+    std::atomic<std::int64_t> live_{};
+    std::atomic<std::int64_t> peak_{};
+    std::atomic<std::int64_t> total_{};
+  };
+
+  class product_memory {
+  public:
+    memory_counter& for_node(std::string_view node_name);
+    memory_counter& for_level(std::string const& level_name);
+
+    std::map<std::string, memory_usage> node_usage() const;
+    std::map<std::string, memory_usage> level_usage() const;
+
+  private:
+    using counters_t = tbb::concurrent_unordered_map<std::string, memory_counter>;
+    static memory_counter& counter_for(counters_t& counters, std::string const& name);
+    static std::map<std::string, memory_usage> usage_of(counters_t const& counters);
+
+    counters_t nodes_;
+    counters_t levels_;
+  };
+}
+
+#endif // meld_model_product_memory_hpp
@@ -1,6 +1,7 @@
 #include "meld/model/product_store.hpp"
 #include "meld/model/level_id.hpp"
 
+#include <cassert>
 #include <memory>
 #include <utility>
 
@@ -10,13 +11,16 @@ namespace meld {
                                level_id_ptr id,
                                std::string_view source,
                                stage processing_stage,
-                               products new_products) :
+                               products new_products,
+                               std::shared_ptr<product_memory> memory) :
     parent_{std::move(parent)},
     products_{std::move(new_products)},
     id_{std::move(id)},
     source_{source},
-    stage_{processing_stage}
+    stage_{processing_stage},
+    memory_{std::move(memory)}
   {
+    account_for_products();
   }
 
   product_store::product_store(product_store_const_ptr parent,
@@ -28,8 +32,10 @@ namespace meld {
     products_{std::move(new_products)},
     id_{parent->id()->make_child(new_level_number, new_level_name)},
     source_{source},
-    stage_{stage::process}
+    stage_{stage::process},
+    memory_{parent->memory_}
   {
+    account_for_products();
   }
 
   product_store::product_store(product_store_const_ptr parent,
@@ -40,11 +46,47 @@ namespace meld {
     parent_{parent},
     id_{parent->id()->make_child(new_level_number, new_level_name)},
     source_{source},
-    stage_{processing_stage}
+    stage_{processing_stage},
+    memory_{parent->memory_}
+  {
+  }
+
+  product_store::~product_store()
+  {
+    if (accounted_bytes_ != 0ull) {
+      node_memory_->remove(accounted_bytes_);
+      level_memory_->remove(accounted_bytes_);
+    }
+  }
+
+  void product_store::account_memory_in(std::shared_ptr<product_memory> memory)
+  {
+    assert(not parent_);
+    memory_ = std::move(memory);
+    account_for_products();
+  }
+
+  void product_store::account_for_products()
   {
+    if (not memory_) {
+      return;
+    }
+    account_for(products_.memory_size() - accounted_bytes_);
   }
 
-  product_store::~product_store() = default;
+  void product_store::account_for(std::size_t const bytes)
+  {
+    if (not memory_ or bytes == 0ull) {
+      return;
+    }
+    if (not node_memory_) {
+      node_memory_ = &memory_->for_node(source_);
+      level_memory_ = &memory_->for_level(level_name());
+    }
+    node_memory_->add(bytes);
+    level_memory_->add(bytes);
+    accounted_bytes_ += bytes;
+  }
 
   product_store_ptr product_store::base() { return product_store_ptr{new product_store}; }
 
@@ -74,14 +116,15 @@ namespace meld {
 
   product_store_ptr product_store::make_flush() const
   {
-    return product_store_ptr{new product_store{parent_, id_, "[inserted]", stage::flush}};
+    return product_store_ptr{
+      new product_store{parent_, id_, "[inserted]", stage::flush, {}, memory_}};
   }
 
   product_store_ptr product_store::make_continuation(std::string_view source,
                                                      products new_products) const
   {
     return product_store_ptr{
-      new product_store{parent_, id_, source, stage::process, std::move(new_products)}};
+      new product_store{parent_, id_, source, stage::process, std::move(new_products), memory_}};
   }
 
   product_store_ptr product_store::make_child(std::size_t new_level_number,
@@ -113,6 +156,13 @@ namespace meld {
     return products_.contains(product_name);
   }
 
+  void product_store::add_product(std::string const& key, std::unique_ptr<product_base>&& p)
+  {
+    auto const bytes = p->memory_size();
+    products_.add(key, std::move(p));
+    account_for(bytes);
+  }
+
   product_store_ptr const& more_derived(product_store_ptr const& a, product_store_ptr const& b)
   {
     if (a->id()->depth() > b->id()->depth()) {
@@ -4,6 +4,7 @@
 #include "meld/model/fwd.hpp"
 #include "meld/model/handle.hpp"
 #include "meld/model/level_id.hpp"
+#include "meld/model/product_memory.hpp"
 #include "meld/model/products.hpp"
 
 #include <array>
@@ -58,12 +59,24 @@ namespace meld {
     template <typename T>
     void add_product(std::string const& key, std::unique_ptr<product<T>>&& t);
 
+    void add_product(std::string const& key, std::unique_ptr<product_base>&& p);
+
+    // The loader is not invoked until the product is first retrieved; the product is
+    // nevertheless considered present by contains_product.
+    template <typename F>
+    void add_deferred_product(std::string const& key, F&& loader);
+
+    // The memory of the products of this top-level store, and of all stores subsequently
+    // derived from it, is accounted for by the given object (see product_memory.hpp).
+    void account_memory_in(std::shared_ptr<product_memory> memory);
+
   private:
     explicit product_store(product_store_const_ptr parent = nullptr,
                            level_id_ptr id = level_id::base_ptr(),
                            std::string_view source = {},
                            stage processing_stage = stage::process,
-                           products new_products = {});
+                           products new_products = {},
+                           std::shared_ptr<product_memory> memory = nullptr);
     explicit product_store(product_store_const_ptr parent,
                            std::size_t new_level_number,
                            std::string const& new_level_name,
@@ -75,11 +88,21 @@ namespace meld {
                            std::string_view source,
                            stage processing_stage);
 
+    // Reports the memory of the products not yet accounted for, if the memory of the store
+    // is accounted for (see product_memory.hpp).  Called when the store is created; the
+    // products added afterwards are reported individually by account_for.
+    void account_for_products();
+    void account_for(std::size_t bytes);
+
     product_store_const_ptr parent_{nullptr};
     products products_{};
     level_id_ptr id_;
     std::string_view source_;
     stage stage_;
+    std::shared_ptr<product_memory> memory_;
+    std::size_t accounted_bytes_{};
+    memory_counter* node_memory_{nullptr};
+    memory_counter* level_memory_{nullptr};
   };
 
   product_store_ptr const& more_derived(product_store_ptr const& a, product_store_ptr const& b);
@@ -119,7 +142,18 @@ namespace meld {
   template <typename T>
   void product_store::add_product(std::string const& key, std::unique_ptr<product<T>>&& t)
   {
+    auto const bytes = t->memory_size();
     products_.add(key, std::move(t));
+    account_for(bytes);
+  }
+
+  template <typename F>
+  void product_store::add_deferred_product(std::string const& key, F&& loader)
+  {
+    using T = std::remove_cvref_t<std::invoke_result_t<F>>;
+    add_product(key,
+                std::unique_ptr<product_base>{
+                  std::make_unique<deferred_product<T>>(std::forward<F>(loader))});
   }
 
   template <typename T>
@@ -1,5 +1,6 @@
 #include "meld/model/products.hpp"
 
+#include <ranges>
 #include <string>
 
 namespace meld {
@@ -10,4 +11,18 @@ namespace meld {
 
   products::const_iterator products::begin() const noexcept { return products_.begin(); }
   products::const_iterator products::end() const noexcept { return products_.end(); }
+
+  void products::insert(std::string const& product_name, std::unique_ptr<product_base>&& p)
+  {
+    products_.emplace(product_name, std::move(p));
+  }
+
+  std::size_t products::memory_size() const
+  {
+    std::size_t result{};
+    for (auto const& product : products_ | std::views::values) {
+      result += product->memory_size();
+    }
+    return result;
+  }
 }
@@ -3,12 +3,21 @@
 
 #include "meld/model/level_id.hpp"
 #include "meld/model/qualified_name.hpp"
+#include "meld/model/size_of.hpp"
 
 #include "boost/core/demangle.hpp"
 #include "spdlog/spdlog.h"
 
+#include <array>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_map>
 #include <utility>
@@ -16,10 +25,41 @@
 
 namespace meld {
 
+  // Whether the object representation of a type is a faithful copy of its value, even when
+  // read by another process--i.e. the type is trivially copyable and does not refer to
+  // other objects.  Pointer-like types are excluded; classes that hold pointers must
+  // specialize this trait themselves:
+  //
+  //   template <>
+  //   struct meld::has_portable_bytes<MyClass> : std::false_type {};
+  template <typename T>
+  struct has_portable_bytes :
+    std::bool_constant<std::is_trivially_copyable_v<T> and not std::is_pointer_v<T> and
+                       not std::is_member_pointer_v<T> and not std::is_null_pointer_v<T>> {};
+
+  template <typename T, std::size_t N>
+  struct has_portable_bytes<T[N]> : has_portable_bytes<T> {};
+  template <typename T, std::size_t N>
+  struct has_portable_bytes<std::array<T, N>> : has_portable_bytes<T> {};
+  template <typename T, std::size_t N>
+  struct has_portable_bytes<std::span<T, N>> : std::false_type {};
+  template <typename CharT, typename Traits>
+  struct has_portable_bytes<std::basic_string_view<CharT, Traits>> : std::false_type {};
+
+  template <typename T>
+  constexpr bool has_portable_bytes_v = has_portable_bytes<std::remove_cvref_t<T>>::value;
+
   struct product_base {
     virtual ~product_base() = default;
     virtual void const* address() const = 0;
     virtual std::type_index type() const = 0;
+
+    // The object representation of the product, or an empty span if the product's type
+    // does not have portable bytes (see has_portable_bytes)
+    virtual std::span<std::byte const> bytes() const = 0;
+
+    // The number of bytes held by the product (see size_of.hpp)
+    virtual std::size_t memory_size() const = 0;
   };
 
   template <typename T>
@@ -33,9 +73,73 @@ namespace meld {
 
     void const* address() const final { return &obj; }
     virtual std::type_index type() const { return std::type_index{typeid(T)}; }
+    std::span<std::byte const> bytes() const final
+    {
+      if constexpr (has_portable_bytes_v<T>) {
+        return std::as_bytes(std::span{&obj, 1});
+      }
+      else {
+        return {};
+      }
+    }
+    std::size_t memory_size() const final { return size_of(obj); }
     std::remove_cvref_t<T> obj;
   };
 
+  // A product whose value is created the first time the product is retrieved.  The
+  // derived class's 'materialize' function is invoked at most once, even if several nodes
+  // retrieve the product concurrently; if it throws, the next retrieval invokes it again.
+  template <typename T>
+  class lazy_product : public product_base {
+  public:
+    void const* address() const final
+    {
+      std::call_once(materialized_, [this] { address_ = materialize(); });
+      return address_;
+    }
+
+    std::type_index type() const final { return std::type_index{typeid(T)}; }
+
+    std::span<std::byte const> bytes() const final
+    {
+      if constexpr (has_portable_bytes_v<T>) {
+        return std::as_bytes(std::span{static_cast<T const*>(address()), 1});
+      }
+      else {
+        return {};
+      }
+    }
+
+  private:
+    // Returns the address of the value
+    virtual void const* materialize() const = 0;
+
+    mutable std::once_flag materialized_;
+    mutable void const* address_{nullptr};
+  };
+
+  // A product whose value is created by its loader the first time the product is
+  // retrieved.
+  template <typename T>
+  class deferred_product : public lazy_product<T> {
+  public:
+    explicit deferred_product(std::function<T()> loader) : loader_{std::move(loader)} {}
+
+    // The size is reported when the product is added, before the value is loaded.
+    std::size_t memory_size() const final { return sizeof(T); }
+
+  private:
+    void const* materialize() const final
+    {
+      auto const& value = obj_.emplace(loader_());
+      loader_ = nullptr; // Release whatever the loader captured
+      return &value;
+    }
+
+    mutable std::function<T()> loader_;
+    mutable std::optional<T> obj_;
+  };
+
   class products {
     using collection_t = std::unordered_map<std::string, std::unique_ptr<product_base>>;
 
@@ -51,7 +155,20 @@ namespace meld {
     template <typename T>
     void add(std::string const& product_name, std::unique_ptr<product<T>>&& t)
     {
-      products_.emplace(product_name, std::move(t));
+      insert(product_name, std::move(t));
+    }
+
+    // For products whose values are provided by other means (e.g. read lazily from a file)
+    void add(std::string const& product_name, std::unique_ptr<product_base>&& p)
+    {
+      insert(product_name, std::move(p));
+    }
+
+    template <typename F>
+    void add_deferred(std::string const& product_name, F&& loader)
+    {
+      using T = std::remove_cvref_t<std::invoke_result_t<F>>;
+      insert(product_name, std::make_unique<deferred_product<T>>(std::forward<F>(loader)));
     }
 
     template <typename Ts>
@@ -87,7 +204,7 @@ namespace meld {
 
       auto available_product = it->second.get();
       if (std::strcmp(typeid(T).name(), available_product->type().name()) == 0) {
-        return &reinterpret_cast<product<T> const*>(available_product)->obj;
+        return static_cast<T const*>(available_product->address());
       }
       return "Cannot get product '" + product_name + "' with type '" +
              boost::core::demangle(typeid(T).name()) + "' -- must specify type '" +
@@ -98,7 +215,12 @@ namespace meld {
     const_iterator begin() const noexcept;
     const_iterator end() const noexcept;
 
+    // The sum of the memory sizes of the products, which is calculated on each call
+    std::size_t memory_size() const;
+
   private:
+    void insert(std::string const& product_name, std::unique_ptr<product_base>&& p);
+
     collection_t products_;
   };
 }
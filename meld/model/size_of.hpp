@@ -0,0 +1,35 @@
+#ifndef meld_model_size_of_hpp
+#define meld_model_size_of_hpp
+
+// =======================================================================================
+// meld::size_of(t) reports the number of bytes occupied by the product t, and is used to
+// account for the memory held by the products of each node (see product_memory.hpp).
+//
+// The default reports sizeof(T) plus, for contiguous containers that allocate their
+// elements (std::vector, std::string, etc.), the bytes of the allocated elements.  The
+// memory owned by the elements themselves (e.g. the characters of the strings of an
+// std::vector<std::string>) is not included.
+// The size of other types may be reported by providing an overload
+//
+//   std::size_t size_of(my_type const&);
+//
+// in the namespace of the type (where it is found by argument-dependent lookup).
+// =======================================================================================
+
+#include <cstddef>
+#include <ranges>
+
+namespace meld {
+  template <typename T>
+  std::size_t size_of(T const& t)
+  {
+    if constexpr (std::ranges::contiguous_range<T const> and requires { t.capacity(); }) {
+      return sizeof(T) + t.capacity() * sizeof(std::ranges::range_value_t<T const>);
+    }
+    else {
+      return sizeof(T);
+    }
+  }
+}
+
+#endif // meld_model_size_of_hpp
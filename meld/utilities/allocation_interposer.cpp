@@ -0,0 +1,60 @@
+// =======================================================================================
+// Replacements of the global operator new and delete that report each allocation to the
+// allocation profiler (see allocation_profiler.hpp).  Only the basic and aligned forms
+// are replaced; the default array, nothrow, and sized forms are specified to call them.
+// =======================================================================================
+
+#include "meld/utilities/allocation_profiler.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+  [[maybe_unused]] bool const marked = (meld::mark_allocations_interposed(), true);
+
+  template <typename F>
+  void* allocate_with(F allocate)
+  {
+    while (true) {
+      if (void* p = allocate()) {
+        return p;
+      }
+      auto handler = std::get_new_handler();
+      if (not handler) {
+        throw std::bad_alloc{};
+      }
+      handler();
+    }
+  }
+}
+
+void* operator new(std::size_t size)
+{
+  meld::record_allocation(size);
+  return allocate_with([size] { return std::malloc(size == 0 ? 1 : size); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  meld::record_allocation(size);
+  auto const align = static_cast<std::size_t>(alignment);
+  // The size passed to aligned_alloc must be a multiple of the alignment.
+  auto const padded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+  return allocate_with([padded, align] { return std::aligned_alloc(align, padded); });
+}
+
+void operator delete(void* p) noexcept
+{
+  if (p) {
+    meld::record_deallocation();
+  }
+  std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  if (p) {
+    meld::record_deallocation();
+  }
+  std::free(p);
+}
@@ -0,0 +1,57 @@
+#include "meld/utilities/allocation_profiler.hpp"
+
+#include <utility>
+
+namespace {
+  // Trivially initialized, so that they may be accessed by operator new at any time.  The
+  // tally of the current counters is looked up when the counters are made current, so
+  // that operator new never needs to allocate.
+  constinit thread_local meld::allocation_counters* current_counters{nullptr};
+  constinit thread_local meld::allocation_counters::per_thread* current_tally{nullptr};
+  std::atomic<bool> interposed{false};
+
+  // Only the owning thread writes to its tally, so no read-modify-write is needed.
+  void increment(std::atomic<std::uint64_t>& value, std::uint64_t const n) noexcept
+  {
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+}
+
+namespace meld {
+  allocation_tally allocation_counters::total() const
+  {
+    allocation_tally result;
+    for (auto const& tally : tallies_) {
+      result.allocations += tally.allocations.load(std::memory_order_relaxed);
+      result.bytes += tally.bytes.load(std::memory_order_relaxed);
+      result.deallocations += tally.deallocations.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  allocation_counters* attribute_allocations_to(allocation_counters* counters) noexcept
+  {
+    // Any allocation made while creating the tally of this thread is not counted.
+    current_tally = nullptr;
+    current_tally = counters ? &counters->local() : nullptr;
+    return std::exchange(current_counters, counters);
+  }
+
+  void record_allocation(std::size_t const bytes) noexcept
+  {
+    if (auto* tally = current_tally) {
+      increment(tally->allocations, 1);
+      increment(tally->bytes, bytes);
+    }
+  }
+
+  void record_deallocation() noexcept
+  {
+    if (auto* tally = current_tally) {
+      increment(tally->deallocations, 1);
+    }
+  }
+
+  void mark_allocations_interposed() noexcept { interposed = true; }
+  bool allocations_interposed() noexcept { return interposed.load(); }
+}
@@ -0,0 +1,62 @@
+#ifndef meld_utilities_allocation_profiler_hpp
+#define meld_utilities_allocation_profiler_hpp
+
+// =======================================================================================
+// Allocation profiling attributes the allocations made through the global operator new
+// to the counters that are current on the allocating thread--typically those of the node
+// being executed (see node_statistics.hpp).  Allocations made while no counters are
+// current are not counted.  So that concurrent invocations of the same node do not
+// contend for the same cache line, each thread increments its own tallies, which are
+// combined only when the counters are read.
+//
+// The replacements of the global operator new and delete that report the allocations are
+// provided by the meld_allocation_interposer object library, which is linked into the
+// meld executable only if meld is configured with ENABLE_ALLOCATION_PROFILING.  Without
+// it, the counters are never incremented, and allocations_interposed() returns false.
+// =======================================================================================
+
+#include "oneapi/tbb/enumerable_thread_specific.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace meld {
+  struct allocation_tally {
+    std::uint64_t allocations{};
+    std::uint64_t bytes{};
+    std::uint64_t deallocations{};
+  };
+
+  class allocation_counters {
+  public:
+    // Written only by its own thread, but may be read concurrently by total()
+    struct per_thread {
+      std::atomic<std::uint64_t> allocations{};
+      std::atomic<std::uint64_t> bytes{};
+      std::atomic<std::uint64_t> deallocations{};
+    };
+
+    // The tally of the calling thread
+    per_thread& local() { return tallies_.local(); }
+
+    // Combined over all threads
+    allocation_tally total() const;
+
+  private:
+    tbb::enumerable_thread_specific<per_thread> tallies_;
+  };
+
+  // Makes the given counters (which may be null) current on the calling thread, and
+  // returns the previously current counters
+  allocation_counters* attribute_allocations_to(allocation_counters* counters) noexcept;
+
+  // Called by the replacements of operator new and delete
+  void record_allocation(std::size_t bytes) noexcept;
+  void record_deallocation() noexcept;
+  void mark_allocations_interposed() noexcept;
+
+  bool allocations_interposed() noexcept;
+}
+
+#endif // meld_utilities_allocation_profiler_hpp
@@ -0,0 +1,31 @@
+#include "meld/utilities/escaped.hpp"
+
+#include "fmt/format.h"
+
+namespace meld {
+  std::string escaped(std::string_view const str)
+  {
+    std::string result;
+    result.reserve(str.size());
+    for (char const c : str) {
+      switch (c) {
+      case '"':
+      case '\\':
+        result += '\\';
+        result += c;
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          result += fmt::format("\\u{:04x}", static_cast<unsigned int>(c));
+        }
+        else {
+          result += c;
+        }
+      }
+    }
+    return result;
+  }
+}
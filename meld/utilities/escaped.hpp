@@ -0,0 +1,14 @@
+#ifndef meld_utilities_escaped_hpp
+#define meld_utilities_escaped_hpp
+
+#include <string>
+#include <string_view>
+
+namespace meld {
+  // Escapes a string for use within double quotes in the JSON and Prometheus text formats:
+  // quotes, backslashes, and newlines are preceded by a backslash, and all other control
+  // characters are written as \u00XX.
+  std::string escaped(std::string_view str);
+}
+
+#endif // meld_utilities_escaped_hpp
@@ -0,0 +1,71 @@
+#include "meld/utilities/histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace meld {
+  std::size_t histogram::bucket_for(std::uint64_t value) noexcept
+  {
+    value = std::min(value, (std::uint64_t{1} << max_value_bits) - 1);
+    if (value < sub_buckets) {
+      return value;
+    }
+    // The most significant bit selects the power-of-two range, and the next
+    // 'sub_bucket_bits' bits select the bucket within that range.
+    std::size_t const shift = std::bit_width(value) - 1 - sub_bucket_bits;
+    return (shift + 1) * sub_buckets + ((value >> shift) - sub_buckets);
+  }
+
+  std::uint64_t histogram::upper_bound_of(std::size_t const bucket) noexcept
+  {
+    if (bucket < sub_buckets) {
+      return bucket;
+    }
+    std::size_t const shift = bucket / sub_buckets - 1;
+    std::uint64_t const sub_bucket = bucket % sub_buckets + sub_buckets;
+    return ((sub_bucket + 1) << shift) - 1;
+  }
+
+  void histogram::record(std::uint64_t const value) noexcept
+  {
+    ++counts_[bucket_for(value)];
+    ++count_;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  void histogram::merge(histogram const& other) noexcept
+  {
+    for (std::size_t i = 0; i != n_buckets; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+  }
+
+  double histogram::mean() const noexcept
+  {
+    return count_ ? static_cast<double>(sum_) / count_ : 0.;
+  }
+
+  std::uint64_t histogram::percentile(double const p) const noexcept
+  {
+    if (count_ == 0ull) {
+      return 0;
+    }
+    auto const fraction = std::clamp(p, 0., 100.) / 100.;
+    auto const rank = std::max<std::uint64_t>(1, std::ceil(fraction * count_));
+    std::uint64_t seen{};
+    for (std::size_t i = 0; i != n_buckets; ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        return std::clamp(upper_bound_of(i), min_, max_);
+      }
+    }
+    return max_;
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef meld_utilities_histogram_hpp
+#define meld_utilities_histogram_hpp
+
+// =======================================================================================
+// The histogram class records non-negative integer values (e.g. durations in
+// nanoseconds) in the style of HdrHistogram: each power-of-two range of values is divided
+// into 8 equally sized buckets, so that the value reported for a percentile is within
+// ~12% of the recorded value.  Recording a value is a handful of integer operations and
+// never allocates; histograms filled on different threads are combined with 'merge'.
+// The buckets are coarse enough that a histogram occupies about 2.5 KB, as each node keeps
+// two of them for every thread that executes it.
+//
+// Values at or above 2^42 (about 73 minutes when recording nanoseconds) are counted in
+// the last bucket; the minimum, maximum, and mean are always exact.
+// =======================================================================================
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace meld {
+  class histogram {
+  public:
+    static constexpr std::size_t sub_bucket_bits{3};
+    static constexpr std::size_t max_value_bits{42};
+
+    void record(std::uint64_t value) noexcept;
+    void merge(histogram const& other) noexcept;
+
+    std::uint64_t count() const noexcept { return count_; }
+    std::uint64_t sum() const noexcept { return sum_; }
+    std::uint64_t min() const noexcept { return count_ ? min_ : 0; }
+    std::uint64_t max() const noexcept { return max_; }
+    double mean() const noexcept;
+
+    // The smallest bucket boundary at or below which the given percentage of the recorded
+    // values lie (0 < p <= 100)
+    std::uint64_t percentile(double p) const noexcept;
+
+  private:
+    static constexpr std::size_t sub_buckets{1ull << sub_bucket_bits};
+    static constexpr std::size_t n_buckets{(max_value_bits - sub_bucket_bits + 1) * sub_buckets};
+
+    static std::size_t bucket_for(std::uint64_t value) noexcept;
+    static std::uint64_t upper_bound_of(std::size_t bucket) noexcept;
+
+    std::array<std::uint64_t, n_buckets> counts_{};
+    std::uint64_t count_{};
+    std::uint64_t sum_{};
+    std::uint64_t min_{std::numeric_limits<std::uint64_t>::max()};
+    std::uint64_t max_{};
+  };
+}
+
+#endif // meld_utilities_histogram_hpp
@@ -0,0 +1,35 @@
+#include "meld/utilities/periodic_sampler.hpp"
+
+#include <stdexcept>
+
+namespace meld {
+  periodic_sampler::periodic_sampler(std::chrono::milliseconds const interval,
+                                     std::function<void()> sample) :
+    interval_{interval}, sample_{std::move(sample)}
+  {
+    if (interval_.count() <= 0) {
+      throw std::runtime_error("The sampling interval must be positive.");
+    }
+    thread_ = std::thread{[this] { sample_until_stopped(); }};
+  }
+
+  periodic_sampler::~periodic_sampler()
+  {
+    {
+      std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    stopped_.notify_one();
+    thread_.join();
+  }
+
+  void periodic_sampler::sample_until_stopped()
+  {
+    std::unique_lock lock{mutex_};
+    while (not stopped_.wait_for(lock, interval_, [this] { return stop_; })) {
+      lock.unlock();
+      sample_();
+      lock.lock();
+    }
+  }
+}
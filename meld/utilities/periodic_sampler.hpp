@@ -0,0 +1,39 @@
+#ifndef meld_utilities_periodic_sampler_hpp
+#define meld_utilities_periodic_sampler_hpp
+
+// =======================================================================================
+// A periodic_sampler invokes a function every 'interval' on a background thread, from
+// its construction until its destruction.  The destructor wakes the thread immediately
+// (i.e. it does not wait for the end of the current interval) and returns once any
+// ongoing invocation has completed.  The function is invoked without any lock held; it
+// must synchronize its access to data shared with other threads.
+// =======================================================================================
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace meld {
+  class periodic_sampler {
+  public:
+    periodic_sampler(std::chrono::milliseconds interval, std::function<void()> sample);
+    ~periodic_sampler();
+
+    periodic_sampler(periodic_sampler const&) = delete;
+    periodic_sampler& operator=(periodic_sampler const&) = delete;
+
+  private:
+    void sample_until_stopped();
+
+    std::chrono::milliseconds const interval_;
+    std::function<void()> sample_;
+    std::mutex mutex_;
+    std::condition_variable stopped_;
+    bool stop_{false};
+    std::thread thread_;
+  };
+}
+
+#endif // meld_utilities_periodic_sampler_hpp
@@ -2,7 +2,15 @@
 
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
 #include <sys/resource.h>
+#include <unistd.h>
 
 using namespace std::chrono;
 
@@ -13,36 +21,190 @@ constexpr double mem_denominator{1e6};
 #endif
 
 namespace {
-  struct metrics {
-    double elapsed_time;
-    double max_rss;
-  };
+  double to_seconds(timeval const& tv) { return tv.tv_sec + tv.tv_usec / 1e6; }
 
-  metrics get_rusage() noexcept
+#if __linux__
+  void read_io(meld::resource_snapshot& snapshot)
   {
-    rusage used;
-    getrusage(RUSAGE_SELF, &used);
-    auto const [secs, microsecs] = used.ru_utime;
-    return {.elapsed_time = secs + microsecs / 1e6, .max_rss = used.ru_maxrss / mem_denominator};
+    // Reading /proc/self/io may not be permitted (e.g. in some containers).
+    std::ifstream io{"/proc/self/io"};
+    std::string key;
+    std::uint64_t value{};
+    while (io >> key >> value) {
+      if (key == "read_bytes:") {
+        snapshot.read_bytes = value;
+      }
+      else if (key == "write_bytes:") {
+        snapshot.written_bytes = value;
+      }
+    }
+  }
+
+  void read_threads(meld::resource_snapshot& snapshot)
+  {
+    static double const ticks_per_second = sysconf(_SC_CLK_TCK);
+    std::error_code ec;
+    for (auto const& entry : std::filesystem::directory_iterator{"/proc/self/task", ec}) {
+      std::ifstream stat_file{entry.path() / "stat"};
+      std::string const stat{std::istreambuf_iterator<char>{stat_file}, {}};
+      // The thread name (second field) is enclosed in parentheses, and may itself contain
+      // spaces and parentheses.
+      auto const open = stat.find('(');
+      auto const close = stat.rfind(')');
+      if (open == std::string::npos or close == std::string::npos or close < open) {
+        continue;
+      }
+
+      // The fields following the name start with the state (third field); the user and
+      // system times are the fourteenth and fifteenth fields, in clock ticks.
+      std::istringstream fields{stat.substr(close + 1)};
+      std::string field;
+      for (int field_number = 3; field_number != 14; ++field_number) {
+        fields >> field;
+      }
+      unsigned long user_ticks{}, system_ticks{};
+      if (not(fields >> user_ticks >> system_ticks)) {
+        continue;
+      }
+      snapshot.threads.push_back({.tid = std::stoi(entry.path().filename().string()),
+                                  .name = stat.substr(open + 1, close - open - 1),
+                                  .user_time = user_ticks / ticks_per_second,
+                                  .system_time = system_ticks / ticks_per_second});
+    }
+    std::ranges::sort(snapshot.threads, {}, &meld::thread_cpu_time::tid);
   }
+#endif
 }
 
 namespace meld {
-  resource_usage::resource_usage() noexcept :
-    begin_wall_{steady_clock::now()}, begin_cpu_{get_rusage().elapsed_time}
+  resource_snapshot take_resource_snapshot()
+  {
+    rusage used;
+    getrusage(RUSAGE_SELF, &used);
+    resource_snapshot result{.time = steady_clock::now(),
+                             .user_time = to_seconds(used.ru_utime),
+                             .system_time = to_seconds(used.ru_stime),
+                             .voluntary_context_switches = used.ru_nvcsw,
+                             .involuntary_context_switches = used.ru_nivcsw,
+                             .minor_page_faults = used.ru_minflt,
+                             .major_page_faults = used.ru_majflt,
+                             .read_bytes = 0,
+                             .written_bytes = 0,
+                             .max_rss = used.ru_maxrss / mem_denominator,
+                             .threads = {}};
+#if __linux__
+    read_io(result);
+    read_threads(result);
+#endif
+    return result;
+  }
+
+  resource_usage::resource_usage(std::size_t const max_samples) :
+    initial_{take_resource_snapshot()}, max_samples_{max_samples}
   {
+    if (max_samples_ == 0) {
+      throw std::runtime_error("At least one resource sample must be retained.");
+    }
   }
 
   resource_usage::~resource_usage()
   {
-    auto const [elapsed_time, max_rss] = get_rusage();
-    auto const end_wall = steady_clock::now();
-    auto const cpu_time = elapsed_time - begin_cpu_;
-    auto const real_time = duration_cast<nanoseconds>(end_wall - begin_wall_).count() / 1e9;
-    spdlog::info("CPU time: {:.5f}s  Real time: {:.5f}s  CPU efficiency: {:6.2f}%",
+    sampler_.reset();
+
+    auto const used = usage();
+    auto const cpu_time = used.user_time + used.system_time;
+    auto const real_time = duration_cast<nanoseconds>(used.time - initial_.time).count() / 1e9;
+    spdlog::info("CPU time: {:.5f}s (user: {:.5f}s, system: {:.5f}s)  Real time: {:.5f}s  CPU "
+                 "efficiency: {:6.2f}%",
                  cpu_time,
+                 used.user_time,
+                 used.system_time,
                  real_time,
                  cpu_time / real_time * 100);
-    spdlog::info("Max. RSS: {:.3f} MB", max_rss);
+    spdlog::info("Context switches: {} voluntary, {} involuntary  Page faults: {} minor, {} major",
+                 used.voluntary_context_switches,
+                 used.involuntary_context_switches,
+                 used.minor_page_faults,
+                 used.major_page_faults);
+    spdlog::info("I/O: {:.3f} MB read, {:.3f} MB written",
+                 used.read_bytes / 1e6,
+                 used.written_bytes / 1e6);
+    for (auto const& [tid, name, user_time, system_time] : used.threads) {
+      spdlog::debug("CPU time of thread {} ({}): {:.5f}s (user: {:.5f}s, system: {:.5f}s)",
+                    tid,
+                    name,
+                    user_time + system_time,
+                    user_time,
+                    system_time);
+    }
+    spdlog::info("Max. RSS: {:.3f} MB", used.max_rss);
+  }
+
+  void resource_usage::sample_periodically(std::chrono::milliseconds const interval)
+  {
+    if (interval.count() <= 0) {
+      throw std::runtime_error("The resource-sampling interval must be positive.");
+    }
+    if (sampler_) {
+      throw std::runtime_error("Resources are already being sampled periodically.");
+    }
+    sampler_.emplace(interval, [this] { sample(); });
+  }
+
+  void resource_usage::sample()
+  {
+    auto snapshot = take_resource_snapshot();
+    std::lock_guard lock{mutex_};
+    record(std::move(snapshot));
+  }
+
+  void resource_usage::record(resource_snapshot snapshot)
+  {
+    if (samples_.size() == max_samples_) {
+      samples_.pop_front();
+    }
+    samples_.push_back(std::move(snapshot));
+  }
+
+  std::vector<resource_snapshot> resource_usage::samples() const
+  {
+    std::lock_guard lock{mutex_};
+    return {samples_.begin(), samples_.end()};
+  }
+
+  resource_snapshot resource_usage::usage() const
+  {
+    auto result = take_resource_snapshot();
+    result.user_time -= initial_.user_time;
+    result.system_time -= initial_.system_time;
+    result.voluntary_context_switches -= initial_.voluntary_context_switches;
+    result.involuntary_context_switches -= initial_.involuntary_context_switches;
+    result.minor_page_faults -= initial_.minor_page_faults;
+    result.major_page_faults -= initial_.major_page_faults;
+    result.read_bytes -= std::min(result.read_bytes, initial_.read_bytes);
+    result.written_bytes -= std::min(result.written_bytes, initial_.written_bytes);
+    for (auto& thread : result.threads) {
+      auto it = std::ranges::find(initial_.threads, thread.tid, &thread_cpu_time::tid);
+      if (it != initial_.threads.end()) {
+        thread.user_time -= it->user_time;
+        thread.system_time -= it->system_time;
+      }
+    }
+    return result;
+  }
+
+  std::size_t current_rss() noexcept
+  {
+#if __linux__
+    // The second field of /proc/self/statm is the number of resident pages.
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t total_pages{}, resident_pages{};
+    if (statm >> total_pages >> resident_pages) {
+      return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    rusage used;
+    getrusage(RUSAGE_SELF, &used);
+    return static_cast<std::size_t>(used.ru_maxrss / mem_denominator * 1e6);
   }
 }
@@ -2,22 +2,96 @@
 #define meld_utilities_resource_usage_hpp
 
 // =======================================================================================
-// The resource_usage class tracks the CPU time and real time during the lifetime of a
-// resource_usage object.  The destructor will also report the maximum RSS of the process.
+// The resource_usage class tracks the resources used by the process during the lifetime
+// of a resource_usage object:
+//
+//   - the user and system CPU time, and the real time,
+//   - the numbers of voluntary and involuntary context switches,
+//   - the numbers of minor and major page faults,
+//   - the numbers of bytes read from and written to storage (Linux only), and
+//   - the CPU time of each thread of the process (Linux only).
+//
+// A snapshot of the resources is taken when the object is constructed, whenever sample()
+// is called, and, if requested, periodically in a background thread.  Only the most
+// recent 'max_samples' snapshots are retained, so that periodic sampling uses a bounded
+// amount of memory however long the process runs.  The destructor reports the usage
+// since construction (and the maximum RSS of the process) through spdlog; the same
+// information is available programmatically through usage().
 // =======================================================================================
 
+#include "meld/utilities/periodic_sampler.hpp"
+
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace meld {
+  struct thread_cpu_time {
+    int tid;
+    std::string name;
+    double user_time;   // s
+    double system_time; // s
+  };
+
+  struct resource_snapshot {
+    std::chrono::steady_clock::time_point time;
+    double user_time;   // s
+    double system_time; // s
+    std::int64_t voluntary_context_switches;
+    std::int64_t involuntary_context_switches;
+    std::int64_t minor_page_faults;
+    std::int64_t major_page_faults;
+    std::uint64_t read_bytes;    // Zero if unavailable
+    std::uint64_t written_bytes; // Zero if unavailable
+    double max_rss;              // MB
+    std::vector<thread_cpu_time> threads;
+  };
+
+  // The resources used by the process up to now
+  resource_snapshot take_resource_snapshot();
+
   class resource_usage {
   public:
-    resource_usage() noexcept;
+    static constexpr std::size_t default_max_samples{1024};
+
+    explicit resource_usage(std::size_t max_samples = default_max_samples);
     ~resource_usage();
 
+    resource_usage(resource_usage const&) = delete;
+    resource_usage& operator=(resource_usage const&) = delete;
+
+    // Takes a snapshot every 'interval' until the object is destroyed
+    void sample_periodically(std::chrono::milliseconds interval);
+
+    resource_snapshot const& initial() const noexcept { return initial_; }
+    void sample();
+    // The retained snapshots, oldest first
+    std::vector<resource_snapshot> samples() const;
+
+    // The difference between the current snapshot and the one taken at construction
+    // (except for the time, which is that of the current snapshot).  The CPU times of
+    // threads started after construction are reported in full, and the maximum RSS is that
+    // of the process.
+    resource_snapshot usage() const;
+
   private:
-    std::chrono::time_point<std::chrono::steady_clock> begin_wall_;
-    double begin_cpu_;
+    void record(resource_snapshot snapshot); // Requires the mutex to be held
+
+    resource_snapshot const initial_;
+    std::size_t const max_samples_;
+    mutable std::mutex mutex_;
+    std::deque<resource_snapshot> samples_;
+    std::optional<periodic_sampler> sampler_;
   };
+
+  // The current resident set size of the process in bytes (the maximum RSS on platforms
+  // that do not provide the current value)
+  std::size_t current_rss() noexcept;
 }
 
 #endif // meld_utilities_resource_usage_hpp
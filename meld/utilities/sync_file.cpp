@@ -0,0 +1,29 @@
+#include "meld/utilities/sync_file.hpp"
+
+#include "fmt/format.h"
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace meld {
+  void sync_file(std::filesystem::path const& path)
+  {
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error(fmt::format("Could not open '{}' to sync it: {}",
+                                           path.string(),
+                                           std::generic_category().message(errno)));
+    }
+    int const rc = ::fsync(fd);
+    int const error = errno;
+    ::close(fd);
+    if (rc != 0) {
+      throw std::runtime_error(fmt::format(
+        "Could not sync '{}': {}", path.string(), std::generic_category().message(error)));
+    }
+  }
+}
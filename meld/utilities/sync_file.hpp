@@ -0,0 +1,12 @@
+#ifndef meld_utilities_sync_file_hpp
+#define meld_utilities_sync_file_hpp
+
+#include <filesystem>
+
+namespace meld {
+  // Flushes the contents of a file (or the entries of a directory) to the storage device
+  // with fsync; data written with an std::ofstream must first be flushed to the file.
+  void sync_file(std::filesystem::path const& path);
+}
+
+#endif // meld_utilities_sync_file_hpp
@@ -0,0 +1,74 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//             |
+//          allocate
+//             |
+//        sum_elements
+//
+// with allocation profiling enabled.  The test executable is linked with the replacements
+// of operator new and delete, so the allocations made by each invocation of 'allocate'
+// must be attributed to that node.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/allocation_profiler.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+using namespace meld;
+
+namespace {
+  constexpr auto n_events = 10u;
+  constexpr std::size_t n_elements{1000};
+
+  std::vector<int> allocate(unsigned int number)
+  {
+    return std::vector<int>(n_elements, static_cast<int>(number));
+  }
+
+  unsigned int sum_elements(std::vector<int> const& elements)
+  {
+    return std::accumulate(elements.begin(), elements.end(), 0u);
+  }
+}
+
+TEST_CASE("Attributing allocations to nodes", "[graph]")
+{
+  REQUIRE(allocations_interposed());
+
+  framework_graph g{test::numbered_events(n_events)};
+  g.enable_allocation_profiling();
+  g.with("allocate", allocate, concurrency::unlimited).transform("number").to("elements");
+  g.with("sum_elements", sum_elements, concurrency::unlimited).transform("elements").to("sum");
+  g.execute();
+
+  auto const statistics = g.statistics();
+  auto it = std::ranges::find(statistics, "allocate", &node_counts::name);
+  REQUIRE(it != statistics.end());
+  CHECK(it->allocations >= n_events);
+  CHECK(it->allocated_bytes >= n_events * n_elements * sizeof(int));
+}
+
+TEST_CASE("Allocations are counted only while their counters are current", "[graph]")
+{
+  allocation_counters counters;
+  auto* previous = attribute_allocations_to(&counters);
+  auto const elements = allocate(1);
+  attribute_allocations_to(previous);
+  auto const more_elements = allocate(2);
+
+  auto const total = counters.total();
+  CHECK(total.allocations == 1ull);
+  CHECK(total.bytes == n_elements * sizeof(int));
+  CHECK(total.deallocations == 0ull);
+}
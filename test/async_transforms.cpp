@@ -0,0 +1,235 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//             |
+//       calibrate (async)
+//             |
+//      record_calibrated (async)
+//
+// where the asynchronous nodes return futures that are fulfilled by a simulated remote
+// service.  The service answers only once all requests of a given kind are pending, which
+// is possible only if the TBB worker threads are not blocked while the futures are
+// outstanding.  Deferred futures, which are evaluated only upon retrieval, are also
+// supported.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace meld;
+using namespace std::chrono;
+
+namespace {
+  constexpr unsigned int n_events{20u};
+  constexpr unsigned int n_threads{2u};
+
+  // Counts the calls that are in progress at the same time
+  class concurrency_counter {
+  public:
+    void enter()
+    {
+      auto const current = ++current_;
+      auto max = max_.load();
+      while (current > max and not max_.compare_exchange_weak(max, current)) {}
+    }
+    void leave() { --current_; }
+    unsigned int max() const { return max_; }
+
+  private:
+    std::atomic<unsigned int> current_{};
+    std::atomic<unsigned int> max_{};
+  };
+
+  // Local stand-in for a service that answers its requests only once 'n_events' of them
+  // are pending.
+  class batching_service {
+  public:
+    std::future<unsigned int> calibrate(unsigned int const raw)
+    {
+      return request(calibrations_, [raw] { return raw * 2u; });
+    }
+
+    std::future<void> record(std::atomic<unsigned int>& sum, unsigned int const calibrated)
+    {
+      return request(records_, [&sum, calibrated] { sum += calibrated; });
+    }
+
+  private:
+    template <typename T>
+    struct pending_requests {
+      std::mutex mutex;
+      std::vector<std::pair<std::promise<T>, std::function<T()>>> requests;
+    };
+
+    template <typename T>
+    static std::future<T> request(pending_requests<T>& pending,
+                                  std::type_identity_t<std::function<T()>> answer)
+    {
+      std::promise<T> promise;
+      auto result = promise.get_future();
+      std::lock_guard lock{pending.mutex};
+      pending.requests.emplace_back(std::move(promise), std::move(answer));
+      if (pending.requests.size() == n_events) {
+        for (auto& [p, a] : pending.requests) {
+          if constexpr (std::is_void_v<T>) {
+            a();
+            p.set_value();
+          }
+          else {
+            p.set_value(a());
+          }
+        }
+        pending.requests.clear();
+      }
+      return result;
+    }
+
+    pending_requests<unsigned int> calibrations_;
+    pending_requests<void> records_;
+  };
+
+  constexpr unsigned int expected_sum = n_events * (n_events - 1u);
+}
+
+TEST_CASE("Blocking calls to a slow service", "[graph]")
+{
+  concurrency_counter calls;
+  std::atomic<unsigned int> sum{};
+
+  framework_graph g{test::numbered_events(n_events, "raw"), n_threads};
+  g.with(
+     "calibrate",
+     [&calls](unsigned int const raw) {
+       calls.enter();
+       auto result = std::async(std::launch::async, [raw] {
+                       sleep_for(1ms);
+                       return raw * 2u;
+                     }).get();
+       calls.leave();
+       return result;
+     },
+     concurrency::unlimited)
+    .transform("raw")
+    .to("calibrated");
+  g.with(
+     "record_calibrated",
+     [&sum](unsigned int const calibrated) { sum += calibrated; },
+     concurrency::unlimited)
+    .observe("calibrated");
+  g.execute();
+
+  CHECK(g.execution_counts("calibrate") == n_events);
+  CHECK(g.execution_counts("record_calibrated") == n_events);
+  CHECK(sum == expected_sum);
+
+  // Each worker thread is blocked for the duration of each call.
+  CHECK(calls.max() <= n_threads);
+}
+
+TEST_CASE("Asynchronous calls to a slow service", "[graph]")
+{
+  batching_service service;
+  std::atomic<unsigned int> sum{};
+
+  // With blocking calls, the service would never answer: only 'n_threads' requests could
+  // be pending at once.
+  framework_graph g{test::numbered_events(n_events, "raw"), n_threads};
+  g.with(
+     "calibrate",
+     [&service](unsigned int const raw) { return service.calibrate(raw); },
+     concurrency::unlimited)
+    .transform("raw")
+    .to("calibrated");
+  g.with(
+     "record_calibrated",
+     [&service, &sum](unsigned int const calibrated) { return service.record(sum, calibrated); },
+     concurrency::unlimited)
+    .observe("calibrated");
+  g.execute("async_transforms_t");
+
+  CHECK(g.execution_counts("calibrate") == n_events);
+  CHECK(g.execution_counts("record_calibrated") == n_events);
+  CHECK(g.product_counts("calibrate") == n_events);
+  CHECK(sum == expected_sum);
+}
+
+TEST_CASE("Results are resumed as soon as they are ready", "[graph]")
+{
+  // The result for the first event is provided only once the results of all other events
+  // have been recorded, so a ready result must not wait behind an outstanding one.
+  std::promise<unsigned int> held;
+  std::atomic<unsigned int> recorded{};
+  std::atomic<unsigned int> sum{};
+
+  framework_graph g{test::numbered_events(n_events, "raw"), n_threads};
+  g.with(
+     "calibrate",
+     [&held](unsigned int const raw) {
+       if (raw == 0u) {
+         return held.get_future();
+       }
+       return std::async(std::launch::async, [raw] {
+         sleep_for(1ms);
+         return raw * 2u;
+       });
+     },
+     concurrency::unlimited)
+    .transform("raw")
+    .to("calibrated");
+  g.with(
+     "record_calibrated",
+     [&held, &recorded, &sum](unsigned int const calibrated) {
+       sum += calibrated;
+       if (++recorded == n_events - 1u) {
+         held.set_value(0u);
+       }
+     },
+     concurrency::unlimited)
+    .observe("calibrated");
+  g.execute();
+
+  CHECK(recorded == n_events);
+  CHECK(sum == expected_sum);
+}
+
+TEST_CASE("Deferred asynchronous calls", "[graph]")
+{
+  std::atomic<unsigned int> sum{};
+
+  framework_graph g{test::numbered_events(n_events, "raw"), n_threads};
+  g.with(
+     "calibrate",
+     [](unsigned int const raw) {
+       return std::async(std::launch::deferred, [raw] { return raw * 2u; });
+     },
+     concurrency::unlimited)
+    .transform("raw")
+    .to("calibrated");
+  g.with(
+     "record_calibrated",
+     [&sum](unsigned int const calibrated) {
+       return std::async(std::launch::deferred, [&sum, calibrated] { sum += calibrated; });
+     },
+     concurrency::unlimited)
+    .observe("calibrated");
+  g.execute();
+
+  CHECK(g.execution_counts("calibrate") == n_events);
+  CHECK(g.product_counts("calibrate") == n_events);
+  CHECK(sum == expected_sum);
+}
@@ -0,0 +1,61 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//             |
+//          double
+//             |
+//       verify_double
+//
+// with backlog sampling enabled, and checks that the high-water marks of the buffers of
+// both nodes are reported.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <ranges>
+
+using namespace meld;
+using namespace std::chrono_literals;
+
+namespace {
+  constexpr auto n_events = 20u;
+
+  unsigned int twice(unsigned int number)
+  {
+    spin_for(1ms);
+    return 2 * number;
+  }
+}
+
+TEST_CASE("Sampling backlogs", "[graph]")
+{
+  framework_graph g{test::numbered_events(n_events)};
+  CHECK_THROWS(g.enable_backlog_sampling(0ms));
+  g.enable_backlog_sampling(1ms);
+  g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+  g.with(
+     "verify_double",
+     [](unsigned int doubled) {
+       spin_for(1ms);
+       CHECK(doubled % 2 == 0);
+     },
+     concurrency::serial)
+    .observe("doubled");
+  g.execute();
+
+  auto const marks = g.backlog_high_water_marks();
+  for (auto const* buffer :
+       {"double/stores", "double/waiting", "double/flush_flags", "verify_double/stores"}) {
+    CHECK(marks.contains(buffer));
+  }
+  for (auto const& mark : marks | std::views::values) {
+    CHECK(mark.high_water <= 2 * n_events + 1);
+  }
+}
@@ -0,0 +1,407 @@
+// =======================================================================================
+// The scaling harness runs the benchmark jobs (benchmark-NN.jsonnet) for each requested
+// maximum parallelism (-j) and number of events, and records for each combination:
+//
+//   - the throughput (events per second of wall-clock time),
+//   - the CPU efficiency (CPU time divided by the product of wall-clock time and
+//     parallelism),
+//   - the maximum RSS of the job, and
+//   - the strong-scaling speedup and parallel efficiency, relative to the smallest
+//     parallelism for the same job and number of events.
+//
+// The number of events is set by overriding the 'n_events' parameter of the job's source.
+// Each combination is run several times, and the fastest run is reported.  The results
+// are written to a JSON file, which may later serve as the baseline of another run; with
+// a baseline, throughput drops and RSS increases beyond the given tolerances are reported
+// as regressions, and the harness exits with a non-zero status.  The strong-scaling
+// curves (at the largest number of events) can be rendered as an SVG plot.
+//
+// Example (a single command line):
+//
+//   scaling_harness --meld bin/meld --benchmark-dir test/benchmarks -j 1 2 4 8
+//                   --events 100000 --baseline baseline.json --plot scaling.svg
+// =======================================================================================
+
+#include "boost/json.hpp"
+#include "boost/program_options.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace bpo = boost::program_options;
+namespace fs = std::filesystem;
+namespace json = boost::json;
+using namespace std::chrono;
+
+namespace {
+  struct measurement {
+    std::string benchmark;
+    std::size_t events;
+    int parallelism;
+    double wall_time;   // s
+    double cpu_time;    // s
+    double max_rss;     // MB
+    double speedup{1.}; // Relative to the smallest parallelism
+    double events_per_second() const { return events / wall_time; }
+    double cpu_efficiency() const { return cpu_time / (wall_time * parallelism); }
+  };
+
+  using key_t = std::tuple<std::string, std::size_t, int>;
+  key_t key_of(measurement const& m) { return {m.benchmark, m.events, m.parallelism}; }
+
+  double to_seconds(timeval const& tv) { return tv.tv_sec + tv.tv_usec / 1e6; }
+
+  // Runs 'meld -c config -j parallelism', with its output redirected to 'log'
+  std::tuple<double, double, double> run_job(fs::path const& meld,
+                                             fs::path const& config,
+                                             int const parallelism,
+                                             fs::path const& log)
+  {
+    auto const j = std::to_string(parallelism);
+    auto const start = steady_clock::now();
+    pid_t const pid = fork();
+    if (pid < 0) {
+      throw std::runtime_error("Could not start " + meld.string());
+    }
+    if (pid == 0) {
+      int const fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+      }
+      execl(meld.c_str(), meld.c_str(), "-c", config.c_str(), "-j", j.c_str(), nullptr);
+      _exit(127);
+    }
+
+    int status{};
+    rusage usage{};
+    while (wait4(pid, &status, 0, &usage) < 0) {
+      if (errno != EINTR) {
+        throw std::runtime_error("Could not wait for " + meld.string() + ": " +
+                                 std::strerror(errno));
+      }
+    }
+    auto const wall_time = duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1e9;
+    if (not WIFEXITED(status) or WEXITSTATUS(status) != 0) {
+      throw std::runtime_error("Job " + config.string() + " failed with -j " + j + " (see " +
+                               log.string() + ")");
+    }
+    return {wall_time,
+            to_seconds(usage.ru_utime) + to_seconds(usage.ru_stime),
+            usage.ru_maxrss / 1e3};
+  }
+
+  // A configuration that runs 'benchmark' with 'n_events' events
+  fs::path write_config(fs::path const& benchmark, std::size_t const n_events)
+  {
+    fs::path result =
+      benchmark.stem().string() + "-" + std::to_string(n_events) + "-events.jsonnet";
+    std::ofstream config{result};
+    config << "(import '" << fs::absolute(benchmark).string() << "') + { source+: { n_events: "
+           << n_events << " } }\n";
+    return result;
+  }
+
+  void compute_speedups(std::vector<measurement>& measurements)
+  {
+    std::map<std::pair<std::string, std::size_t>, measurement const*> reference;
+    for (auto const& m : measurements) {
+      auto& ref = reference[{m.benchmark, m.events}];
+      if (ref == nullptr or m.parallelism < ref->parallelism) {
+        ref = &m;
+      }
+    }
+    std::map<std::pair<std::string, std::size_t>, double> reference_times;
+    for (auto const& [k, ref] : reference) {
+      reference_times[k] = ref->wall_time;
+    }
+    for (auto& m : measurements) {
+      m.speedup = reference_times.at({m.benchmark, m.events}) / m.wall_time;
+    }
+  }
+
+  json::object to_json(measurement const& m, int const reference_parallelism)
+  {
+    return {{"benchmark", m.benchmark},
+            {"events", m.events},
+            {"parallelism", m.parallelism},
+            {"wall_time", m.wall_time},
+            {"events_per_second", m.events_per_second()},
+            {"cpu_efficiency", m.cpu_efficiency()},
+            {"max_rss_mb", m.max_rss},
+            {"speedup", m.speedup},
+            {"parallel_efficiency", m.speedup * reference_parallelism / m.parallelism}};
+  }
+
+  void write_results(std::vector<measurement> const& measurements, fs::path const& file)
+  {
+    json::array results;
+    for (auto const& m : measurements) {
+      auto const reference = std::ranges::min(
+        measurements | std::views::filter([&m](measurement const& other) {
+          return other.benchmark == m.benchmark and other.events == m.events;
+        }) |
+        std::views::transform(&measurement::parallelism));
+      results.push_back(to_json(m, reference));
+    }
+    json::object document{{"hardware_concurrency", std::thread::hardware_concurrency()},
+                          {"results", std::move(results)}};
+    std::ofstream{file} << json::serialize(document) << '\n';
+  }
+
+  std::map<key_t, json::object> read_baseline(fs::path const& file)
+  {
+    std::ifstream input{file};
+    if (not input) {
+      throw std::runtime_error("Cannot read baseline file " + file.string());
+    }
+    std::string const contents{std::istreambuf_iterator<char>{input}, {}};
+    std::map<key_t, json::object> result;
+    for (auto const& entry : json::parse(contents).at("results").as_array()) {
+      auto const& object = entry.as_object();
+      result.emplace(key_t{json::value_to<std::string>(object.at("benchmark")),
+                           json::value_to<std::size_t>(object.at("events")),
+                           json::value_to<int>(object.at("parallelism"))},
+                     object);
+    }
+    return result;
+  }
+
+  // Returns the number of regressions
+  std::size_t compare(std::vector<measurement> const& measurements,
+                      std::map<key_t, json::object> const& baseline,
+                      double const tolerance,
+                      double const rss_tolerance)
+  {
+    std::size_t regressions{};
+    for (auto const& m : measurements) {
+      auto it = baseline.find(key_of(m));
+      if (it == baseline.end()) {
+        continue;
+      }
+      auto const base_rate = json::value_to<double>(it->second.at("events_per_second"));
+      auto const base_rss = json::value_to<double>(it->second.at("max_rss_mb"));
+      auto const rate_change = m.events_per_second() / base_rate - 1.;
+      auto const rss_change = m.max_rss / base_rss - 1.;
+      bool const regressed = rate_change < -tolerance or rss_change > rss_tolerance;
+      regressions += regressed;
+      std::printf("%-14s %9zu events  -j %-3d  throughput %+6.1f%%  RSS %+6.1f%%%s\n",
+                  m.benchmark.c_str(),
+                  m.events,
+                  m.parallelism,
+                  rate_change * 100,
+                  rss_change * 100,
+                  regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+  }
+
+  // Renders the speedup as a function of parallelism, for the largest number of events
+  void plot(std::vector<measurement> const& measurements, fs::path const& file)
+  {
+    auto const events =
+      std::ranges::max(measurements | std::views::transform(&measurement::events));
+    std::map<std::string, std::vector<measurement const*>> curves;
+    int max_parallelism{1};
+    for (auto const& m : measurements) {
+      if (m.events == events) {
+        curves[m.benchmark].push_back(&m);
+        max_parallelism = std::max(max_parallelism, m.parallelism);
+      }
+    }
+
+    constexpr double width{640}, height{480}, margin{60};
+    auto const x = [&](double const p) {
+      return margin + (p - 1) / std::max(max_parallelism - 1, 1) * (width - 2 * margin);
+    };
+    auto const y = [&](double const s) {
+      return height - margin - (s - 1) / std::max(max_parallelism - 1, 1) * (height - 2 * margin);
+    };
+    char const* colors[] = {"#1f77b4",
+                            "#ff7f0e",
+                            "#2ca02c",
+                            "#d62728",
+                            "#9467bd",
+                            "#8c564b",
+                            "#e377c2",
+                            "#7f7f7f",
+                            "#bcbd22",
+                            "#17becf"};
+
+    std::ofstream svg{file};
+    svg << "<svg xmlns='http://www.w3.org/2000/svg' width='" << width << "' height='" << height
+        << "' font-family='sans-serif' font-size='12'>\n"
+        << "<rect width='100%' height='100%' fill='white'/>\n"
+        << "<text x='" << width / 2 << "' y='20' text-anchor='middle'>Strong scaling (" << events
+        << " events)</text>\n"
+        << "<text x='" << width / 2 << "' y='" << height - 15
+        << "' text-anchor='middle'>Maximum parallelism (-j)</text>\n"
+        << "<text x='15' y='" << height / 2 << "' text-anchor='middle' transform='rotate(-90 15 "
+        << height / 2 << ")'>Speedup</text>\n"
+        << "<line x1='" << x(1) << "' y1='" << y(1) << "' x2='" << x(max_parallelism) << "' y2='"
+        << y(1) << "' stroke='black'/>\n"
+        << "<line x1='" << x(1) << "' y1='" << y(1) << "' x2='" << x(1) << "' y2='"
+        << y(max_parallelism) << "' stroke='black'/>\n"
+        << "<line x1='" << x(1) << "' y1='" << y(1) << "' x2='" << x(max_parallelism) << "' y2='"
+        << y(max_parallelism) << "' stroke='gray' stroke-dasharray='4'/>\n";
+    for (int p = 1; p <= max_parallelism; p *= 2) {
+      svg << "<text x='" << x(p) << "' y='" << y(1) + 18 << "' text-anchor='middle'>" << p
+          << "</text>\n"
+          << "<text x='" << x(1) - 8 << "' y='" << y(p) + 4 << "' text-anchor='end'>" << p
+          << "</text>\n";
+    }
+
+    std::size_t i{};
+    for (auto& [benchmark, points] : curves) {
+      std::ranges::sort(points, {}, &measurement::parallelism);
+      auto const* color = colors[i % std::size(colors)];
+      svg << "<polyline fill='none' stroke='" << color << "' stroke-width='2' points='";
+      for (auto const* m : points) {
+        svg << x(m->parallelism) << ',' << y(m->speedup) << ' ';
+      }
+      svg << "'/>\n"
+          << "<text x='" << width - margin + 5 << "' y='" << margin + 15 * i << "' fill='"
+          << color << "'>" << benchmark << "</text>\n";
+      ++i;
+    }
+    svg << "</svg>\n";
+  }
+
+  std::vector<int> default_parallelisms()
+  {
+    int const n = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<int> result;
+    for (int p = 1; p < n; p *= 2) {
+      result.push_back(p);
+    }
+    result.push_back(n);
+    return result;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  bpo::options_description desc{"\nUsage: scaling_harness --meld <meld executable> "
+                                "--benchmark-dir <directory> [other-options]\n\nOptions"};
+  fs::path meld, benchmark_dir, output, baseline, plot_file;
+  std::vector<std::string> benchmarks;
+  std::vector<int> parallelisms;
+  std::vector<std::size_t> events;
+  unsigned repetitions{};
+  double tolerance{}, rss_tolerance{};
+  // clang-format off
+  desc.add_options()
+    ("help,h", "Produce help message")
+    ("meld", bpo::value(&meld)->required(), "The meld executable")
+    ("benchmark-dir", bpo::value(&benchmark_dir)->required(),
+       "Directory containing the benchmark-NN.jsonnet jobs")
+    ("benchmarks", bpo::value(&benchmarks)->multitoken(),
+       "Jobs to run, e.g. 'benchmark-01' (default: all jobs in the benchmark directory)")
+    ("parallel,j", bpo::value(&parallelisms)->multitoken(),
+       "Maximum parallelisms (default: powers of two up to the number of hardware threads)")
+    ("events", bpo::value(&events)->multitoken()->default_value({100'000}, "100000"),
+       "Numbers of events")
+    ("repetitions", bpo::value(&repetitions)->default_value(3), "Runs per combination")
+    ("output,o", bpo::value(&output)->default_value("scaling_results.json"), "Results file")
+    ("baseline", bpo::value(&baseline), "Results file against which to compare")
+    ("tolerance", bpo::value(&tolerance)->default_value(0.1),
+       "Fractional throughput drop reported as a regression")
+    ("rss-tolerance", bpo::value(&rss_tolerance)->default_value(0.25),
+       "Fractional max.-RSS increase reported as a regression")
+    ("plot", bpo::value(&plot_file), "SVG file to which the strong-scaling curves are written");
+  // clang-format on
+
+  try {
+    bpo::variables_map vm;
+    bpo::store(bpo::parse_command_line(argc, argv, desc), vm);
+    if (vm.count("help")) {
+      std::cout << desc << '\n';
+      return 0;
+    }
+    bpo::notify(vm);
+
+    if (benchmarks.empty()) {
+      for (auto const& entry : fs::directory_iterator{benchmark_dir}) {
+        auto const name = entry.path().stem().string();
+        if (entry.path().extension() == ".jsonnet" and name.starts_with("benchmark-")) {
+          benchmarks.push_back(name);
+        }
+      }
+      std::ranges::sort(benchmarks);
+    }
+    if (parallelisms.empty()) {
+      parallelisms = default_parallelisms();
+    }
+    if (repetitions == 0) {
+      throw std::runtime_error("At least one repetition is required.");
+    }
+
+    std::vector<measurement> measurements;
+    for (auto const& benchmark : benchmarks) {
+      for (auto const n_events : events) {
+        auto const config = write_config(benchmark_dir / (benchmark + ".jsonnet"), n_events);
+        for (auto const parallelism : parallelisms) {
+          measurement best{benchmark, n_events, parallelism, 0., 0., 0.};
+          for (unsigned r = 0; r != repetitions; ++r) {
+            auto const log = config.stem().string() + "-j" + std::to_string(parallelism) + ".log";
+            auto const [wall_time, cpu_time, max_rss] = run_job(meld, config, parallelism, log);
+            if (r == 0 or wall_time < best.wall_time) {
+              best.wall_time = wall_time;
+              best.cpu_time = cpu_time;
+              best.max_rss = max_rss;
+            }
+          }
+          std::printf("%-14s %9zu events  -j %-3d  %12.0f events/s  CPU efficiency %5.1f%%  "
+                      "max. RSS %8.1f MB\n",
+                      benchmark.c_str(),
+                      n_events,
+                      parallelism,
+                      best.events_per_second(),
+                      best.cpu_efficiency() * 100,
+                      best.max_rss);
+          measurements.push_back(std::move(best));
+        }
+      }
+    }
+
+    compute_speedups(measurements);
+    write_results(measurements, output);
+    if (not plot_file.empty()) {
+      plot(measurements, plot_file);
+    }
+    if (not baseline.empty()) {
+      auto const regressions =
+        compare(measurements, read_baseline(baseline), tolerance, rss_tolerance);
+      if (regressions != 0) {
+        std::cerr << "Error: " << regressions << " regression(s) with respect to "
+                  << baseline.string() << ".\n";
+        return 1;
+      }
+    }
+  }
+  catch (std::exception const& e) {
+    std::cerr << "Error: " << e.what() << '\n';
+    return 2;
+  }
+}
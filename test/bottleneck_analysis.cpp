@@ -0,0 +1,114 @@
+// =======================================================================================
+// The first test analyzes the (synthetic) timings of the following graph
+//
+//           a (serial)
+//           |
+//      +----+----+
+//      |         |
+//      b         c
+//      |         |
+//      +----+----+
+//           |
+//           d (serial)
+//
+// for which the critical path is a -> b -> d.  The second test executes the graph
+//
+//        Multiplexer
+//             |
+//          double
+//             |
+//      sum_numbers(*)
+//
+// where the asterisk (*) indicates a serial fold over the full job, and checks that the
+// analysis reflects the structure of the graph.  The last test checks that a predicate
+// specified without its module label is resolved to the registered predicate.
+// =======================================================================================
+
+#include "meld/configuration.hpp"
+#include "meld/core/bottleneck_analysis.hpp"
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace meld;
+using namespace std::chrono_literals;
+
+namespace {
+  constexpr std::uint64_t ms{1'000'000}; // ns
+
+  constexpr auto n_events = 20u;
+
+  unsigned int twice(unsigned int number)
+  {
+    spin_for(1ms);
+    return 2 * number;
+  }
+  void add(std::atomic<unsigned int>& counter, unsigned int number) { counter += number; }
+  bool is_even(unsigned int number) { return number % 2 == 0; }
+}
+
+TEST_CASE("Analyzing synthetic timings", "[graph]")
+{
+  std::vector<node_profile> const nodes{
+    {"a", "transform", concurrency::serial.value, 10, 10 * ms, 0, {}},
+    {"b", "transform", concurrency::unlimited.value, 10, 30 * ms, 50 * ms, {"a"}},
+    {"c", "transform", concurrency::unlimited.value, 10, 20 * ms, 5 * ms, {"a"}},
+    {"d", "fold", concurrency::serial.value, 1, 1 * ms, 1 * ms, {"b", "c"}}};
+
+  auto const report = analyze_bottlenecks(nodes, 4, 0.061, 2);
+  CHECK(report.critical_path == std::vector<std::string>{"a", "b", "d"});
+  CHECK_THAT(report.critical_path_time, Catch::Matchers::WithinRel(5e-3));
+  CHECK_THAT(report.total_execution_time, Catch::Matchers::WithinRel(61e-3));
+  CHECK_THAT(report.serial_execution_time, Catch::Matchers::WithinRel(11e-3));
+
+  auto const serial_fraction = 11. / 61.;
+  CHECK_THAT(report.serial_fraction, Catch::Matchers::WithinRel(serial_fraction));
+  CHECK_THAT(report.speedup_ceiling,
+             Catch::Matchers::WithinRel(1. / (serial_fraction + (1. - serial_fraction) / 4)));
+  CHECK_THAT(report.effective_parallelism, Catch::Matchers::WithinRel(1.));
+
+  REQUIRE(report.top_waiting.size() == 2ull);
+  CHECK(report.top_waiting[0].name == "b");
+  CHECK_THAT(report.top_waiting[0].mean_wait, Catch::Matchers::WithinRel(5e-3));
+  CHECK(report.top_waiting[1].name == "c");
+}
+
+TEST_CASE("Analyzing an executed graph", "[graph]")
+{
+  framework_graph g{test::numbered_events(n_events)};
+  g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+  g.with("sum_numbers", add, concurrency::serial).fold("doubled").to("sum");
+  g.execute();
+
+  auto const report = g.bottlenecks();
+  CHECK(report.critical_path == std::vector<std::string>{"double", "sum_numbers"});
+  CHECK(report.serial_fraction > 0.);
+  CHECK(report.serial_fraction < 1.);
+  CHECK(report.speedup_ceiling >= 1.);
+  CHECK(report.effective_parallelism > 0.);
+}
+
+TEST_CASE("Predicates specified without their module labels are on the critical path",
+          "[graph]")
+{
+  boost::json::object module_config;
+  module_config["module_label"] = "mod";
+  configuration const config{module_config};
+
+  framework_graph g{test::numbered_events(n_events)};
+  auto m = g.proxy(config);
+  m.with("evens_only", is_even, concurrency::unlimited).evaluate("number");
+  m.with("sum_numbers", add, concurrency::serial).when("evens_only").fold("number").to("sum");
+  g.execute();
+
+  CHECK(g.execution_counts("mod:sum_numbers") == n_events / 2);
+  auto const report = g.bottlenecks();
+  CHECK(report.critical_path == std::vector<std::string>{"mod:evens_only", "mod:sum_numbers"});
+}
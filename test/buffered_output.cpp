@@ -0,0 +1,88 @@
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ranges>
+#include <set>
+#include <thread>
+
+using namespace meld;
+using namespace std::chrono_literals;
+
+namespace {
+  constexpr unsigned int n_events{50u};
+
+  struct disk_statistics {
+    void reset()
+    {
+      read = written = max_outstanding = 0u;
+      threads.clear();
+    }
+
+    std::atomic<unsigned int> read{};
+    std::atomic<unsigned int> written{};
+    std::atomic<unsigned int> max_outstanding{};
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+  } stats;
+
+  struct slow_disk {
+    void write(product_store const& store) const
+    {
+      if (store.id()->depth() == 0ull) {
+        return;
+      }
+      auto const outstanding = stats.read - ++stats.written;
+      unsigned int previous = stats.max_outstanding;
+      while (outstanding > previous and
+             not stats.max_outstanding.compare_exchange_weak(previous, outstanding)) {}
+      {
+        std::lock_guard lock{stats.mutex};
+        stats.threads.insert(std::this_thread::get_id());
+      }
+      sleep_for(1ms);
+    }
+  };
+
+  void events(framework_driver& driver)
+  {
+    auto job_store = product_store::base();
+    driver.yield(job_store);
+    for (unsigned int i : std::views::iota(0u, n_events)) {
+      auto store = job_store->make_child(i, "event");
+      store->add_product("number", i);
+      ++stats.read;
+      driver.yield(store);
+    }
+  }
+}
+
+TEST_CASE("Unbuffered output", "[graph]")
+{
+  stats.reset();
+  framework_graph g{events};
+  g.make<slow_disk>().output_with(&slow_disk::write, concurrency::serial);
+  g.execute();
+
+  CHECK(stats.written == n_events);
+}
+
+TEST_CASE("Buffered output", "[graph]")
+{
+  stats.reset();
+  framework_graph g{events};
+  g.make<slow_disk>().output_with(&slow_disk::write, concurrency::serial).buffered(4, 2, 5ms);
+  g.execute();
+
+  CHECK(stats.written == n_events);
+  CHECK(stats.threads.size() == 1ull);
+
+  // Without backpressure, the source would read all events before the slow writes
+  // complete.
+  CHECK(stats.max_outstanding < n_events / 2);
+}
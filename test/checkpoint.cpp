@@ -0,0 +1,142 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//                   Multiplexer
+//          ____________/   |   \____________
+//         |                |                |
+//     job_add(*)       run_add(^)      record_event
+//         |                |
+//   verify_job_sum   verify_run_sum
+//
+// where the asterisk (*) indicates a fold step over the full job, and the caret (^)
+// represents a fold step over each run.  The 'record_event' observer keeps a copy of the
+// checkpoint that exists while the fourth run is processed, emulating a job that fails
+// at that point.  A second job then resumes from the copied checkpoint.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace meld;
+
+namespace {
+  constexpr auto n_runs = 5u;
+  constexpr auto n_events = 4u;
+  constexpr unsigned int run_sum = 6u; // 0 + 1 + 2 + 3
+  constexpr unsigned int job_sum = n_runs * run_sum;
+
+  void add(std::atomic<unsigned int>& counter, unsigned int number) { counter += number; }
+  void collect(std::vector<unsigned int>& numbers, unsigned int number)
+  {
+    numbers.push_back(number);
+  }
+
+  // An output whose state (the number of events it has written) is saved at checkpoints
+  class event_counter {
+  public:
+    explicit event_counter(std::atomic<unsigned int>* events) : events_{events} {}
+
+    void write(product_store const& store)
+    {
+      if (store.contains_product("number")) {
+        ++*events_;
+      }
+    }
+
+    std::string checkpoint() { return std::to_string(events_->load()); }
+    void restore(std::string_view state) { *events_ = std::stoul(std::string{state}); }
+
+  private:
+    std::atomic<unsigned int>* events_;
+  };
+
+  void add_nodes(framework_graph& g, std::atomic<unsigned int>& events)
+  {
+    g.with("job_add", add, concurrency::unlimited).fold("number").to("job_sum");
+    g.with("run_add", add, concurrency::unlimited).fold("number").partitioned_by("run").to("sum");
+    g.with(
+       "verify_job_sum",
+       [](unsigned int actual) { CHECK(actual == job_sum); },
+       concurrency::unlimited)
+      .observe("job_sum");
+    g.with(
+       "verify_run_sum",
+       [](unsigned int actual) { CHECK(actual == run_sum); },
+       concurrency::unlimited)
+      .observe("sum");
+    g.make<event_counter>(&events).output_with(&event_counter::write);
+  }
+}
+
+TEST_CASE("Resuming a job from a checkpoint", "[graph]")
+{
+  std::string const checkpoint_file{"resumed_job.ckpt"};
+  std::string const saved_file{"failed_job.ckpt"};
+  std::filesystem::remove(saved_file);
+
+  // Complete job that keeps a copy of a checkpoint
+  {
+    std::atomic<unsigned int> events{};
+    framework_graph g{test::numbered_runs_and_events(n_runs, n_events)};
+    g.enable_checkpoints({.file = checkpoint_file, .interval = 2});
+    add_nodes(g, events);
+
+    std::once_flag copied;
+    g.with(
+       "record_event",
+       [&](handle<unsigned int> number) {
+         if (number.level_id().parent("run")->number() == 3ull) {
+           std::call_once(copied, [&] {
+             std::filesystem::copy_file(checkpoint_file, saved_file);
+           });
+         }
+       },
+       concurrency::unlimited)
+      .observe("number");
+    g.execute();
+
+    CHECK(events == n_runs * n_events);
+    CHECK(g.execution_counts("verify_run_sum") == n_runs);
+    CHECK(g.execution_counts("verify_job_sum") == 1);
+    // A completed job removes its checkpoint
+    CHECK_FALSE(std::filesystem::exists(checkpoint_file));
+  }
+
+  // The copy was taken after the checkpoint following the second run.
+  REQUIRE(std::filesystem::exists(saved_file));
+  std::filesystem::rename(saved_file, checkpoint_file);
+
+  // Resumed job
+  {
+    std::atomic<unsigned int> events{};
+    framework_graph g{test::numbered_runs_and_events(n_runs, n_events)};
+    g.enable_checkpoints({.file = checkpoint_file, .interval = 2, .resume = true});
+    add_nodes(g, events);
+    g.execute();
+
+    // Only the last three runs are processed...
+    CHECK(g.execution_counts("run_add") == 3 * n_events);
+    CHECK(g.execution_counts("verify_run_sum") == 3);
+    // ...but the job sum and the written events include those of the first two runs.
+    CHECK(g.execution_counts("verify_job_sum") == 1);
+    CHECK(events == n_runs * n_events);
+  }
+}
+
+TEST_CASE("Fold results that cannot be saved at checkpoints", "[graph]")
+{
+  framework_graph g{test::numbered_runs_and_events(n_runs, n_events)};
+  g.enable_checkpoints({.file = "unsavable_fold.ckpt"});
+  g.with("collect", collect, concurrency::serial).fold("number").to("numbers");
+  CHECK_THROWS(g.execute());
+}
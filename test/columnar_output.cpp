@@ -0,0 +1,234 @@
+#include "meld/core/framework_graph.hpp"
+#include "meld/io/columnar_output.hpp"
+#include "meld/io/columnar_reader.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace meld;
+
+namespace {
+  constexpr unsigned int n_runs{2u};
+  constexpr unsigned int n_events{50u};
+
+  void runs_and_events(framework_driver& driver)
+  {
+    auto job_store = product_store::base();
+    driver.yield(job_store);
+    for (unsigned int r : std::views::iota(0u, n_runs)) {
+      auto run_store = job_store->make_child(r, "run");
+      run_store->add_product("run_number", r);
+      driver.yield(run_store);
+      for (unsigned int e : std::views::iota(0u, n_events)) {
+        auto event_store = run_store->make_child(e, "event");
+        event_store->add_product("number", r * n_events + e);
+        driver.yield(event_store);
+      }
+    }
+  }
+
+  double root(unsigned int const number) { return std::sqrt(number); }
+  std::string label(unsigned int const number) { return "event-" + std::to_string(number); }
+  std::vector<int> digits(unsigned int number)
+  {
+    std::vector<int> result;
+    do {
+      result.push_back(number % 10);
+      number /= 10;
+    } while (number != 0);
+    return result;
+  }
+  std::vector<double> unsupported(unsigned int const number) { return {number * 1.}; }
+  std::string_view view(unsigned int) { return "event"; }
+
+  // Maps the global event number to the value read for it
+  template <typename T>
+  std::map<unsigned int, T> read_by_number(columnar_reader& reader, std::string const& product)
+  {
+    auto const ids = reader.read_index("event", product);
+    auto const values = reader.read<T>("event", product);
+    REQUIRE(ids.size() == values.size());
+    std::map<unsigned int, T> result;
+    for (std::size_t i = 0; i != ids.size(); ++i) {
+      auto const number = ids[i]->parent()->number() * n_events + ids[i]->number();
+      result.emplace(number, values[i]);
+    }
+    return result;
+  }
+}
+
+TEST_CASE("Write products to a columnar file", "[io]")
+{
+  register_column_type<std::vector<int>>(
+    [](std::vector<int> const& v, std::string& out) {
+      out.append(reinterpret_cast<char const*>(v.data()), v.size() * sizeof(int));
+    },
+    [](std::string_view bytes) {
+      std::vector<int> result(bytes.size() / sizeof(int));
+      std::memcpy(result.data(), bytes.data(), bytes.size());
+      return result;
+    });
+
+  std::string const filename{"products.mcol"};
+  {
+    framework_graph g{runs_and_events};
+    g.with(root, concurrency::unlimited).transform("number").to("root");
+    g.with(label, concurrency::unlimited).transform("number").to("label");
+    g.with(digits, concurrency::unlimited).transform("number").to("digits");
+    g.with(unsupported, concurrency::unlimited).transform("number").to("unsupported");
+    g.with(view, concurrency::unlimited).transform("number").to("view");
+    g.make<columnar_output>(filename, columnar_output_options{.chunk_rows = 16})
+      .output_with(&columnar_output::write);
+    g.execute();
+  }
+
+  columnar_reader reader{filename};
+  CHECK(reader.columns().size() == 5ull); // run_number, number, root, label, digits
+  CHECK_THROWS(reader.column("event", "unsupported"));
+  CHECK_THROWS(reader.column("event", "view")); // Pointer-like types are not written
+
+  auto const& number_column = reader.column("event", "number");
+  CHECK(number_column.type == "unsigned int");
+  CHECK(number_column.width == sizeof(unsigned int));
+  CHECK(number_column.levels == std::vector<std::string>{"run", "event"});
+  CHECK(number_column.rows() == n_runs * n_events);
+  CHECK(number_column.chunks.size() == (n_runs * n_events + 15) / 16);
+
+  auto const run_numbers = reader.read<unsigned int>("run", "run_number");
+  CHECK(run_numbers.size() == n_runs);
+
+  auto const numbers = read_by_number<unsigned int>(reader, "number");
+  auto const roots = read_by_number<double>(reader, "root");
+  auto const labels = read_by_number<std::string>(reader, "label");
+  auto const all_digits = read_by_number<std::vector<int>>(reader, "digits");
+  REQUIRE(numbers.size() == n_runs * n_events);
+  REQUIRE(roots.size() == n_runs * n_events);
+  REQUIRE(labels.size() == n_runs * n_events);
+  REQUIRE(all_digits.size() == n_runs * n_events);
+  for (unsigned int i : std::views::iota(0u, n_runs * n_events)) {
+    CHECK(numbers.at(i) == i);
+    CHECK(roots.at(i) == root(i));
+    CHECK(labels.at(i) == label(i));
+    CHECK(all_digits.at(i) == digits(i));
+  }
+
+  CHECK_THROWS(reader.read<double>("event", "number"));
+}
+
+TEST_CASE("Resume writing a columnar file from a checkpoint", "[io]")
+{
+  std::string const filename{"resumed.mcol"};
+  auto const job_store = product_store::base();
+  auto write_run = [&job_store](columnar_output& output, unsigned int const r) {
+    auto run_store = job_store->make_child(r, "run");
+    for (unsigned int e : std::views::iota(0u, n_events)) {
+      auto event_store = run_store->make_child(e, "event");
+      event_store->add_product("number", r * n_events + e);
+      output.write(*event_store);
+    }
+  };
+
+  std::string state;
+  {
+    // The failed job: the second run is written after the checkpoint
+    columnar_output output{filename, {.chunk_rows = 16}};
+    write_run(output, 0);
+    state = output.checkpoint();
+    write_run(output, 1);
+  }
+  {
+    columnar_output output{filename, {.chunk_rows = 16}};
+    output.restore(state);
+    write_run(output, 1);
+  }
+
+  {
+    columnar_reader reader{filename};
+    auto const numbers = read_by_number<unsigned int>(reader, "number");
+    REQUIRE(numbers.size() == n_runs * n_events);
+    for (auto const& [number, value] : numbers) {
+      CHECK(number == value);
+    }
+    auto const& number_column = reader.column("event", "number");
+    CHECK(number_column.rows() == n_runs * n_events);
+    // The checkpoint did not write a partial chunk.
+    CHECK(number_column.chunks.size() == (n_runs * n_events + 15) / 16);
+  }
+
+  // A file truncated below the checkpointed offset cannot be resumed.
+  std::filesystem::resize_file(filename, 8);
+  columnar_output output{filename, {.chunk_rows = 16}};
+  CHECK_THROWS_AS(output.restore(state), std::runtime_error);
+}
+
+TEST_CASE("Columns of levels with the same name", "[io]")
+{
+  std::string const filename{"same_level_names.mcol"};
+  auto const job_store = product_store::base();
+  {
+    columnar_output output{filename};
+    auto run_store = job_store->make_child(0, "run");
+    auto subrun_store = run_store->make_child(0, "subrun");
+    for (unsigned int e : std::views::iota(0u, n_events)) {
+      auto event_store = run_store->make_child(e, "event");
+      event_store->add_product("number", e);
+      output.write(*event_store);
+
+      auto subrun_event_store = subrun_store->make_child(e, "event");
+      subrun_event_store->add_product("number", 2 * e);
+      output.write(*subrun_event_store);
+    }
+  }
+
+  columnar_reader reader{filename};
+  CHECK(reader.columns().size() == 2ull);
+  CHECK_THROWS(reader.column("event", "number"));
+
+  auto const numbers = reader.read<unsigned int>("run/event", "number");
+  auto const subrun_numbers = reader.read<unsigned int>("run/subrun/event", "number");
+  REQUIRE(numbers.size() == n_events);
+  REQUIRE(subrun_numbers.size() == n_events);
+  for (unsigned int e : std::views::iota(0u, n_events)) {
+    CHECK(numbers[e] == e);
+    CHECK(subrun_numbers[e] == 2 * e);
+  }
+}
+
+TEST_CASE("Corrupt footers are rejected before allocating", "[io]")
+{
+  std::vector<column_info> const columns{{.level = "event",
+                                          .product = "number",
+                                          .type = "unsigned int",
+                                          .type_id = "j",
+                                          .width = sizeof(unsigned int),
+                                          .levels = {"run", "event"},
+                                          .chunks = {{.index_offset = 0,
+                                                      .index_size = 32,
+                                                      .offset = 32,
+                                                      .size = 8,
+                                                      .raw_size = 8,
+                                                      .rows = 2,
+                                                      .compression = codec::none}}}};
+  auto const footer = columnar_footer(columns);
+  CHECK(columns_from_footer(footer, 40).size() == 1ull);
+
+  // The chunk extends beyond the data that precede the footer.
+  CHECK_THROWS_AS(columns_from_footer(footer, 39), std::runtime_error);
+
+  // A number of columns that the footer cannot hold
+  auto corrupt = footer;
+  std::uint64_t const n_columns{std::uint64_t{1} << 60};
+  corrupt.replace(
+    0, sizeof(n_columns), reinterpret_cast<char const*>(&n_columns), sizeof(n_columns));
+  CHECK_THROWS_AS(columns_from_footer(corrupt, 40), std::runtime_error);
+}
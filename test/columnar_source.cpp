@@ -0,0 +1,178 @@
+#include "meld/core/framework_graph.hpp"
+#include "meld/io/column_chunk.hpp"
+#include "meld/io/columnar_output.hpp"
+#include "meld/io/columnar_reader.hpp"
+#include "meld/io/columnar_source.hpp"
+#include "meld/io/mapped_file.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+using namespace meld;
+
+namespace {
+  constexpr unsigned int n_runs{2u};
+  constexpr unsigned int n_events{40u};
+  constexpr unsigned int n_numbers{n_runs * n_events};
+
+  struct point {
+    double x;
+    double y;
+  };
+
+  // A type whose deserializations are counted
+  struct note {
+    std::string text;
+  };
+  std::atomic<unsigned int> notes_read{};
+
+  void runs_and_events(framework_driver& driver)
+  {
+    auto job_store = product_store::base();
+    job_store->add_product("job_number", 17);
+    driver.yield(job_store);
+    for (unsigned int r : std::views::iota(0u, n_runs)) {
+      // The run stores have no products of their own.
+      auto run_store = job_store->make_child(r, "run");
+      driver.yield(run_store);
+      for (unsigned int e : std::views::iota(0u, n_events)) {
+        auto event_store = run_store->make_child(e, "event");
+        auto const number = r * n_events + e;
+        event_store->add_product("number", number);
+        event_store->add_product("position", point{1. * number, -1. * number});
+        event_store->add_product("note", note{"event " + std::to_string(number)});
+        driver.yield(event_store);
+      }
+    }
+  }
+
+  void write_file(std::string const& filename, codec const compression)
+  {
+    framework_graph g{runs_and_events};
+    g.make<columnar_output>(filename,
+                            columnar_output_options{.chunk_rows = 16, .compression = compression})
+      .output_with(&columnar_output::write);
+    g.execute();
+  }
+
+  struct sums {
+    std::atomic<unsigned int> numbers{};
+    std::atomic<unsigned int> runs{};
+    std::atomic<int> positions{};
+  };
+
+  void read_file(std::string const& filename, sums& result)
+  {
+    columnar_source source{filename};
+    framework_graph g{[&source](framework_driver& driver) { source.next(driver); }};
+    g.with(
+       "add_number",
+       [&result](unsigned int const number) { result.numbers += number; },
+       concurrency::unlimited)
+      .observe("number");
+    g.with(
+       "add_position",
+       [&result](point const& p) { result.positions += static_cast<int>(p.x + p.y) + 1; },
+       concurrency::unlimited)
+      .observe("position");
+    g.with(
+       "check_job",
+       [](int const job_number) { CHECK(job_number == 17); },
+       concurrency::unlimited)
+      .observe("job_number");
+    g.execute();
+    result.runs = g.execution_counts("add_number") / n_events;
+  }
+}
+
+TEST_CASE("Read products lazily from a memory-mapped columnar file", "[io]")
+{
+  register_column_type<point>();
+  register_column_type<note>([](note const& n, std::string& out) { out += n.text; },
+                             [](std::string_view bytes) {
+                               ++notes_read;
+                               return note{std::string(bytes)};
+                             });
+
+  auto compression = GENERATE(codec::none, default_codec());
+  std::string const filename{"products_" + std::string(to_string(compression)) + ".mcol"};
+  write_file(filename, compression);
+
+  notes_read = 0;
+  sums result;
+  read_file(filename, result);
+
+  CHECK(result.numbers == n_numbers * (n_numbers - 1) / 2);
+  CHECK(result.positions == static_cast<int>(n_numbers));
+  CHECK(result.runs == n_runs);
+
+  // No node retrieves the "note" products, so none are deserialized.
+  CHECK(notes_read == 0u);
+}
+
+TEST_CASE("Values are not decompressed unless retrieved", "[io]")
+{
+  register_column_type<point>();
+  std::string const filename{"products_compressed.mcol"};
+  write_file(filename, default_codec());
+
+  columnar_reader const reader{filename};
+  std::size_t number_chunks{};
+  for (auto const& column : reader.columns()) {
+    CHECK(column.chunks.front().compression == default_codec());
+    if (column.product == "number") {
+      number_chunks = column.chunks.size();
+    }
+  }
+  REQUIRE(number_chunks > 1ull);
+
+  auto const before = column_chunk::decompressed_value_blocks();
+  {
+    columnar_source source{filename};
+    framework_graph g{[&source](framework_driver& driver) { source.next(driver); }};
+    g.execute();
+  }
+  // Without nodes retrieving products, only the index blocks are decompressed.
+  CHECK(column_chunk::decompressed_value_blocks() == before);
+
+  sums result;
+  read_file(filename, result);
+  CHECK(result.numbers == n_numbers * (n_numbers - 1) / 2);
+  if (default_codec() != codec::none) {
+    // Each value block of the "number" and "position" columns is decompressed.
+    auto const decompressed = column_chunk::decompressed_value_blocks() - before;
+    CHECK(decompressed >= 2 * number_chunks);
+  }
+}
+
+TEST_CASE("Chunks inconsistent with their sizes are rejected", "[io]")
+{
+  register_column_type<point>();
+  register_column_type<note>([](note const& n, std::string& out) { out += n.text; },
+                             [](std::string_view bytes) { return note{std::string(bytes)}; });
+  std::string const filename{"products_corrupt.mcol"};
+  write_file(filename, codec::none);
+
+  columnar_reader const reader{filename};
+  auto const file = std::make_shared<mapped_file const>(filename);
+  auto const& numbers = reader.column("event", "number");
+  CHECK_NOTHROW(column_chunk{file, numbers, numbers.chunks.front()});
+
+  // The index block is too small for the number of rows.
+  auto more_rows = numbers.chunks.front();
+  ++more_rows.rows;
+  CHECK_THROWS_AS((column_chunk{file, numbers, more_rows}), std::runtime_error);
+
+  // The serialized values are truncated, so the last offset lies beyond them.
+  auto const& notes = reader.column("event", "note");
+  auto truncated = notes.chunks.front();
+  truncated.size = truncated.raw_size = (truncated.rows + 1) * sizeof(std::uint64_t);
+  CHECK_THROWS_AS((column_chunk{file, notes, truncated}), std::runtime_error);
+}
@@ -0,0 +1,120 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//         |       |
+//   evens_only  square
+//         |       |
+//         |    add_one
+//         |       |
+//   sum_even_squares (when: evens_only)
+//
+// In the demand-driven mode, the square and add_one transforms are consumed only by a
+// node guarded by the evens_only predicate.  They therefore inherit the predicate and are
+// executed only for the even-numbered events.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+
+using namespace meld;
+
+namespace {
+  constexpr unsigned int n_events{10u};
+
+  constexpr bool evens_only(unsigned int const value) { return value % 2u == 0u; }
+  constexpr bool is_small(unsigned int const value) { return value < 10u; }
+  constexpr unsigned int square(unsigned int const value) { return value * value; }
+  constexpr unsigned int add_one(unsigned int const value) { return value + 1u; }
+
+  struct sum_numbers {
+    void add(unsigned int const num) { sum += num; }
+    std::atomic<unsigned int> sum{};
+  };
+
+  void declare_transforms(framework_graph& g)
+  {
+    g.with(evens_only, concurrency::unlimited).evaluate("num");
+    g.with(square, concurrency::unlimited).transform("num").to("squared");
+    g.with(add_one, concurrency::unlimited).transform("squared").to("squared_plus_one");
+  }
+}
+
+TEST_CASE("Transforms feeding guarded nodes run eagerly by default", "[filtering]")
+{
+  framework_graph g{test::numbered_events(n_events, "num")};
+  declare_transforms(g);
+  auto sum = g.make<sum_numbers>();
+  sum.with("sum_even_squares", &sum_numbers::add, concurrency::unlimited)
+    .when("evens_only")
+    .observe("squared_plus_one");
+  g.execute();
+
+  CHECK(g.execution_counts("evens_only") == n_events);
+  CHECK(g.execution_counts("square") == n_events);
+  CHECK(g.execution_counts("add_one") == n_events);
+  CHECK(g.execution_counts("sum_even_squares") == n_events / 2);
+}
+
+TEST_CASE("Transforms feeding guarded nodes run on demand", "[filtering]")
+{
+  framework_graph g{test::numbered_events(n_events, "num")};
+  g.set_execution_mode(execution_mode::demand_driven);
+  declare_transforms(g);
+
+  sum_numbers sum;
+  g.with(
+     "sum_even_squares",
+     [&sum](unsigned int const num) { sum.add(num); },
+     concurrency::unlimited)
+    .when("evens_only")
+    .observe("squared_plus_one");
+  g.execute("demand_driven_t");
+
+  CHECK(g.execution_counts("evens_only") == n_events);
+  CHECK(g.execution_counts("square") == n_events / 2);
+  CHECK(g.execution_counts("add_one") == n_events / 2);
+  CHECK(g.execution_counts("sum_even_squares") == n_events / 2);
+  CHECK(sum.sum == 1u + 5u + 17u + 37u + 65u);
+}
+
+TEST_CASE("Unguarded consumers keep transforms eager", "[filtering]")
+{
+  framework_graph g{test::numbered_events(n_events, "num")};
+  g.set_execution_mode(execution_mode::demand_driven);
+  declare_transforms(g);
+  g.with(
+     "sum_even_squares", [](unsigned int) {}, concurrency::unlimited)
+    .when("evens_only")
+    .observe("squared_plus_one");
+  g.with(
+     "all_squares", [](unsigned int) {}, concurrency::unlimited)
+    .observe("squared");
+  g.execute();
+
+  CHECK(g.execution_counts("square") == n_events);
+  CHECK(g.execution_counts("add_one") == n_events / 2);
+}
+
+TEST_CASE("Transforms do not wait on predicates that need their products", "[filtering]")
+{
+  framework_graph g{test::numbered_events(n_events, "num")};
+  g.set_execution_mode(execution_mode::demand_driven);
+  g.with(square, concurrency::unlimited).transform("num").to("squared");
+  g.with(is_small, concurrency::unlimited).evaluate("squared");
+  g.with(
+     "small_squares", [](unsigned int) {}, concurrency::unlimited)
+    .when("is_small")
+    .observe("squared");
+  g.execute();
+
+  CHECK(g.execution_counts("square") == n_events);
+  CHECK(g.execution_counts("is_small") == n_events);
+  CHECK(g.execution_counts("small_squares") == 4u);
+}
@@ -0,0 +1,32 @@
+// =======================================================================================
+// Microbenchmark of the hand-off between a source's driver thread and the framework
+// thread that requests the next store.  The driver is, by design, consumed by only one
+// thread, so there is no multi-threaded variant.
+// =======================================================================================
+
+#include "meld/utilities/async_driver.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+
+using namespace meld;
+
+namespace {
+  void async_driver_handoff(benchmark::State& state)
+  {
+    std::atomic<bool> stop{false};
+    async_driver<int> driver{[&stop](async_driver<int>& d) {
+      for (int i = 0; not stop; ++i) {
+        d.yield(i);
+      }
+    }};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(driver());
+    }
+    stop = true;
+    driver(); // Lets the driver function return
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(async_driver_handoff)->UseRealTime();
+}
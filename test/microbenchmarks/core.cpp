@@ -0,0 +1,197 @@
+// =======================================================================================
+// Microbenchmarks of the framework's routing and bookkeeping: the multiplexer, filters,
+// and the store counters that determine when a fold or flush may proceed.
+//
+// The multiplexer and filter benchmarks send batches of messages through a flow graph,
+// waiting for the graph to become idle after each batch; the reported item rate is the
+// number of messages per second.
+// =======================================================================================
+
+#include "meld/concurrency.hpp"
+#include "meld/core/declared_output.hpp"
+#include "meld/core/filter.hpp"
+#include "meld/core/message.hpp"
+#include "meld/core/multiplexer.hpp"
+#include "meld/core/store_counters.hpp"
+#include "meld/model/level_counter.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "benchmark/benchmark.h"
+#include "oneapi/tbb/flow_graph.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace meld;
+
+namespace {
+  constexpr int max_threads{8};
+  constexpr std::size_t batch_size{1024};
+
+  std::vector<product_store_ptr> make_event_stores(std::size_t const n_events)
+  {
+    auto const job_store = product_store::base();
+    std::vector<product_store_ptr> result;
+    result.reserve(n_events);
+    for (std::size_t i = 0; i != n_events; ++i) {
+      auto store = job_store->make_child(i, "event");
+      store->add_product("number", static_cast<int>(i));
+      result.push_back(std::move(store));
+    }
+    return result;
+  }
+
+  // A multiplexer routing the product "number" to 'n_nodes' nodes that do nothing.
+  class routing {
+  public:
+    explicit routing(std::size_t const n_nodes)
+    {
+      multiplexer::head_ports_t head_ports;
+      for (std::size_t i = 0; i != n_nodes; ++i) {
+        auto& sink = sinks_.emplace_back(graph_, tbb::flow::unlimited, [](message const&) {
+          return tbb::flow::continue_msg{};
+        });
+        head_ports["node_" + std::to_string(i)].push_back(
+          {specified_label::create("number"), &sink});
+      }
+      multiplexer_.finalize(std::move(head_ports));
+    }
+
+    multiplexer& router() noexcept { return multiplexer_; }
+    void wait() { graph_.wait_for_all(); }
+
+  private:
+    using sink_t =
+      tbb::flow::function_node<message, tbb::flow::continue_msg, tbb::flow::lightweight>;
+    tbb::flow::graph graph_;
+    multiplexer multiplexer_{graph_};
+    std::deque<sink_t> sinks_;
+  };
+
+  void multiplexer_multiplex(benchmark::State& state)
+  {
+    // The multiplexer is shared by all threads, as it is by the TBB tasks that invoke it.
+    static std::unique_ptr<routing> shared;
+    if (state.thread_index() == 0) {
+      shared = std::make_unique<routing>(state.range(0));
+    }
+    auto const stores = make_event_stores(batch_size);
+    std::size_t id{};
+    for (auto _ : state) {
+      for (auto const& store : stores) {
+        shared->router().multiplex({store, nullptr, id++});
+      }
+    }
+    if (state.thread_index() == 0) {
+      shared->wait();
+      shared.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+  }
+  BENCHMARK(multiplexer_multiplex)
+    ->Arg(1)
+    ->Arg(16)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+
+  void filter_execute(benchmark::State& state)
+  {
+    // Every other message is accepted by the predicate.
+    auto const stores = make_event_stores(batch_size);
+    tbb::flow::graph g;
+    declared_output output{
+      "benchmark_output", concurrency::unlimited.value, {"even"}, g, [](product_store const&) {}};
+    filter f{g, output};
+    std::size_t id{};
+    for (auto _ : state) {
+      for (auto const& store : stores) {
+        f.data_port().try_put({store, nullptr, id});
+        f.predicate_port().try_put({nullptr, id, id % 2 == 0});
+        ++id;
+      }
+      g.wait_for_all();
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+  }
+  BENCHMARK(filter_execute)->UseRealTime();
+
+  // A counter expecting 'n_children' events, none of which has been counted yet
+  class counted_level {
+  public:
+    explicit counted_level(std::size_t const n_children) :
+      run_{product_store::base()->make_child(0, "run")},
+      event_hash_{run_->make_child(0, "event")->id()->level_hash()}
+    {
+      auto flush = run_->make_flush();
+      flush->add_product("[flush]",
+                         std::make_shared<flush_counts const>(
+                           std::map<level_id::hash_type, std::size_t>{{event_hash_, n_children}}));
+      flush_ = std::move(flush);
+    }
+
+    void initialize(store_counter& counter) const { counter.set_flush_value(flush_, 0); }
+    level_id::hash_type event_hash() const noexcept { return event_hash_; }
+
+  private:
+    product_store_ptr run_;
+    product_store_const_ptr flush_;
+    level_id::hash_type event_hash_;
+  };
+
+  void store_counter_increment(benchmark::State& state)
+  {
+    // The counter is shared by all threads, as it is by the tasks processing the children
+    // of one store.
+    static std::unique_ptr<store_counter> counter;
+    if (state.thread_index() == 0) {
+      counter = std::make_unique<store_counter>();
+    }
+    auto const event_hash = counted_level{1}.event_hash();
+    for (auto _ : state) {
+      counter->increment(event_hash);
+    }
+    if (state.thread_index() == 0) {
+      counter.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(store_counter_increment)->ThreadRange(1, max_threads)->UseRealTime();
+
+  void store_counter_is_complete(benchmark::State& state)
+  {
+    // A counter that is one child short of completion, as is checked whenever a child of
+    // the store is processed.
+    auto const n_children = static_cast<std::size_t>(state.range(0));
+    counted_level const level{n_children};
+    store_counter counter;
+    level.initialize(counter);
+    for (std::size_t i = 1; i != n_children; ++i) {
+      counter.increment(level.event_hash());
+    }
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(counter.is_complete());
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(store_counter_is_complete)->Arg(10)->Arg(1000);
+
+  void store_counter_lifecycle(benchmark::State& state)
+  {
+    // Counting all children of a store until the store may be flushed
+    auto const n_children = static_cast<std::size_t>(state.range(0));
+    counted_level const level{n_children};
+    for (auto _ : state) {
+      store_counter counter;
+      level.initialize(counter);
+      for (std::size_t i = 0; i != n_children; ++i) {
+        counter.increment(level.event_hash());
+      }
+      benchmark::DoNotOptimize(counter.is_complete());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(store_counter_lifecycle)->Arg(10)->Arg(1000);
+}
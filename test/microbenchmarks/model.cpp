@@ -0,0 +1,131 @@
+// =======================================================================================
+// Microbenchmarks of the data-model classes: level IDs, product stores, and products.
+// =======================================================================================
+
+#include "meld/model/level_id.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/model/products.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+using namespace meld;
+
+namespace {
+  constexpr int max_threads{8};
+
+  // IDs of the form [run, subrun, event], as yielded by a typical source
+  std::vector<level_id_ptr> make_event_ids(std::size_t const n_events)
+  {
+    auto const subrun = level_id::base_ptr()->make_child(0, "run")->make_child(0, "subrun");
+    std::vector<level_id_ptr> result;
+    result.reserve(n_events);
+    for (std::size_t i = 0; i != n_events; ++i) {
+      result.push_back(subrun->make_child(i, "event"));
+    }
+    return result;
+  }
+
+  product_store_ptr store_with_products(std::size_t const n_products)
+  {
+    auto store = product_store::base()->make_child(0, "event");
+    for (std::size_t i = 0; i != n_products; ++i) {
+      store->add_product("product_" + std::to_string(i), static_cast<int>(i));
+    }
+    return store;
+  }
+
+  void level_id_make_child(benchmark::State& state)
+  {
+    // The parent is shared by all threads, which contend for its reference count.
+    static auto const subrun = level_id::base_ptr()->make_child(0, "run")->make_child(0, "subrun");
+    std::size_t i{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(subrun->make_child(i++, "event"));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(level_id_make_child)->ThreadRange(1, max_threads)->UseRealTime();
+
+  void level_id_hash(benchmark::State& state)
+  {
+    auto const ids = make_event_ids(1024);
+    std::hash<level_id> const hasher;
+    std::size_t i{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(hasher(*ids[i++ % ids.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(level_id_hash);
+
+  void level_id_less(benchmark::State& state)
+  {
+    auto const ids = make_event_ids(1024);
+    std::size_t i{};
+    for (auto _ : state) {
+      auto const& a = *ids[i % ids.size()];
+      auto const& b = *ids[(i + 1) % ids.size()];
+      benchmark::DoNotOptimize(a < b);
+      ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(level_id_less);
+
+  void product_store_make_child(benchmark::State& state)
+  {
+    auto const job_store = product_store::base();
+    std::size_t i{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(job_store->make_child(i++, "event"));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(product_store_make_child);
+
+  void product_store_get_handle(benchmark::State& state)
+  {
+    // The store is shared by all threads, as it is by the nodes that read from it.
+    static auto const store = store_with_products(8);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(store->get_handle<int>("product_3"));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(product_store_get_handle)->ThreadRange(1, max_threads)->UseRealTime();
+
+  void products_add(benchmark::State& state)
+  {
+    auto const n_products = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i != n_products; ++i) {
+      names.push_back("product_" + std::to_string(i));
+    }
+    for (auto _ : state) {
+      products p;
+      for (std::size_t i = 0; i != n_products; ++i) {
+        p.add(names[i], static_cast<int>(i));
+      }
+      benchmark::DoNotOptimize(p);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(products_add)->Arg(1)->Arg(8)->Arg(64);
+
+  void products_get(benchmark::State& state)
+  {
+    products p;
+    for (int i = 0; i != 8; ++i) {
+      p.add("product_" + std::to_string(i), i);
+    }
+    std::string const name{"product_3"};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(p.get<int>(name));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(products_get);
+}
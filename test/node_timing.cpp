@@ -0,0 +1,262 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//             |
+//          double
+//             |
+//      sum_numbers(*)
+//             |
+//       verify_sum
+//
+// where the asterisk (*) indicates a fold over the full job.  The timing report must
+// contain an entry for each node, with one recorded invocation per event for the
+// transform and the fold.  The post-execution DOT graphs must be annotated with the same
+// numbers of invocations, and the same counts must be available through the node IDs.
+// If performance counters are enabled, the report must contain the totals of the
+// available events.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/core/perf_counters.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace meld;
+using namespace std::chrono_literals;
+
+namespace {
+  constexpr auto n_events = 20u;
+
+  unsigned int twice(unsigned int number)
+  {
+    spin_for(1ms);
+    return 2 * number;
+  }
+  void add(std::atomic<unsigned int>& counter, unsigned int number) { counter += number; }
+}
+
+TEST_CASE("Writing a timing report", "[graph]")
+{
+  std::string const report{"node_timing.json"};
+  std::filesystem::remove(report);
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    g.set_timing_report(report);
+    g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+    g.with("sum_numbers", add, concurrency::serial).fold("doubled").to("sum");
+    g.with(
+       "verify_sum",
+       [](unsigned int sum) { CHECK(sum == n_events * (n_events - 1)); },
+       concurrency::serial)
+      .observe("sum");
+    g.execute();
+  }
+
+  REQUIRE(std::filesystem::exists(report));
+  std::ifstream file{report};
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  auto const contents = buffer.str();
+
+  using Catch::Matchers::ContainsSubstring;
+  CHECK_THAT(contents, ContainsSubstring(R"("units": "ns")"));
+  CHECK_THAT(contents, ContainsSubstring(R"("name": "double", "kind": "transform")"));
+  CHECK_THAT(contents, ContainsSubstring(R"("name": "sum_numbers", "kind": "fold")"));
+  CHECK_THAT(contents, ContainsSubstring(R"("name": "verify_sum", "kind": "observer")"));
+  CHECK_THAT(contents, ContainsSubstring(R"("count": )" + std::to_string(n_events) + ","));
+  CHECK_THAT(contents, ContainsSubstring(R"("count": 1,)"));
+
+  std::filesystem::remove(report);
+}
+
+TEST_CASE("Writing heat-mapped graphs", "[graph]")
+{
+  std::string const dot_prefix{"node_timing"};
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+    g.with("sum_numbers", add, concurrency::serial).fold("doubled").to("sum");
+    g.execute(dot_prefix);
+  }
+
+  auto read = [](std::string const& filename) {
+    REQUIRE(std::filesystem::exists(filename));
+    std::ifstream file{filename};
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+  };
+
+  using Catch::Matchers::ContainsSubstring;
+  auto const calls = std::to_string(n_events) + " calls";
+  auto const functions = read(dot_prefix + "-functions-post.gv");
+  CHECK_THAT(functions, ContainsSubstring(calls));
+  CHECK_THAT(functions, ContainsSubstring("fillcolor="));
+  CHECK_THAT(functions, ContainsSubstring(std::to_string(n_events) + " messages"));
+
+  auto const data = read(dot_prefix + "-data-post.gv");
+  CHECK_THAT(data, ContainsSubstring(calls));
+  CHECK_THAT(data, ContainsSubstring("penwidth="));
+
+  for (auto const& suffix :
+       {"-functions.gv", "-functions-post.gv", "-data-pre.gv", "-data-post.gv"}) {
+    std::filesystem::remove(dot_prefix + suffix);
+  }
+}
+
+TEST_CASE("Edges are heat-mapped by their own message counts", "[graph]")
+{
+  std::string const dot_prefix{"edge_counts"};
+  {
+    framework_graph g{[](framework_driver& driver) {
+      auto job_store = product_store::base();
+      job_store->add_product("offset", 1u);
+      driver.yield(job_store);
+      for (unsigned int i : std::views::iota(0u, n_events)) {
+        auto event_store = job_store->make_child(i, "event");
+        event_store->add_product("number", i);
+        driver.yield(event_store);
+      }
+    }};
+    g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+    g.with("shift", [](unsigned int offset) { return offset + 1; }, concurrency::unlimited)
+      .transform("offset")
+      .to("shifted");
+    g.execute(dot_prefix);
+  }
+
+  std::ifstream file{dot_prefix + "-functions-post.gv"};
+  std::string to_double;
+  std::string to_shift;
+  for (std::string line; std::getline(file, line);) {
+    if (line.starts_with(R"(  "Source" -> "double")")) {
+      to_double = line;
+    }
+    if (line.starts_with(R"(  "Source" -> "shift")")) {
+      to_shift = line;
+    }
+  }
+
+  // Both edges leave the source, but only the event stores reach 'double'.
+  using Catch::Matchers::ContainsSubstring;
+  CHECK_THAT(to_double, ContainsSubstring(std::to_string(n_events) + " messages"));
+  CHECK_THAT(to_shift, ContainsSubstring(" messages"));
+  CHECK_THAT(to_shift, not ContainsSubstring(std::to_string(n_events) + " messages"));
+
+  for (auto const& suffix :
+       {"-functions.gv", "-functions-post.gv", "-data-pre.gv", "-data-post.gv"}) {
+    std::filesystem::remove(dot_prefix + suffix);
+  }
+}
+
+TEST_CASE("Querying node statistics by ID", "[graph]")
+{
+  framework_graph g{test::numbered_events(n_events)};
+  g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+  g.with("sum_numbers", add, concurrency::serial).fold("doubled").to("sum");
+  g.execute();
+
+  auto const statistics = g.statistics();
+  REQUIRE(statistics.size() == 2ull);
+  for (std::size_t id = 0; auto const& counts : statistics) {
+    CHECK(counts.id == id++);
+    CHECK(counts.calls == g.execution_counts(counts.name));
+    CHECK(counts.products == g.product_counts(counts.name));
+    CHECK(counts.failures == 0ull);
+    CHECK(counts.execution_time > 0ull);
+  }
+
+  auto by_name = [&statistics](std::string const& name) {
+    auto it = std::ranges::find(statistics, name, &node_counts::name);
+    REQUIRE(it != statistics.end());
+    return *it;
+  };
+  auto const doubled = by_name("double");
+  CHECK(doubled.kind == "transform");
+  CHECK(doubled.calls == n_events);
+  CHECK(doubled.products == n_events);
+
+  auto const summed = by_name("sum_numbers");
+  CHECK(summed.kind == "fold");
+  CHECK(summed.calls == n_events);
+  CHECK(summed.products == 1ull);
+}
+
+TEST_CASE("Asynchronous invocations are timed until their results are ready", "[graph]")
+{
+  framework_graph g{test::numbered_events(n_events)};
+  g.with(
+     "delayed_double",
+     [](unsigned int number) {
+       return std::async(std::launch::async, [number] {
+         std::this_thread::sleep_for(5ms);
+         return 2 * number;
+       });
+     },
+     concurrency::unlimited)
+    .transform("number")
+    .to("doubled");
+  g.execute();
+
+  auto const statistics = g.statistics();
+  REQUIRE(statistics.size() == 1ull);
+  CHECK(statistics[0].calls == n_events);
+  CHECK(statistics[0].execution_time >= n_events * 5'000'000ull);
+}
+
+TEST_CASE("Per-node performance counters", "[graph]")
+{
+  perf_counters probe;
+  auto const before = probe.read();
+  spin_for(10ms);
+  auto const after = probe.read();
+  if (probe.available(perf_event::task_clock)) {
+    auto const i = static_cast<std::size_t>(perf_event::task_clock);
+    CHECK(after[i] > before[i]);
+  }
+
+  std::string const report{"node_timing_perf.json"};
+  std::filesystem::remove(report);
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    g.set_timing_report(report);
+    g.enable_perf_counters();
+    g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+    g.execute();
+  }
+
+  REQUIRE(std::filesystem::exists(report));
+  std::ifstream file{report};
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  auto const contents = buffer.str();
+  std::filesystem::remove(report);
+
+  using Catch::Matchers::ContainsSubstring;
+  if (not probe.any_available()) {
+    CHECK_THAT(contents, not ContainsSubstring("perf_counters"));
+    return;
+  }
+  CHECK_THAT(contents, ContainsSubstring(R"("perf_counters": {)"));
+  for (std::size_t i = 0; i != n_perf_events; ++i) {
+    auto const event = static_cast<perf_event>(i);
+    if (probe.available(event)) {
+      CHECK_THAT(contents, ContainsSubstring('"' + std::string{to_string(event)} + "\": "));
+    }
+  }
+}
@@ -0,0 +1,55 @@
+#ifndef test_numbered_events_hpp
+#define test_numbered_events_hpp
+
+// ===================================================================
+// Drivers shared by the tests that need only a flat sequence of
+// numbered events:
+//
+//  job
+//    [n_runs runs]
+//      n_events events, each with the product 'number'
+//
+// The product of each event is its number within its parent.
+// ===================================================================
+
+#include "meld/model/product_store.hpp"
+#include "meld/source.hpp"
+
+#include <ranges>
+#include <string>
+
+namespace meld::test {
+  inline detail::next_store_t numbered_events(unsigned int n_events,
+                                              std::string product_name = "number")
+  {
+    return [n_events, product_name = std::move(product_name)](framework_driver& driver) {
+      auto job_store = product_store::base();
+      driver.yield(job_store);
+      for (unsigned int i : std::views::iota(0u, n_events)) {
+        auto event_store = job_store->make_child(i, "event");
+        event_store->add_product(product_name, i);
+        driver.yield(event_store);
+      }
+    };
+  }
+
+  inline detail::next_store_t numbered_runs_and_events(unsigned int n_runs,
+                                                       unsigned int n_events)
+  {
+    return [n_runs, n_events](framework_driver& driver) {
+      auto job_store = product_store::base();
+      driver.yield(job_store);
+      for (unsigned int i : std::views::iota(0u, n_runs)) {
+        auto run_store = job_store->make_child(i, "run");
+        driver.yield(run_store);
+        for (unsigned int j : std::views::iota(0u, n_events)) {
+          auto event_store = run_store->make_child(j, "event");
+          event_store->add_product("number", j);
+          driver.yield(event_store);
+        }
+      }
+    };
+  }
+}
+
+#endif // test_numbered_events_hpp
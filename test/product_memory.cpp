@@ -0,0 +1,145 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//             |
+//        make_vector
+//             |
+//       verify_vector
+//
+// with product-memory accounting enabled, and checks that the memory held by the vectors
+// is attributed to make_vector and to the "event" level, and that it has been released
+// once the job has completed.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_memory.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/model/size_of.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace meld;
+
+namespace {
+  constexpr auto n_events = 10u;
+  constexpr std::size_t vector_size = 1000;
+
+  std::vector<int> make_vector(unsigned int number)
+  {
+    std::vector<int> result(vector_size, number);
+    result.shrink_to_fit();
+    return result;
+  }
+}
+
+namespace imaging {
+  struct image {
+    std::size_t width;
+    std::size_t height;
+  };
+
+  std::size_t size_of(image const& img) { return img.width * img.height; }
+}
+
+TEST_CASE("Product sizes", "[model]")
+{
+  CHECK(size_of(42) == sizeof(int));
+
+  std::vector<double> v;
+  v.reserve(10);
+  CHECK(size_of(v) == sizeof(v) + v.capacity() * sizeof(double));
+
+  // Found by argument-dependent lookup
+  using meld::size_of;
+  CHECK(size_of(imaging::image{.width = 3, .height = 4}) == 12);
+}
+
+TEST_CASE("Accounting for product memory", "[graph]")
+{
+  std::string const dot_prefix{"product_memory_test"};
+  std::shared_ptr<product_memory const> memory;
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    CHECK(g.memory_accounting() == nullptr);
+    g.enable_memory_accounting();
+    memory = g.memory_accounting();
+    g.with(make_vector, concurrency::unlimited).transform("number").to("vector");
+    g.with(
+       "verify_vector",
+       [](std::vector<int> const& v) { CHECK(v.size() == vector_size); },
+       concurrency::unlimited)
+      .observe("vector");
+    g.execute(dot_prefix);
+  }
+
+  auto const one_vector = size_of(make_vector(0));
+  auto const nodes = memory->node_usage();
+  REQUIRE(nodes.contains("make_vector"));
+  auto const& vectors = nodes.at("make_vector");
+  CHECK(vectors.peak >= static_cast<std::int64_t>(one_vector));
+  CHECK(vectors.peak <= static_cast<std::int64_t>(n_events * one_vector));
+  CHECK(vectors.live == 0);
+
+  REQUIRE(nodes.contains("[source]"));
+  CHECK(nodes.at("[source]").live == 0);
+
+  auto const levels = memory->level_usage();
+  REQUIRE(levels.contains("event"));
+  CHECK(levels.at("event").peak >= vectors.peak);
+  CHECK(levels.at("event").live == 0);
+
+  auto const post_file = dot_prefix + "-data-post.gv";
+  REQUIRE(std::filesystem::exists(post_file));
+  std::ifstream file{post_file};
+  std::stringstream contents;
+  contents << file.rdbuf();
+  CHECK_THAT(contents.str(), Catch::Matchers::ContainsSubstring("peak"));
+
+  for (auto const& stage : {"pre", "post"}) {
+    std::filesystem::remove(dot_prefix + "-data-" + stage + ".gv");
+  }
+  std::filesystem::remove(dot_prefix + "-functions.gv");
+  std::filesystem::remove(dot_prefix + "-functions-post.gv");
+}
+
+TEST_CASE("Product memory is accounted for per graph", "[graph]")
+{
+  framework_graph accounted{test::numbered_events(n_events)};
+  accounted.enable_memory_accounting();
+  accounted.with(make_vector, concurrency::unlimited).transform("number").to("vector");
+
+  framework_graph unaccounted{test::numbered_events(n_events)};
+  unaccounted.with(make_vector, concurrency::unlimited).transform("number").to("vector");
+
+  accounted.execute();
+  unaccounted.execute();
+
+  auto const nodes = accounted.memory_accounting()->node_usage();
+  REQUIRE(nodes.contains("make_vector"));
+  CHECK(nodes.at("make_vector").total ==
+        static_cast<std::int64_t>(n_events * size_of(make_vector(0))));
+}
+
+TEST_CASE("Stores created without accounting are not accounted for", "[model]")
+{
+  auto memory = std::make_shared<product_memory>();
+  auto job_store = product_store::base();
+  auto unaccounted = job_store->make_child(0, "run");
+  job_store->account_memory_in(memory);
+  auto accounted = job_store->make_child(1, "run");
+
+  unaccounted->add_product("number", 1);
+  accounted->add_product("number", 2);
+  auto const levels = memory->level_usage();
+  REQUIRE(levels.contains("run"));
+  CHECK(levels.at("run").total == static_cast<std::int64_t>(sizeof(int)));
+}
@@ -3,6 +3,9 @@
 
 #include "catch2/catch_all.hpp"
 
+#include <atomic>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -72,3 +75,39 @@ TEST_CASE("Product store derivation", "[data model]")
   CHECK(leaf == most_derived(order_b));
   CHECK(leaf == most_derived(order_c));
 }
+
+TEST_CASE("Deferred products", "[data model]")
+{
+  std::atomic<int> loads{};
+  auto store = product_store::base();
+  store->add_deferred_product("number", [&loads] {
+    ++loads;
+    return 4;
+  });
+  store->add_deferred_product("name", [&loads] {
+    ++loads;
+    return std::string{"unused"};
+  });
+
+  CHECK(store->contains_product("number"));
+  CHECK(store->contains_product("name"));
+  CHECK(loads == 0);
+
+  CHECK_THROWS(store->get_product<double>("number"));
+  CHECK(loads == 0);
+
+  // Catch2 assertions are not thread-safe, so the results are checked once the readers
+  // are done.
+  std::atomic<int> correct_reads{};
+  std::vector<std::jthread> readers;
+  for (int i = 0; i != 8; ++i) {
+    readers.emplace_back([&store, &correct_reads] {
+      if (store->get_product<int>("number") == 4) {
+        ++correct_reads;
+      }
+    });
+  }
+  readers.clear();
+  CHECK(correct_reads == 8);
+  CHECK(loads == 1);
+}
@@ -0,0 +1,91 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//             |
+//          double
+//             |
+//       verify_double
+//
+// with progress reports enabled, and checks that the final report (written in both the
+// Prometheus text format and the JSON format) accounts for all processed stores and
+// node calls.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace meld;
+using namespace std::chrono_literals;
+
+namespace {
+  constexpr auto n_events = 20u;
+
+  unsigned int twice(unsigned int number)
+  {
+    spin_for(1ms);
+    return 2 * number;
+  }
+
+  std::string run_job_reporting_to(std::string const& filename)
+  {
+    std::filesystem::remove(filename);
+    {
+      framework_graph g{test::numbered_events(n_events)};
+      g.enable_progress_reports({.file = filename, .interval = 5ms});
+      g.with("double", twice, concurrency::unlimited).transform("number").to("doubled");
+      g.with(
+         "verify_double",
+         [](unsigned int doubled) { CHECK(doubled % 2 == 0); },
+         concurrency::unlimited)
+        .observe("doubled");
+      g.execute();
+    }
+
+    REQUIRE(std::filesystem::exists(filename));
+    CHECK(not std::filesystem::exists(filename + ".tmp"));
+    std::ifstream file{filename};
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::filesystem::remove(filename);
+    return buffer.str();
+  }
+}
+
+TEST_CASE("Progress reports in the Prometheus text format", "[graph]")
+{
+  auto const contents = run_job_reporting_to("progress_reports.prom");
+
+  using Catch::Matchers::ContainsSubstring;
+  CHECK_THAT(contents, ContainsSubstring("# TYPE meld_processed_stores_total counter"));
+  CHECK_THAT(contents,
+             ContainsSubstring("meld_processed_stores_total{level=\"event\"} " +
+                               std::to_string(n_events) + "\n"));
+  CHECK_THAT(contents,
+             ContainsSubstring("meld_node_calls_total{node=\"double\",kind=\"transform\"} " +
+                               std::to_string(n_events) + "\n"));
+  CHECK_THAT(contents, ContainsSubstring("meld_resident_memory_bytes "));
+}
+
+TEST_CASE("Progress reports in the JSON format", "[graph]")
+{
+  auto const contents = run_job_reporting_to("progress_reports.json");
+
+  using Catch::Matchers::ContainsSubstring;
+  CHECK_THAT(contents,
+             ContainsSubstring(R"({"name": "event", "processed": )" + std::to_string(n_events)));
+  CHECK_THAT(contents,
+             ContainsSubstring(R"({"name": "verify_double", "kind": "observer", "calls": )" +
+                               std::to_string(n_events)));
+  CHECK_THAT(contents, ContainsSubstring(R"("in_flight_stores": )"));
+}
@@ -0,0 +1,76 @@
+// =======================================================================================
+// This test decodes the "encoded" product of each event in the readahead stage, and then
+// executes the following graph on the decoded products:
+//
+//        Multiplexer
+//             |
+//         run_add(^)
+//             |
+//       verify_run_sum
+//
+// where the caret (^) represents a fold step over each run.  Because the decoding of the
+// events proceeds out of order, the run sums are correct only if the readahead stage
+// restores the order in which the source yielded the stores.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <ranges>
+#include <string>
+
+using namespace meld;
+using namespace std::chrono_literals;
+
+namespace {
+  constexpr auto n_runs = 3u;
+  constexpr auto n_events = 10u;
+
+  void levels_to_process(framework_driver& driver)
+  {
+    auto job_store = product_store::base();
+    driver.yield(job_store);
+    for (unsigned i : std::views::iota(0u, n_runs)) {
+      auto run_store = job_store->make_child(i, "run");
+      driver.yield(run_store);
+      for (unsigned j : std::views::iota(0u, n_events)) {
+        auto event_store = run_store->make_child(j, "event");
+        event_store->add_product("encoded", std::to_string(j));
+        driver.yield(event_store);
+      }
+    }
+  }
+
+  void add(std::atomic<unsigned int>& counter, unsigned int number) { counter += number; }
+}
+
+TEST_CASE("Decoding products in the readahead stage", "[graph]")
+{
+  std::atomic<unsigned int> decodes{};
+
+  framework_graph g{levels_to_process};
+  g.set_readahead_depth(8);
+  g.decode("encoded", "number", [&decodes](std::string const& encoded) {
+    ++decodes;
+    auto const number = static_cast<unsigned int>(std::stoul(encoded));
+    // Early events take longest to decode
+    sleep_for(std::chrono::microseconds{100 * (n_events - number)});
+    return number;
+  });
+
+  g.with("run_add", add, concurrency::unlimited).fold("number").partitioned_by("run").to("run_sum");
+  g.with(
+     "verify_run_sum", [](unsigned int actual) { CHECK(actual == 45u); }, concurrency::unlimited)
+    .observe("run_sum");
+
+  g.execute();
+
+  CHECK(decodes == n_runs * n_events);
+  CHECK(g.execution_counts("run_add") == n_runs * n_events);
+  CHECK(g.execution_counts("verify_run_sum") == n_runs);
+}
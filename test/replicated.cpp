@@ -1,5 +1,10 @@
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
 #include "meld/utilities/thread_counter.hpp"
 
+#include "test/numbered_events.hpp"
+
 #include "catch2/catch_all.hpp"
 #include "oneapi/tbb/flow_graph.h"
 #include "spdlog/spdlog.h"
@@ -55,6 +60,33 @@ namespace {
     std::vector<T> modules_;
     std::vector<tbb::flow::function_node<Input, Input, tbb::flow::rejecting>> nodes_;
   };
+
+  constexpr unsigned int n_events{20u};
+
+  std::atomic<unsigned int> constructed_modules{};
+  class legacy_module {
+  public:
+    explicit legacy_module(unsigned int const offset) : offset_{offset} { ++constructed_modules; }
+
+    unsigned int add_offset(unsigned int const i)
+    {
+      thread_counter c{counter_};
+      spin_for(1ms);
+      return i + offset_;
+    }
+
+    // Shares the counter with add_offset, so an instance entered by both at once throws.
+    unsigned int subtract_offset(unsigned int const i)
+    {
+      thread_counter c{counter_};
+      spin_for(1ms);
+      return i - offset_;
+    }
+
+  private:
+    unsigned int offset_;
+    thread_counter::counter_type counter_{};
+  };
 }
 
 TEST_CASE("Replicated function calls", "[multithreading]")
@@ -77,3 +109,60 @@ TEST_CASE("Replicated function calls", "[multithreading]")
 
   CHECK(processed_messages == total_messages);
 }
+
+TEST_CASE("Replicated algorithms", "[multithreading]")
+{
+  framework_graph g{test::numbered_events(n_events)};
+  g.make_replicable<legacy_module>(100u)
+    .with(&legacy_module::add_offset, concurrency::serial)
+    .replicated(4)
+    .transform("number")
+    .to("offset_number");
+  std::atomic<unsigned int> sum{};
+  g.with(
+     "sum", [&sum](unsigned int const number) { sum += number; }, concurrency::unlimited)
+    .observe("offset_number");
+  g.execute();
+
+  // The instance bound by 'make_replicable' is the first of the four replicas
+  CHECK(constructed_modules == 4u);
+  CHECK(g.execution_counts("add_offset") == n_events);
+  CHECK(sum == n_events * 100u + n_events * (n_events - 1u) / 2u);
+}
+
+TEST_CASE("Algorithms of one object share its replicas", "[multithreading]")
+{
+  constructed_modules = 0u;
+  framework_graph g{test::numbered_events(n_events)};
+  auto legacy = g.make_replicable<legacy_module>(100u);
+  legacy.with(&legacy_module::add_offset, concurrency::serial)
+    .replicated(2)
+    .transform("number")
+    .to("offset_number");
+  legacy.with(&legacy_module::subtract_offset, concurrency::serial)
+    .replicated(3)
+    .transform("offset_number")
+    .to("restored_number");
+  std::atomic<unsigned int> sum{};
+  g.with(
+     "sum", [&sum](unsigned int const number) { sum += number; }, concurrency::unlimited)
+    .observe("restored_number");
+  g.execute();
+
+  // One pool of three instances serves both algorithms
+  CHECK(constructed_modules == 3u);
+  CHECK(g.execution_counts("add_offset") == n_events);
+  CHECK(g.execution_counts("subtract_offset") == n_events);
+  CHECK(sum == n_events * (n_events - 1u) / 2u);
+}
+
+TEST_CASE("Only replicable objects can be replicated", "[multithreading]")
+{
+  framework_graph g{test::numbered_events(n_events)};
+  g.make<legacy_module>(100u)
+    .with(&legacy_module::add_offset, concurrency::serial)
+    .replicated(4)
+    .transform("number")
+    .to("offset_number");
+  CHECK_THROWS(g.execute());
+}
@@ -0,0 +1,65 @@
+#include "meld/utilities/resource_usage.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace meld;
+
+TEST_CASE("Resource usage of a busy thread", "[utilities]")
+{
+  resource_usage usage;
+  std::thread worker{[] { spin_for(50ms); }};
+  worker.join();
+  spin_for(50ms);
+  usage.sample();
+
+  auto const used = usage.usage();
+  CHECK(used.user_time + used.system_time > 0.05);
+  CHECK(used.voluntary_context_switches >= 0);
+  CHECK(used.minor_page_faults >= 0);
+  CHECK(used.max_rss > 0.);
+  CHECK(usage.samples().size() == 1ull);
+
+#if __linux__
+  // The main thread spun for 50 ms after the resource_usage object was constructed.
+  auto it = std::ranges::find(used.threads, static_cast<int>(getpid()), &thread_cpu_time::tid);
+  REQUIRE(it != used.threads.end());
+  CHECK(it->user_time + it->system_time > 0.);
+#endif
+}
+
+TEST_CASE("Periodic resource sampling", "[utilities]")
+{
+  resource_usage usage;
+  usage.sample_periodically(5ms);
+  CHECK_THROWS(usage.sample_periodically(5ms));
+  sleep_for(50ms);
+
+  auto const samples = usage.samples();
+  CHECK(not samples.empty());
+  CHECK(std::ranges::is_sorted(samples, {}, &resource_snapshot::time));
+  CHECK(samples.front().time > usage.initial().time);
+}
+
+TEST_CASE("Only the most recent resource samples are retained", "[utilities]")
+{
+  CHECK_THROWS(resource_usage{0});
+
+  resource_usage usage{2};
+  for (int i = 0; i != 3; ++i) {
+    usage.sample();
+  }
+  auto const retained = usage.samples();
+  REQUIRE(retained.size() == 2ull);
+  CHECK(std::ranges::is_sorted(retained, {}, &resource_snapshot::time));
+
+  usage.sample();
+  auto const samples = usage.samples();
+  REQUIRE(samples.size() == 2ull);
+  CHECK(samples.front().time == retained.back().time);
+}
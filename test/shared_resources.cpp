@@ -0,0 +1,135 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//        |    |    |
+//    query  lookup  calibrate
+//        |    |    |
+//        |  record |
+//
+// where the 'query', 'lookup' and 'record' nodes share a database resource that permits
+// two concurrent connections, and the 'lookup' and 'calibrate' nodes share a legacy
+// library that must not be called concurrently.  All nodes are otherwise declared with
+// unlimited concurrency.
+//
+// A second test checks that a serial node does not hold more tokens than it can use.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/model/product_store.hpp"
+#include "meld/utilities/sleep_for.hpp"
+#include "meld/utilities/thread_counter.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace meld;
+using namespace std::chrono;
+
+namespace {
+  constexpr unsigned int n_events{20u};
+}
+
+TEST_CASE("Nodes sharing limited resources", "[multithreading]")
+{
+  std::atomic<unsigned int> db_connections{};
+  std::atomic<unsigned int> legacy_calls{};
+
+  framework_graph g{test::numbered_events(n_events)};
+  g.declare_resource("db", 2);
+  g.declare_resource("legacy", 1);
+
+  g.with(
+     "query",
+     [&db_connections](unsigned int const number) {
+       thread_counter c{db_connections, 2};
+       sleep_for(1ms);
+       return number + 1;
+     },
+     concurrency::unlimited)
+    .using_resources("db")
+    .transform("number")
+    .to("queried");
+  g.with(
+     "lookup",
+     [&db_connections, &legacy_calls](unsigned int const number) {
+       thread_counter c1{db_connections, 2};
+       thread_counter c2{legacy_calls};
+       sleep_for(1ms);
+       return number * 2;
+     },
+     concurrency::unlimited)
+    .using_resources("legacy", "db")
+    .transform("number")
+    .to("looked_up");
+  g.with(
+     "record",
+     [&db_connections](unsigned int, unsigned int) {
+       thread_counter c{db_connections, 2};
+       sleep_for(1ms);
+     },
+     concurrency::unlimited)
+    .using_resources("db")
+    .observe("queried", "looked_up");
+  g.with(
+     "calibrate",
+     [&legacy_calls](unsigned int const number) {
+       thread_counter c{legacy_calls};
+       sleep_for(1ms);
+       return number;
+     },
+     concurrency::unlimited)
+    .using_resources("legacy")
+    .transform("number")
+    .to("calibrated");
+
+  g.execute("shared_resources_t");
+
+  CHECK(g.execution_counts("query") == n_events);
+  CHECK(g.execution_counts("lookup") == n_events);
+  CHECK(g.execution_counts("record") == n_events);
+  CHECK(g.execution_counts("calibrate") == n_events);
+}
+
+TEST_CASE("Serial nodes sharing a resource", "[multithreading]")
+{
+  // The first invocation of 'calibrate' waits for 'count' to use the database.  If the
+  // messages queued for 'calibrate' held the second database token, 'count' could not run.
+  std::atomic<unsigned int> counted{};
+  std::atomic<bool> first_call{true};
+  std::atomic<bool> shared_with_count{};
+
+  framework_graph g{test::numbered_events(n_events), 2};
+  g.declare_resource("db", 2);
+  g.with(
+     "calibrate",
+     [&](unsigned int const number) {
+       if (first_call.exchange(false)) {
+         auto const deadline = steady_clock::now() + 10s;
+         while (counted == 0u and steady_clock::now() < deadline) {
+           std::this_thread::yield();
+         }
+         shared_with_count = counted > 0u;
+       }
+       return number;
+     },
+     concurrency::serial)
+    .using_resources("db")
+    .transform("number")
+    .to("calibrated");
+  g.with(
+     "count", [&counted](unsigned int) { ++counted; }, concurrency::unlimited)
+    .using_resources("db")
+    .observe("number");
+
+  g.execute();
+
+  CHECK(shared_with_count);
+  CHECK(g.execution_counts("calibrate") == n_events);
+  CHECK(counted == n_events);
+}
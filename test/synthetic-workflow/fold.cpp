@@ -0,0 +1,22 @@
+#include "meld/module.hpp"
+#include "test/synthetic-workflow/payload.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace {
+  void accumulate(std::atomic<std::size_t>& bytes, meld::test::synthetic::payload const& p)
+  {
+    bytes += p.data.size();
+  }
+}
+
+DEFINE_MODULE(m, config)
+{
+  meld::concurrency const j{
+    config.get<unsigned>("concurrency", meld::concurrency::unlimited.value)};
+  m.with("accumulate", accumulate, j)
+    .fold(config.get<std::string>("input"))
+    .partitioned_by(config.get<std::string>("level"))
+    .to(config.get<std::string>("output"));
+}
@@ -0,0 +1,115 @@
+#include "meld/module.hpp"
+#include "test/mock-workflow/timed_busy.hpp"
+#include "test/synthetic-workflow/payload.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace meld::test::synthetic;
+
+namespace {
+  // The duration of each call is drawn from a distribution whose random engine is seeded
+  // by the node's seed and the payload's ID, so that the durations are reproducible and
+  // independent of the order in which the calls are made.
+  class duration_model {
+  public:
+    explicit duration_model(meld::configuration const& config) :
+      distribution_{config.get<std::string>("distribution", "fixed")},
+      mean_{config.get<double>("duration_usec")},
+      spread_{config.get<double>("duration_spread", 0.)},
+      seed_{config.get<std::uint64_t>("seed", 0)}
+    {
+      if (distribution_ != "fixed" and distribution_ != "uniform" and
+          distribution_ != "exponential" and distribution_ != "lognormal") {
+        throw std::runtime_error("Unsupported duration distribution '" + distribution_ + "'.");
+      }
+    }
+
+    std::chrono::microseconds sample(std::size_t const id) const
+    {
+      std::minstd_rand engine{static_cast<std::minstd_rand::result_type>(
+        (seed_ ^ (id * 0x9e3779b97f4a7c15ull)) % std::minstd_rand::modulus)};
+      double usec{mean_};
+      if (distribution_ == "uniform") {
+        usec = std::uniform_real_distribution{mean_ * (1 - spread_), mean_ * (1 + spread_)}(engine);
+      }
+      else if (distribution_ == "exponential") {
+        usec = std::exponential_distribution{1 / mean_}(engine);
+      }
+      else if (distribution_ == "lognormal") {
+        // The mean of the log-normal distribution is exp(mu + sigma^2 / 2).
+        auto const mu = std::log(mean_) - spread_ * spread_ / 2;
+        usec = std::lognormal_distribution{mu, spread_}(engine);
+      }
+      return std::chrono::microseconds{std::llround(std::max(usec, 0.))};
+    }
+
+  private:
+    std::string distribution_;
+    double mean_;
+    double spread_;
+    std::uint64_t seed_;
+  };
+
+  class node {
+  public:
+    node(duration_model durations, std::size_t const product_bytes) :
+      durations_{std::move(durations)}, product_bytes_{product_bytes}
+    {
+    }
+
+    payload one(payload const& a) const { return execute(a); }
+    payload two(payload const& a, payload const&) const { return execute(a); }
+    payload three(payload const& a, payload const&, payload const&) const { return execute(a); }
+    payload four(payload const& a, payload const&, payload const&, payload const&) const
+    {
+      return execute(a);
+    }
+
+  private:
+    payload execute(payload const& first) const
+    {
+      meld::test::timed_busy(durations_.sample(first.id));
+      return {first.id, std::vector<std::byte>(product_bytes_)};
+    }
+
+    duration_model durations_;
+    std::size_t product_bytes_;
+  };
+
+  template <std::size_t N>
+  void declare(meld::graph_proxy<meld::void_tag>& m,
+               meld::configuration const& config,
+               auto execute)
+  {
+    meld::concurrency const j{
+      config.get<unsigned>("concurrency", meld::concurrency::unlimited.value)};
+    m.make<node>(duration_model{config}, config.get<std::size_t>("product_bytes", 0))
+      .with(execute, j)
+      .transform(config.get<std::array<std::string, N>>("inputs"))
+      .to(config.get<std::string>("output"));
+  }
+}
+
+DEFINE_MODULE(m, config)
+{
+  switch (config.get<std::vector<std::string>>("inputs").size()) {
+  case 1:
+    return declare<1>(m, config, &node::one);
+  case 2:
+    return declare<2>(m, config, &node::two);
+  case 3:
+    return declare<3>(m, config, &node::three);
+  case 4:
+    return declare<4>(m, config, &node::four);
+  }
+  throw std::runtime_error("A synthetic node must have between 1 and 4 inputs.");
+}
@@ -0,0 +1,15 @@
+#ifndef test_synthetic_workflow_payload_hpp
+#define test_synthetic_workflow_payload_hpp
+
+#include <cstddef>
+#include <vector>
+
+namespace meld::test::synthetic {
+  // The product exchanged by the nodes of a synthetic workflow
+  struct payload {
+    std::size_t id; // Index of the innermost-level store from which the payload derives
+    std::vector<std::byte> data;
+  };
+}
+
+#endif // test_synthetic_workflow_payload_hpp
@@ -0,0 +1,65 @@
+#include "meld/model/product_store.hpp"
+#include "meld/source.hpp"
+#include "test/synthetic-workflow/payload.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace meld::test::synthetic {
+  // Yields a hierarchy of stores whose levels are nested in the order given by
+  // 'level_names'; level i has 'level_counts[i]' children per parent.  Each store of the
+  // innermost level provides a payload of 'payload_bytes' bytes.
+  class source {
+  public:
+    source(configuration const& config) :
+      level_names_{config.get<std::vector<std::string>>("level_names")},
+      level_counts_{config.get<std::vector<std::size_t>>("level_counts")},
+      payload_bytes_{config.get<std::size_t>("payload_bytes", 0)}
+    {
+      if (level_names_.empty() or level_names_.size() != level_counts_.size()) {
+        throw std::runtime_error(
+          "The synthetic source requires equal, non-zero numbers of level names and counts.");
+      }
+      std::size_t n_stores{1};
+      for (auto const count : level_counts_) {
+        n_stores *= count;
+      }
+      spdlog::info("Processing {} '{}' stores", n_stores, level_names_.back());
+    }
+
+    void next(framework_driver& driver) const
+    {
+      auto job_store = product_store::base();
+      driver.yield(job_store);
+
+      std::size_t n_payloads{};
+      std::function<void(product_store_ptr const&, std::size_t)> yield_children =
+        [&](product_store_ptr const& parent, std::size_t const depth) {
+          bool const innermost = depth + 1 == level_names_.size();
+          for (std::size_t i = 0; i != level_counts_[depth]; ++i) {
+            auto store = parent->make_child(i, level_names_[depth]);
+            if (innermost) {
+              store->add_product("payload",
+                                 payload{n_payloads++, std::vector<std::byte>(payload_bytes_)});
+            }
+            driver.yield(store);
+            if (not innermost) {
+              yield_children(store, depth + 1);
+            }
+          }
+        };
+      yield_children(job_store, 0);
+    }
+
+  private:
+    std::vector<std::string> level_names_;
+    std::vector<std::size_t> level_counts_;
+    std::size_t payload_bytes_;
+  };
+}
+
+DEFINE_SOURCE(meld::test::synthetic::source)
@@ -0,0 +1,132 @@
+// Generator of synthetic workflows for scaling studies.
+//
+// generate(params) returns a configuration ({source: ..., modules: ...}) whose graph is a
+// random DAG of 'depth' layers of 'width' nodes each.  Every node is a transform
+// (synthetic_node plugin) that busy-waits for a duration drawn from a distribution and
+// produces a payload of a given size.  The nodes of the first layer consume the payload
+// provided by the source; each node of a later layer consumes between 1 and 'max_fan_in'
+// products of earlier layers, which come from the previous layer with probability
+// 'locality' and from any earlier layer otherwise.  A fraction of the nodes of the last
+// layer is followed by a fold (synthetic_fold plugin) over a randomly chosen level of the
+// hierarchy.
+//
+// The generated graph depends only on the parameters, including 'seed'.  A parameter
+// replaces its default as a whole, including the nested objects.  Example:
+//
+//   local synthetic = import 'synthetic.libsonnet';
+//   synthetic.generate({ depth: 25, width: 40, max_fan_in: 4 }) + { max_concurrency: 8 }
+
+local defaults = {
+  seed: 'synthetic',
+
+  // The level hierarchy yielded by the source; each level is nested in the previous one,
+  // and the payload is provided at the innermost level.
+  levels: [{ name: 'run', count: 1 }, { name: 'event', count: 100 }],
+
+  depth: 10,
+  width: 10,
+  max_fan_in: 2,  // At most 4
+  locality: 0.8,
+
+  // Distribution of the duration of each call ('fixed', 'uniform', 'exponential', or
+  // 'lognormal').  The mean duration of each node is the given mean multiplied by a
+  // log-normal factor whose sigma is 'node_spread'; 'spread' is the half-width (as a
+  // fraction of the mean) of the uniform distribution, or the sigma of the log-normal one.
+  duration: { distribution: 'exponential', mean_usec: 100, spread: 0.5, node_spread: 1.0 },
+
+  // Payload sizes are drawn uniformly per node.
+  product_bytes: { min: 8, max: 1024 },
+
+  // Concurrencies are drawn per node according to the weights; entries without a
+  // concurrency denote unlimited concurrency.
+  concurrency_mix: [
+    { weight: 0.8 },
+    { weight: 0.1, concurrency: 1 },
+    { weight: 0.1, concurrency: 4 },
+  ],
+
+  fold_fraction: 0.1,
+};
+
+{
+  generate(params={})::
+    local p = defaults + params;
+    assert p.max_fan_in >= 1 && p.max_fan_in <= 4 : 'max_fan_in must be between 1 and 4';
+    assert std.length(p.levels) >= 1 : 'at least one level is required';
+
+    // A pseudo-random number in [0, 1) determined by the seed and the key
+    local rand(key) = std.parseHex(std.substr(std.md5(p.seed + ':' + key), 0, 7)) / 268435456;
+    local pick(key, n) = std.floor(rand(key) * n);
+    local normal(key) =  // Box-Muller transform
+      std.sqrt(-2 * std.log(1 - rand(key + ':u'))) *
+      std.cos(2 * 3.141592653589793 * rand(key + ':v'));
+
+    local node_name(layer, i) = 'n%d_%d' % [layer, i];
+    local product(layer, i) = 'p%d_%d' % [layer, i];
+
+    local inputs(layer, i) =
+      if layer == 0 then ['payload']
+      else
+        local key = '%d:%d' % [layer, i];
+        local n_inputs = 1 + pick('fan_in:' + key, p.max_fan_in);
+        std.set([
+          local k_key = key + ':' + k;
+          local source_layer =
+            if rand('locality:' + k_key) < p.locality then layer - 1
+            else pick('layer:' + k_key, layer);
+          product(source_layer, pick('node:' + k_key, p.width))
+          for k in std.range(0, n_inputs - 1)
+        ]);
+
+    local concurrency(key) =
+      local mix = p.concurrency_mix;
+      local total = std.foldl(function(sum, entry) sum + entry.weight, mix, 0);
+      local r = rand(key) * total;
+      local choose(k, cumulative) =
+        if k == std.length(mix) - 1 || r < cumulative + mix[k].weight then mix[k]
+        else choose(k + 1, cumulative + mix[k].weight);
+      local choice = choose(0, 0);
+      if std.objectHas(choice, 'concurrency') then { concurrency: choice.concurrency } else {};
+
+    local node(layer, i) =
+      local key = '%d:%d' % [layer, i];
+      {
+        plugin: 'synthetic_node',
+        inputs: inputs(layer, i),
+        output: product(layer, i),
+        distribution: p.duration.distribution,
+        duration_usec:
+          p.duration.mean_usec * std.exp(p.duration.node_spread * normal('duration:' + key)),
+        duration_spread: p.duration.spread,
+        product_bytes:
+          p.product_bytes.min +
+          pick('bytes:' + key, p.product_bytes.max - p.product_bytes.min + 1),
+        seed: pick('seed:' + key, 2147483647),
+      } + concurrency('concurrency:' + key);
+
+    local last = p.depth - 1;
+    local fold_levels = ['job'] + [level.name for level in p.levels[:std.length(p.levels) - 1]];
+
+    {
+      source: {
+        plugin: 'synthetic_source',
+        level_names: [level.name for level in p.levels],
+        level_counts: [level.count for level in p.levels],
+        payload_bytes: p.product_bytes.min,
+      },
+      modules: {
+        [node_name(layer, i)]: node(layer, i)
+        for layer in std.range(0, last)
+        for i in std.range(0, p.width - 1)
+      } + {
+        ['fold_' + node_name(last, i)]: {
+          plugin: 'synthetic_fold',
+          input: product(last, i),
+          level: fold_levels[pick('fold_level:%d' % i, std.length(fold_levels))],
+          output: 'sum_' + product(last, i),
+        } + concurrency('fold_concurrency:%d' % i)
+        for i in std.range(0, p.width - 1)
+        if rand('fold:%d' % i) < p.fold_fraction
+      },
+    },
+}
@@ -0,0 +1,119 @@
+// =======================================================================================
+// This test executes the following graph
+//
+//        Multiplexer
+//             |
+//          square
+//             |
+//       verify_square
+//
+// with tracing enabled, and checks that each invocation of each node appears in the
+// trace file.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/core/trace_recorder.hpp"
+#include "meld/model/level_id.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace meld;
+
+namespace {
+  constexpr auto n_events = 10u;
+
+  unsigned int square(unsigned int number) { return number * number; }
+
+  std::string read(std::string const& filename)
+  {
+    std::ifstream file{filename};
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+  }
+
+  std::size_t occurrences(std::string const& str, std::string const& substr)
+  {
+    std::size_t result{};
+    for (auto pos = str.find(substr); pos != std::string::npos; pos = str.find(substr, pos + 1)) {
+      ++result;
+    }
+    return result;
+  }
+}
+
+TEST_CASE("Tracing node invocations", "[graph]")
+{
+  std::string const trace_file{"tracing_test.json"};
+  std::filesystem::remove(trace_file);
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    g.enable_tracing(trace_file);
+    g.with(square, concurrency::unlimited).transform("number").to("square");
+    g.with(
+       "verify_square",
+       [](unsigned int number, unsigned int sq) { CHECK(sq == number * number); },
+       concurrency::unlimited)
+      .observe("number", "square");
+    g.execute();
+  }
+
+  REQUIRE(std::filesystem::exists(trace_file));
+  auto const contents = read(trace_file);
+  CHECK(contents.starts_with(R"({"displayTimeUnit": "ms", "traceEvents": [)"));
+  CHECK(occurrences(contents, R"("ph": "X")") == 2 * n_events);
+  CHECK(occurrences(contents, R"("name": "square", "cat": "transform")") == n_events);
+  CHECK(occurrences(contents, R"("name": "verify_square", "cat": "observer")") == n_events);
+
+  auto const last_event = level_id::base().make_child(n_events - 1, "event");
+  std::ostringstream level;
+  level << R"("level": ")" << std::hex << std::setw(16) << std::setfill('0') << last_event->hash()
+        << R"(", "number": )" << std::dec << last_event->number() << '}';
+  CHECK(occurrences(contents, level.str()) == 2);
+
+  std::filesystem::remove(trace_file);
+}
+
+TEST_CASE("Trace buffers keep the most recent events", "[graph]")
+{
+  level_id_ptr const id = level_id::base().make_child(0, "event");
+  auto const now = trace_recorder::clock::now();
+  std::string const name{"node"};
+
+  trace_recorder recorder{4};
+  for (int i = 0; i != 6; ++i) {
+    recorder.record(name, "transform", id, now, now);
+  }
+  CHECK(recorder.overwritten_events() == 2);
+
+  std::string const trace_file{"trace_buffer_test.json"};
+  recorder.write(trace_file);
+  CHECK(occurrences(read(trace_file), R"("ph": "X")") == 4);
+  std::filesystem::remove(trace_file);
+
+  CHECK_THROWS(trace_recorder{0});
+}
+
+TEST_CASE("Node names are escaped in traces", "[graph]")
+{
+  level_id_ptr const id = level_id::base().make_child(0, "event");
+  auto const now = trace_recorder::clock::now();
+  std::string const name{"node \"quoted\"\n"};
+
+  trace_recorder recorder{1};
+  recorder.record(name, "transform", id, now, now);
+
+  std::string const trace_file{"trace_escaping_test.json"};
+  recorder.write(trace_file);
+  CHECK(occurrences(read(trace_file), R"("name": "node \"quoted\"\n")") == 1);
+  std::filesystem::remove(trace_file);
+}
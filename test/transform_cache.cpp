@@ -0,0 +1,173 @@
+// =======================================================================================
+// This test executes the following graph twice, using the same cache directory:
+//
+//                 Multiplexer
+//             ________|________
+//            |                 |
+//        square(c)        describe(c)
+//            |                 |
+//      verify_square     verify_label
+//
+// where (c) denotes a cached transform.  The first job computes and stores the results
+// of the cached transforms; the second job loads them from the cache without invoking
+// the transforms.
+// =======================================================================================
+
+#include "meld/core/framework_graph.hpp"
+#include "meld/core/transform_cache.hpp"
+#include "meld/model/product_store.hpp"
+
+#include "test/numbered_events.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace meld;
+
+namespace {
+  constexpr auto n_events = 10u;
+
+  unsigned int square(unsigned int number) { return number * number; }
+  std::tuple<std::string, std::vector<int>> describe(unsigned int number)
+  {
+    return {"event " + std::to_string(number), std::vector<int>(number, 1)};
+  }
+
+  void add_nodes(framework_graph& g, std::string const& version)
+  {
+    g.with(square, concurrency::unlimited).transform("number").to("square").cached(version);
+    g.with(describe, concurrency::unlimited)
+      .transform("number")
+      .to("label", "ones")
+      .cached(version);
+    g.with(
+       "verify_square",
+       [](unsigned int number, unsigned int sq) { CHECK(sq == number * number); },
+       concurrency::unlimited)
+      .observe("number", "square");
+    g.with(
+       "verify_label",
+       [](unsigned int number, std::string const& label, std::vector<int> const& ones) {
+         CHECK(label == "event " + std::to_string(number));
+         CHECK(ones.size() == number);
+       },
+       concurrency::unlimited)
+      .observe("number", "label", "ones");
+  }
+}
+
+TEST_CASE("Round trip of cacheable types", "[transform_cache]")
+{
+  using value_t = std::tuple<int, std::string, std::vector<std::string>>;
+  STATIC_REQUIRE(cacheable<value_t>);
+  value_t const original{-3, "abc", {"d", "", "efg"}};
+
+  std::string bytes;
+  cache_traits<value_t>::to_bytes(original, bytes);
+  std::string_view remaining{bytes};
+  CHECK(cache_traits<value_t>::from_bytes(remaining) == original);
+  CHECK(remaining.empty());
+
+  std::string_view truncated{bytes.data(), bytes.size() - 1};
+  CHECK_THROWS(cache_traits<value_t>::from_bytes(truncated));
+}
+
+namespace {
+  struct padded {
+    char c;
+    int i;
+  };
+  struct opted_in {
+    int a;
+    int b;
+  };
+}
+
+template <>
+struct meld::cache_as_bytes<opted_in> : std::true_type {};
+
+TEST_CASE("Classes are cached as bytes only if opted in", "[transform_cache]")
+{
+  STATIC_REQUIRE(cacheable<double>);
+  STATIC_REQUIRE_FALSE(cacheable<int*>);
+  STATIC_REQUIRE_FALSE(cacheable<padded>);
+  STATIC_REQUIRE(cacheable<opted_in>);
+}
+
+TEST_CASE("Keys depend on the name, the version, and the inputs", "[transform_cache]")
+{
+  algorithm_name const name{"module", "square"};
+  auto const key = transform_cache::make_key(name, "v1", "123");
+  CHECK(key == transform_cache::make_key(name, "v1", "123"));
+  CHECK(key != transform_cache::make_key({"module", "cube"}, "v1", "123"));
+  CHECK(key != transform_cache::make_key(name, "v2", "123"));
+  CHECK(key != transform_cache::make_key(name, "v1", "124"));
+}
+
+TEST_CASE("Entries stored for other inputs are misses", "[transform_cache]")
+{
+  std::filesystem::path const cache_dir{"transform_cache_identity_test"};
+  std::filesystem::remove_all(cache_dir);
+  transform_cache cache;
+  cache.set_directory(cache_dir);
+
+  // Simulate a digest collision by storing two identities under the same key.
+  algorithm_name const name{"module", "square"};
+  auto const key = transform_cache::make_key(name, "v1", "123");
+  auto const identity = transform_cache::make_identity(name, "v1", "123");
+  cache.store(key, identity, "15129");
+  CHECK(cache.load(key, identity) == "15129");
+  CHECK_FALSE(cache.load(key, transform_cache::make_identity(name, "v1", "124")));
+  CHECK_FALSE(cache.load(key, transform_cache::make_identity(name, "v2", "123")));
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST_CASE("Loading transform results from the cache", "[graph]")
+{
+  std::filesystem::path const cache_dir{"transform_cache_test"};
+  std::filesystem::remove_all(cache_dir);
+
+  // First job populates the cache
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    g.set_transform_cache(cache_dir);
+    add_nodes(g, "v1");
+    g.execute();
+
+    CHECK(g.execution_counts("square") == n_events);
+    CHECK(g.execution_counts("describe") == n_events);
+    CHECK(g.execution_counts("verify_square") == n_events);
+    CHECK(g.execution_counts("verify_label") == n_events);
+  }
+
+  // Second job loads the results from the cache
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    g.set_transform_cache(cache_dir);
+    add_nodes(g, "v1");
+    g.execute();
+
+    CHECK(g.execution_counts("square") == 0);
+    CHECK(g.execution_counts("describe") == 0);
+    CHECK(g.execution_counts("verify_square") == n_events);
+    CHECK(g.execution_counts("verify_label") == n_events);
+  }
+
+  // Changing the version invalidates the cached results
+  {
+    framework_graph g{test::numbered_events(n_events)};
+    g.set_transform_cache(cache_dir);
+    add_nodes(g, "v2");
+    g.execute();
+
+    CHECK(g.execution_counts("square") == n_events);
+    CHECK(g.execution_counts("describe") == n_events);
+  }
+
+  std::filesystem::remove_all(cache_dir);
+}
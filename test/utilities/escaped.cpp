@@ -0,0 +1,13 @@
+#include "meld/utilities/escaped.hpp"
+
+#include "catch2/catch_all.hpp"
+
+using namespace meld;
+
+TEST_CASE("Escaping strings", "[utilities]")
+{
+  CHECK(escaped("plain name") == "plain name");
+  CHECK(escaped(R"(a "quoted" \name)") == R"(a \"quoted\" \\name)");
+  CHECK(escaped("two\nlines") == R"(two\nlines)");
+  CHECK(escaped("tab\tbell\a") == R"(tab\u0009bell\u0007)");
+}
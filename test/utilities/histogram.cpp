@@ -0,0 +1,72 @@
+#include "meld/utilities/histogram.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <cstdint>
+
+using namespace meld;
+
+TEST_CASE("Empty histogram", "[histogram]")
+{
+  histogram const h;
+  CHECK(h.count() == 0);
+  CHECK(h.min() == 0);
+  CHECK(h.max() == 0);
+  CHECK(h.mean() == 0.);
+  CHECK(h.percentile(50.) == 0);
+}
+
+TEST_CASE("Small values are recorded exactly", "[histogram]")
+{
+  histogram h;
+  for (std::uint64_t i = 1; i <= 10; ++i) {
+    h.record(i);
+  }
+  CHECK(h.count() == 10);
+  CHECK(h.sum() == 55);
+  CHECK(h.min() == 1);
+  CHECK(h.max() == 10);
+  CHECK(h.mean() == 5.5);
+  CHECK(h.percentile(50.) == 5);
+  CHECK(h.percentile(90.) == 9);
+  CHECK(h.percentile(100.) == 10);
+}
+
+TEST_CASE("Percentiles of large values are within the bucket precision", "[histogram]")
+{
+  histogram h;
+  for (std::uint64_t i = 1; i <= 1000; ++i) {
+    h.record(i * 1000);
+  }
+  CHECK(h.min() == 1000);
+  CHECK(h.max() == 1'000'000);
+  for (double const p : {10., 50., 90., 99.}) {
+    auto const expected = p * 10'000;
+    CHECK(h.percentile(p) >= expected);
+    CHECK(h.percentile(p) <= expected * (1 + 1. / (1 << histogram::sub_bucket_bits)));
+  }
+  CHECK(h.percentile(100.) == 1'000'000);
+}
+
+TEST_CASE("Merging histograms", "[histogram]")
+{
+  histogram a;
+  histogram b;
+  for (std::uint64_t i = 0; i != 100; ++i) {
+    (i % 2 ? a : b).record(i);
+  }
+  a.merge(b);
+  CHECK(a.count() == 100);
+  CHECK(a.min() == 0);
+  CHECK(a.max() == 99);
+  CHECK(a.sum() == 4950);
+}
+
+TEST_CASE("Very large values are clamped only in the buckets", "[histogram]")
+{
+  histogram h;
+  auto const huge = std::uint64_t{1} << 60;
+  h.record(huge);
+  CHECK(h.max() == huge);
+  CHECK(h.percentile(50.) == huge);
+}
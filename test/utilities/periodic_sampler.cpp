@@ -0,0 +1,38 @@
+#include "meld/utilities/periodic_sampler.hpp"
+#include "meld/utilities/sleep_for.hpp"
+
+#include "catch2/catch_all.hpp"
+
+#include <atomic>
+#include <chrono>
+
+using namespace std::chrono;
+
+TEST_CASE("Sampling periodically", "[utilities]")
+{
+  std::atomic<unsigned int> samples{};
+  {
+    meld::periodic_sampler sampler{5ms, [&samples] { ++samples; }};
+    meld::sleep_for(50ms);
+  }
+  auto const taken = samples.load();
+  CHECK(taken > 0u);
+
+  // No samples are taken once the sampler has been destroyed.
+  meld::sleep_for(20ms);
+  CHECK(samples == taken);
+}
+
+TEST_CASE("Stopping a sampler does not wait for the end of its interval", "[utilities]")
+{
+  auto start = steady_clock::now();
+  {
+    meld::periodic_sampler sampler{1h, [] {}};
+  }
+  CHECK(steady_clock::now() - start < 1min);
+}
+
+TEST_CASE("Sampling intervals must be positive", "[utilities]")
+{
+  CHECK_THROWS(meld::periodic_sampler{0ms, [] {}});
+}